@@ -0,0 +1,123 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio.hpp>
+#include <SFML/System.hpp>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+
+
+////////////////////////////////////////////////////////////
+// Benchmark settings
+////////////////////////////////////////////////////////////
+namespace
+{
+    const unsigned int sampleRate   = 44100;
+    const unsigned int channelCount = 2;
+    const unsigned int duration     = 20; // Seconds of audio written to each file
+    const std::size_t  blockSize    = sampleRate / 100 * channelCount; // Samples per write, as a recorder would provide them
+}
+
+
+////////////////////////////////////////////////////////////
+/// Prepare a file before it is opened
+///
+////////////////////////////////////////////////////////////
+void configure(sf::OutputSoundFile&)
+{
+}
+
+void configure(sf::AsyncOutputSoundFile& file)
+{
+    // The samples are provided faster than real time: let the queue hold them all
+    file.setQueueDuration(sf::seconds(duration));
+}
+
+
+////////////////////////////////////////////////////////////
+/// Write the samples to a file, either directly or through
+/// the background thread, and print the time spent by the
+/// calling thread
+///
+/// \return Time spent in the calls to write, or Time::Zero if the file couldn't be opened
+///
+////////////////////////////////////////////////////////////
+template <typename File>
+sf::Time runBenchmark(const std::string& filename, const std::vector<sf::Int16>& samples, sf::Time reference)
+{
+    File file;
+    configure(file);
+    if (!file.openFromFile(filename, sampleRate, channelCount))
+    {
+        std::cout << std::setw(14) << "failed";
+        return sf::Time::Zero;
+    }
+
+    sf::Clock clock;
+    sf::Time writeTime;
+    for (std::size_t i = 0; i < samples.size(); i += blockSize)
+    {
+        clock.restart();
+        file.write(&samples[i], std::min(blockSize, samples.size() - i));
+        writeTime += clock.getElapsedTime();
+    }
+
+    // The remaining samples are written when the file is closed
+    clock.restart();
+    file.close();
+    sf::Time closeTime = clock.getElapsedTime();
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << std::setw(8) << writeTime.asSeconds() * 1000 << " ms";
+    if ((reference != sf::Time::Zero) && (writeTime != sf::Time::Zero))
+        std::cout << " (x" << std::setw(5) << reference / writeTime << ")";
+    else
+        std::cout << "         ";
+    std::cout << std::setw(8) << closeTime.asSeconds() * 1000 << " ms";
+
+    std::remove(filename.c_str());
+
+    return writeTime;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    // A tone with some noise, which compressed formats can't encode too easily
+    std::vector<sf::Int16> samples(sampleRate * channelCount * duration);
+    for (std::size_t i = 0; i < samples.size(); ++i)
+    {
+        double time = static_cast<double>(i / channelCount) / sampleRate;
+        double tone = std::sin(time * 440 * 2 * 3.14159265) * 8000;
+        samples[i] = static_cast<sf::Int16>(tone + std::rand() % 2000 - 1000);
+    }
+
+    std::cout << duration << " s of stereo audio, written by blocks of 10 ms" << std::endl;
+    std::cout << "Time spent by the writing thread in write(), then in close(), which waits for the encoder" << std::endl << std::endl;
+    std::cout << "Format  " << std::setw(28) << "sf::OutputSoundFile" << std::setw(36) << "sf::AsyncOutputSoundFile" << std::endl;
+
+    const char* formats[] = {"wav", "ogg", "flac"};
+    for (std::size_t i = 0; i < sizeof(formats) / sizeof(*formats); ++i)
+    {
+        std::string filename = std::string("async_encode.") + formats[i];
+        std::cout << std::left << std::setw(8) << formats[i] << std::right;
+
+        sf::Time reference = runBenchmark<sf::OutputSoundFile>(filename, samples, sf::Time::Zero);
+        std::cout << "    ";
+        runBenchmark<sf::AsyncOutputSoundFile>(filename, samples, reference);
+        std::cout << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,149 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio.hpp>
+#include <SFML/System.hpp>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+
+
+////////////////////////////////////////////////////////////
+// Benchmark settings
+////////////////////////////////////////////////////////////
+namespace
+{
+    const unsigned int sampleRate   = 44100;
+    const unsigned int channelCount = 2;
+    const unsigned int duration     = 5;  // Seconds of audio in each file
+    const std::size_t  fileCount    = 16; // Number of files loaded at once, as a level would do
+}
+
+
+////////////////////////////////////////////////////////////
+/// Write the test files in the given format
+///
+/// \return True if all the files could be written
+///
+////////////////////////////////////////////////////////////
+bool writeFiles(const std::vector<std::string>& filenames)
+{
+    // A tone with some noise, which compressed formats can't decode too easily
+    std::vector<sf::Int16> samples(sampleRate * channelCount * duration);
+    for (std::size_t i = 0; i < samples.size(); ++i)
+    {
+        double time = static_cast<double>(i / channelCount) / sampleRate;
+        double tone = std::sin(time * 440 * 2 * 3.14159265) * 8000;
+        samples[i] = static_cast<sf::Int16>(tone + std::rand() % 2000 - 1000);
+    }
+
+    for (std::size_t i = 0; i < filenames.size(); ++i)
+    {
+        sf::OutputSoundFile file;
+        if (!file.openFromFile(filenames[i], sampleRate, channelCount))
+            return false;
+
+        file.write(&samples[0], samples.size());
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Load the files one after the other on the calling thread
+///
+/// \return Time spent loading, or Time::Zero if a file couldn't be loaded
+///
+////////////////////////////////////////////////////////////
+sf::Time loadSerial(const std::vector<std::string>& filenames)
+{
+    std::vector<sf::SoundBuffer> buffers(filenames.size());
+
+    sf::Clock clock;
+    for (std::size_t i = 0; i < filenames.size(); ++i)
+    {
+        if (!buffers[i].loadFromFile(filenames[i]))
+            return sf::Time::Zero;
+    }
+
+    return clock.getElapsedTime();
+}
+
+
+////////////////////////////////////////////////////////////
+/// Decode the files in parallel on the decoder threads,
+/// then upload them from the calling thread
+///
+/// \return Time spent loading, or Time::Zero if a file couldn't be loaded
+///
+////////////////////////////////////////////////////////////
+sf::Time loadParallel(const std::vector<std::string>& filenames)
+{
+    std::vector<sf::SoundBuffer> buffers;
+
+    sf::Clock clock;
+    sf::SoundBuffer::loadFromFilesAsync(filenames, buffers);
+
+    bool success = true;
+    for (std::size_t i = 0; i < buffers.size(); ++i)
+        success = buffers[i].finishLoading() && success;
+
+    return success ? clock.getElapsedTime() : sf::Time::Zero;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    std::cout << "Loading " << fileCount << " files of " << duration << " s of stereo audio" << std::endl << std::endl;
+    std::cout << "Format  " << std::setw(12) << "Serial" << std::setw(22) << "Parallel" << std::endl;
+
+    const char* formats[] = {"wav", "ogg", "flac"};
+    for (std::size_t i = 0; i < sizeof(formats) / sizeof(*formats); ++i)
+    {
+        std::vector<std::string> filenames;
+        for (std::size_t j = 0; j < fileCount; ++j)
+        {
+            std::ostringstream filename;
+            filename << "parallel_load_" << j << "." << formats[i];
+            filenames.push_back(filename.str());
+        }
+
+        std::cout << std::left << std::setw(8) << formats[i] << std::right;
+
+        if (writeFiles(filenames))
+        {
+            // Both runs read the files from the system cache, since they were just written
+            sf::Time serial   = loadSerial(filenames);
+            sf::Time parallel = loadParallel(filenames);
+
+            std::cout << std::fixed << std::setprecision(1);
+            std::cout << std::setw(9) << serial.asSeconds() * 1000 << " ms";
+            std::cout << std::setw(13) << parallel.asSeconds() * 1000 << " ms";
+            if ((serial != sf::Time::Zero) && (parallel != sf::Time::Zero))
+                std::cout << " (x" << std::setw(5) << serial / parallel << ")";
+        }
+        else
+        {
+            std::cout << std::setw(12) << "failed";
+        }
+
+        std::cout << std::endl;
+
+        for (std::size_t j = 0; j < filenames.size(); ++j)
+            std::remove(filenames[j].c_str());
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,290 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network.hpp>
+#include <SFML/System.hpp>
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <sstream>
+#include <vector>
+#include <cstdlib>
+
+
+////////////////////////////////////////////////////////////
+// Benchmark settings
+////////////////////////////////////////////////////////////
+namespace
+{
+    const unsigned int clientCount   = 8;   // Number of connections
+    const unsigned int pipelineDepth = 16;  // Packets in flight per connection
+    const unsigned int payloadSize   = 64;  // Bytes of payload per packet
+    const sf::Time     duration      = sf::seconds(3);
+
+    // Clock shared by clients, to timestamp the packets
+    sf::Clock timer;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Echo server based on sf::NetworkReactor
+///
+////////////////////////////////////////////////////////////
+class ReactorServer : public sf::NetworkReactor
+{
+public:
+
+    explicit ReactorServer(unsigned int threadCount) :
+    sf::NetworkReactor(threadCount)
+    {
+    }
+
+private:
+
+    virtual void onReceive(sf::TcpSocket& socket, sf::Packet& packet)
+    {
+        send(socket, packet);
+    }
+};
+
+
+////////////////////////////////////////////////////////////
+/// Echo server based on a hand-written sf::SocketSelector loop
+///
+////////////////////////////////////////////////////////////
+class SelectorServer
+{
+public:
+
+    explicit SelectorServer(sf::TcpListener& listener) :
+    m_listener(listener),
+    m_running (true)
+    {
+    }
+
+    ~SelectorServer()
+    {
+        for (std::list<sf::TcpSocket*>::iterator it = m_clients.begin(); it != m_clients.end(); ++it)
+            delete *it;
+    }
+
+    void run()
+    {
+        sf::SocketSelector selector;
+        selector.add(m_listener);
+
+        while (isRunning())
+        {
+            if (!selector.wait(sf::milliseconds(100)))
+                continue;
+
+            if (selector.isReady(m_listener))
+            {
+                sf::TcpSocket* client = new sf::TcpSocket;
+                if (m_listener.accept(*client) == sf::Socket::Done)
+                {
+                    m_clients.push_back(client);
+                    selector.add(*client);
+                }
+                else
+                {
+                    delete client;
+                }
+            }
+
+            // Every client has to be tested after each wake-up
+            for (std::list<sf::TcpSocket*>::iterator it = m_clients.begin(); it != m_clients.end(); ++it)
+            {
+                if (selector.isReady(**it))
+                {
+                    sf::Packet packet;
+                    if ((*it)->receive(packet) == sf::Socket::Done)
+                        (*it)->send(packet);
+                }
+            }
+        }
+    }
+
+    void stop()
+    {
+        sf::Lock lock(m_mutex);
+        m_running = false;
+    }
+
+private:
+
+    bool isRunning()
+    {
+        sf::Lock lock(m_mutex);
+        return m_running;
+    }
+
+    sf::TcpListener&         m_listener;
+    std::list<sf::TcpSocket*> m_clients;
+    bool                     m_running;
+    sf::Mutex                m_mutex;
+};
+
+
+////////////////////////////////////////////////////////////
+/// Client which keeps a fixed number of packets in flight,
+/// and measures their round-trip time
+///
+////////////////////////////////////////////////////////////
+class Client
+{
+public:
+
+    explicit Client(unsigned short port) :
+    m_port(port)
+    {
+    }
+
+    void run()
+    {
+        if (m_socket.connect(sf::IpAddress::LocalHost, m_port) != sf::Socket::Done)
+            return;
+
+        for (unsigned int i = 0; i < pipelineDepth; ++i)
+            sendPacket();
+
+        sf::Time end = timer.getElapsedTime() + duration;
+        unsigned int inFlight = pipelineDepth;
+        while (inFlight > 0)
+        {
+            sf::Packet packet;
+            if (m_socket.receive(packet) != sf::Socket::Done)
+                return;
+
+            sf::Int64 sent = 0;
+            packet >> sent;
+            m_latencies.push_back(timer.getElapsedTime().asMicroseconds() - sent);
+
+            // Replace the received packet, until the end of the benchmark
+            if (timer.getElapsedTime() < end)
+                sendPacket();
+            else
+                --inFlight;
+        }
+    }
+
+    const std::vector<sf::Int64>& getLatencies() const
+    {
+        return m_latencies;
+    }
+
+private:
+
+    void sendPacket()
+    {
+        sf::Packet packet;
+        packet << timer.getElapsedTime().asMicroseconds();
+        for (unsigned int i = 0; i < payloadSize; ++i)
+            packet << static_cast<sf::Uint8>(i);
+
+        m_socket.send(packet);
+    }
+
+    unsigned short         m_port;
+    sf::TcpSocket          m_socket;
+    std::vector<sf::Int64> m_latencies;
+};
+
+
+////////////////////////////////////////////////////////////
+/// Run the clients against a server and print the results
+///
+////////////////////////////////////////////////////////////
+void runClients(const char* name, unsigned short port)
+{
+    std::vector<Client*> clients;
+    std::vector<sf::Thread*> threads;
+    for (unsigned int i = 0; i < clientCount; ++i)
+    {
+        clients.push_back(new Client(port));
+        threads.push_back(new sf::Thread(&Client::run, clients.back()));
+    }
+
+    sf::Time start = timer.getElapsedTime();
+    for (unsigned int i = 0; i < clientCount; ++i)
+        threads[i]->launch();
+    for (unsigned int i = 0; i < clientCount; ++i)
+        threads[i]->wait();
+    sf::Time elapsed = timer.getElapsedTime() - start;
+
+    // Gather the latencies of all the clients
+    std::vector<sf::Int64> latencies;
+    for (unsigned int i = 0; i < clientCount; ++i)
+    {
+        latencies.insert(latencies.end(), clients[i]->getLatencies().begin(), clients[i]->getLatencies().end());
+        delete threads[i];
+        delete clients[i];
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+
+    std::cout << std::left << std::setw(20) << name;
+    if (latencies.empty())
+    {
+        std::cout << "failed" << std::endl;
+        return;
+    }
+
+    std::cout << std::right
+              << std::setw(10) << static_cast<sf::Int64>(static_cast<double>(latencies.size()) / static_cast<double>(elapsed.asSeconds())) << " packets/s"
+              << "   p50 " << std::setw(6) << latencies[latencies.size() / 2] << " us"
+              << "   p99 " << std::setw(6) << latencies[latencies.size() * 99 / 100] << " us"
+              << "   p99.9 " << std::setw(6) << latencies[latencies.size() * 999 / 1000] << " us" << std::endl;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    std::cout << clientCount << " connections, " << pipelineDepth << " packets in flight each, "
+              << payloadSize << " bytes of payload, over the loopback interface" << std::endl;
+
+    // Hand-written SocketSelector loop
+    {
+        sf::TcpListener listener;
+        if (listener.listen(sf::Socket::AnyPort, sf::IpAddress::LocalHost) != sf::Socket::Done)
+            return EXIT_FAILURE;
+
+        SelectorServer server(listener);
+        sf::Thread thread(&SelectorServer::run, &server);
+        thread.launch();
+
+        runClients("SocketSelector", listener.getLocalPort());
+
+        server.stop();
+        thread.wait();
+    }
+
+    // NetworkReactor with one thread, then with one thread per connection pair
+    for (unsigned int threadCount = 1; threadCount <= clientCount / 2; threadCount *= 4)
+    {
+        sf::TcpListener listener;
+        if (listener.listen(sf::Socket::AnyPort, sf::IpAddress::LocalHost) != sf::Socket::Done)
+            return EXIT_FAILURE;
+
+        ReactorServer server(threadCount);
+        server.add(listener);
+        sf::Thread thread(&sf::NetworkReactor::run, static_cast<sf::NetworkReactor*>(&server));
+        thread.launch();
+
+        std::ostringstream name;
+        name << "NetworkReactor x" << threadCount;
+        runClients(name.str().c_str(), listener.getLocalPort());
+
+        server.stop();
+        thread.wait();
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,131 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network.hpp>
+#include <SFML/System.hpp>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <cstdlib>
+
+
+////////////////////////////////////////////////////////////
+// Benchmark settings
+////////////////////////////////////////////////////////////
+namespace
+{
+    const std::size_t payloadSize = 64; // Bytes per datagram
+    const std::size_t roundSize   = 64; // Datagrams sent before receiving them, small enough to never overflow the socket
+    const sf::Time    duration    = sf::seconds(2);
+}
+
+
+////////////////////////////////////////////////////////////
+/// Send and receive rounds of datagrams, one by one or
+/// in batches, and print the number of datagrams per second
+///
+/// \return Number of datagrams per second
+///
+////////////////////////////////////////////////////////////
+double runBenchmark(std::size_t batchSize, double reference)
+{
+    std::ostringstream name;
+    if (batchSize == 1)
+        name << "One by one";
+    else
+        name << "Batches of " << batchSize;
+    std::cout << std::left << std::setw(20) << name.str();
+
+    sf::UdpSocket sender;
+    sf::UdpSocket receiver;
+    if ((sender.bind(sf::Socket::AnyPort, sf::IpAddress::LocalHost) != sf::Socket::Done) ||
+        (receiver.bind(sf::Socket::AnyPort, sf::IpAddress::LocalHost) != sf::Socket::Done))
+    {
+        std::cout << "failed" << std::endl;
+        return 0;
+    }
+    receiver.setBlocking(false);
+
+    std::vector<char> payload(payloadSize, 'x');
+    std::vector<std::vector<char> > buffers(roundSize, std::vector<char>(payloadSize));
+    std::vector<sf::UdpSocket::Datagram> outgoing(roundSize);
+    std::vector<sf::UdpSocket::Datagram> incoming(roundSize);
+    for (std::size_t i = 0; i < roundSize; ++i)
+    {
+        outgoing[i].data          = &payload[0];
+        outgoing[i].size          = payload.size();
+        outgoing[i].remoteAddress = sf::IpAddress::LocalHost;
+        outgoing[i].remotePort    = receiver.getLocalPort();
+        incoming[i].data          = &buffers[i][0];
+        incoming[i].size          = buffers[i].size();
+    }
+
+    sf::Clock clock;
+    sf::Uint64 count = 0;
+    while (clock.getElapsedTime() < duration)
+    {
+        for (std::size_t i = 0; i < roundSize; i += batchSize)
+        {
+            if (batchSize == 1)
+            {
+                sender.send(&payload[0], payload.size(), sf::IpAddress::LocalHost, receiver.getLocalPort());
+            }
+            else
+            {
+                std::size_t sent = 0;
+                sender.send(&outgoing[i], batchSize, sent);
+            }
+        }
+
+        // Datagrams sent over the loopback interface are already there
+        for (std::size_t i = 0; i < roundSize; )
+        {
+            std::size_t received = 0;
+            sf::Socket::Status status;
+            if (batchSize == 1)
+            {
+                sf::IpAddress address;
+                unsigned short port = 0;
+                status = receiver.receive(&buffers[i][0], buffers[i].size(), received, address, port);
+                received = (status == sf::Socket::Done) ? 1 : 0;
+            }
+            else
+            {
+                status = receiver.receive(&incoming[i], batchSize, received);
+            }
+
+            if (status != sf::Socket::Done)
+                break;
+
+            i += received;
+            count += received;
+        }
+    }
+
+    double rate = static_cast<double>(count) / static_cast<double>(clock.getElapsedTime().asSeconds());
+    std::cout << std::right << std::setw(10) << static_cast<sf::Int64>(rate) << " datagrams/s";
+    if (reference > 0)
+        std::cout << "   x" << std::fixed << std::setprecision(2) << rate / reference;
+    std::cout << std::endl;
+
+    return rate;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    std::cout << payloadSize << " bytes per datagram, sent and received over the loopback interface" << std::endl;
+
+    double reference = runBenchmark(1, 0);
+    for (std::size_t batchSize = 8; batchSize <= roundSize; batchSize *= 8)
+        runBenchmark(batchSize, reference);
+
+    return EXIT_SUCCESS;
+}
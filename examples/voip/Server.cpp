@@ -77,9 +77,15 @@ private:
         if ((m_offset >= m_samples.size()) && m_hasFinished)
             return false;
 
-        // No new data has arrived since last update: wait until we get some
-        while ((m_offset >= m_samples.size()) && !m_hasFinished)
-            sf::sleep(sf::milliseconds(10));
+        // No new data has arrived since last update: play a short silence rather than waiting for some,
+        // the streaming thread is shared by all the streams and must not be blocked
+        if (m_offset >= m_samples.size())
+        {
+            m_tempBuffer.assign(getSampleRate() * getChannelCount() / 50, 0);
+            data.samples     = &m_tempBuffer[0];
+            data.sampleCount = m_tempBuffer.size();
+            return true;
+        }
 
         // Copy samples into a local buffer to avoid synchronization problems
         // (don't forget that we run in two separate threads)
@@ -0,0 +1,275 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2023 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_ASYNCOUTPUTSOUNDFILE_HPP
+#define SFML_ASYNCOUTPUTSOUNDFILE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/Audio/OutputSoundFile.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Thread.hpp>
+#include <SFML/System/Time.hpp>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+    template <typename T> class RingBuffer;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Write sound files from a background thread
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API AsyncOutputSoundFile : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Behaviours when the queue of samples is full
+    ///
+    ////////////////////////////////////////////////////////////
+    enum OverflowPolicy
+    {
+        Block, //!< write() encodes samples itself until there is room in the queue
+        Drop   //!< write() drops the samples which don't fit in the queue
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    AsyncOutputSoundFile();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Closes the file if it was still open, after writing all
+    /// the queued samples.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~AsyncOutputSoundFile();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open the sound file from the disk for writing
+    ///
+    /// The supported audio formats are: WAV, OGG/Vorbis, FLAC.
+    /// The queue of samples is allocated here, with the
+    /// duration set by setQueueDuration.
+    ///
+    /// \param filename     Path of the sound file to write
+    /// \param sampleRate   Sample rate of the sound
+    /// \param channelCount Number of channels in the sound
+    ///
+    /// \return True if the file was successfully opened
+    ///
+    ////////////////////////////////////////////////////////////
+    bool openFromFile(const std::string& filename, unsigned int sampleRate, unsigned int channelCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue audio samples for writing to the file
+    ///
+    /// The samples are copied into the queue, then encoded and
+    /// written to the file by a background thread. When the
+    /// queue is full, this function either waits or drops
+    /// the samples, according to the overflow policy.
+    ///
+    /// This function must always be called from the same thread.
+    ///
+    /// \param samples Pointer to the sample array to write
+    /// \param count   Number of samples to write, a multiple of the channel count
+    ///
+    /// \return Number of samples queued, lower than \a count if some were dropped
+    ///
+    /// \see setOverflowPolicy
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 write(const Int16* samples, Uint64 count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until all the queued samples are written
+    ///
+    /// The calling thread helps the background thread to
+    /// encode the samples left in the queue.
+    ///
+    ////////////////////////////////////////////////////////////
+    void flush();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Close the current file
+    ///
+    /// This function waits until all the queued samples are
+    /// written, then stops the background thread.
+    ///
+    ////////////////////////////////////////////////////////////
+    void close();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the duration of audio that the queue can hold
+    ///
+    /// The new duration is taken into account the next time a
+    /// file is opened. The default duration is 5 seconds.
+    ///
+    /// \param duration Duration of the queue
+    ///
+    ////////////////////////////////////////////////////////////
+    void setQueueDuration(Time duration);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the behaviour of write() when the queue is full
+    ///
+    /// The default policy is Block, so that no sample is lost.
+    /// The Drop policy suits real-time producers, like audio
+    /// capture, which must never wait.
+    ///
+    /// \param policy New overflow policy
+    ///
+    ////////////////////////////////////////////////////////////
+    void setOverflowPolicy(OverflowPolicy policy);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of samples dropped since the file was opened
+    ///
+    /// \return Number of samples dropped because the queue was full
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getDroppedSampleCount() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start the background thread if it is not running
+    ///
+    ////////////////////////////////////////////////////////////
+    void startEncoding();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called as the entry point of the thread
+    ///
+    /// This function encodes the queued samples until the queue
+    /// is empty; write() starts the thread again when it queues
+    /// new samples.
+    ///
+    ////////////////////////////////////////////////////////////
+    void encode();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Encode the next block of queued samples
+    ///
+    /// The encoder mutex must be locked, so that the samples are
+    /// read and written by a single thread at a time.
+    ///
+    /// \return Number of samples encoded, 0 if the queue is empty
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t encodeBlock();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    OutputSoundFile          m_file;           //!< File written by the background thread
+    priv::RingBuffer<Int16>* m_queue;          //!< Samples waiting to be encoded
+    std::vector<Int16>       m_encodeBuffer;   //!< Samples taken from the queue by the background thread
+    Thread                   m_thread;         //!< Thread encoding the samples in the background
+    Time                     m_queueDuration;  //!< Duration of audio that the queue can hold
+    OverflowPolicy           m_overflowPolicy; //!< Behaviour of write() when the queue is full
+    unsigned int             m_channelCount;   //!< Number of channels of the open file
+    bool                     m_isOpen;         //!< Is a file open?
+    bool                     m_isEncoding;     //!< Is the background thread running?
+    Uint64                   m_droppedCount;   //!< Number of samples dropped because the queue was full
+    mutable Mutex            m_mutex;          //!< Mutex protecting the state shared with the background thread
+    Mutex                    m_encoderMutex;   //!< Mutex held while a block of samples is encoded, by any thread
+};
+
+} // namespace sf
+
+
+#endif // SFML_ASYNCOUTPUTSOUNDFILE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::AsyncOutputSoundFile
+/// \ingroup audio
+///
+/// sf::OutputSoundFile encodes and writes the samples on the
+/// calling thread, which may take a while with compressed
+/// formats or slow disks. sf::AsyncOutputSoundFile only copies
+/// the samples into a bounded queue; a background thread
+/// encodes them and writes them to the file.
+///
+/// When the encoder can't keep up and the queue is full,
+/// write() either encodes samples itself to make room, or drops
+/// the samples, according to the overflow policy. flush() and
+/// close() wait until all the queued samples are written. The
+/// background thread only runs while there are samples to
+/// encode.
+///
+/// Usage example:
+/// \code
+/// class FileRecorder : public sf::SoundRecorder
+/// {
+/// public:
+///     FileRecorder()
+///     {
+///         // Never stall the capture thread
+///         m_file.setOverflowPolicy(sf::AsyncOutputSoundFile::Drop);
+///     }
+///
+///     ~FileRecorder()
+///     {
+///         stop();
+///     }
+///
+/// private:
+///     virtual bool onStart()
+///     {
+///         return m_file.openFromFile("session.flac", getSampleRate(), getChannelCount());
+///     }
+///
+///     virtual bool onProcessSamples(const sf::Int16* samples, std::size_t sampleCount)
+///     {
+///         m_file.write(samples, sampleCount);
+///         return true;
+///     }
+///
+///     virtual void onStop()
+///     {
+///         m_file.close();
+///     }
+///
+///     sf::AsyncOutputSoundFile m_file;
+/// };
+/// \endcode
+///
+/// \see sf::OutputSoundFile, sf::SoundRecorder
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,185 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2023 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_AUDIOOUTPUT_HPP
+#define SFML_AUDIOOUTPUT_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/Config.hpp>
+#include <SFML/System/Time.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Selects where the mixed audio output goes
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API AudioOutput
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destinations of the mixed audio output
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Mode
+    {
+        Device,  //!< Play through the default audio device (default)
+        Null,    //!< Mix in real time, and discard the output
+        Loopback //!< Mix only when render() is called, as fast as possible
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Select the destination of the mixed audio output
+    ///
+    /// The mode can only be changed while no audio resource
+    /// (sound, music, sound buffer, ...) exists, typically
+    /// at the start of the program. The sample rate and
+    /// channel count are those of the rendered output, they
+    /// are used only by the Loopback mode.
+    /// The Loopback mode requires the ALC_SOFT_loopback
+    /// extension, and the Null mode requires the null backend
+    /// of OpenAL Soft.
+    ///
+    /// \param mode         New output mode
+    /// \param sampleRate   Sample rate of the rendered output
+    /// \param channelCount Number of channels of the rendered output (1, 2, 4, 6, 7 or 8)
+    ///
+    /// \return True if the mode was changed
+    ///
+    /// \see getMode, isLoopbackAvailable
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool setMode(Mode mode, unsigned int sampleRate = 44100, unsigned int channelCount = 2);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current destination of the mixed audio output
+    ///
+    /// \return Current output mode
+    ///
+    /// \see setMode
+    ///
+    ////////////////////////////////////////////////////////////
+    static Mode getMode();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the Loopback mode is supported
+    ///
+    /// \return True if the Loopback mode can be used
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isLoopbackAvailable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Render the next frames of the mixed output
+    ///
+    /// This function is only available in the Loopback mode.
+    /// The sound streams are fed while rendering, as often
+    /// as they would be in real time, so the playback of all
+    /// the sounds and musics advances by exactly \a frameCount
+    /// frames of output: their timing is driven by the rendered
+    /// samples rather than by the wall clock.
+    /// The samples are interleaved; if \a samples is NULL, the
+    /// frames are rendered and discarded.
+    ///
+    /// \param samples    Array to fill, large enough for \a frameCount frames (can be NULL)
+    /// \param frameCount Number of frames to render
+    ///
+    /// \return True on success, false if the output is not in the
+    ///         Loopback mode or if no audio resource exists
+    ///
+    /// \see getRenderedDuration
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool render(float* samples, Uint64 frameCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \overload
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool render(Int16* samples, Uint64 frameCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the duration of the output rendered so far
+    ///
+    /// The duration is counted since the audio device was
+    /// opened, ie. since the first audio resource was created.
+    ///
+    /// \return Rendered duration, always zero outside of the Loopback mode
+    ///
+    /// \see render
+    ///
+    ////////////////////////////////////////////////////////////
+    static Time getRenderedDuration();
+};
+
+} // namespace sf
+
+
+#endif // SFML_AUDIOOUTPUT_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::AudioOutput
+/// \ingroup audio
+///
+/// By default, the audio module plays through the default
+/// audio device of the system. sf::AudioOutput makes it run
+/// without one, for tests on servers and continuous
+/// integration machines, or for offline processing:
+/// \li in the Null mode, the sounds are mixed in real time
+///     and the output is discarded
+/// \li in the Loopback mode, nothing is mixed until render()
+///     is called; the whole pipeline (decoding, streaming,
+///     mixing) then runs as fast as possible, and gives the
+///     same output at every run
+///
+/// Usage example:
+/// \code
+/// // Select the mode before creating any audio resource
+/// if (!sf::AudioOutput::setMode(sf::AudioOutput::Loopback, 48000, 2))
+///     return -1;
+///
+/// sf::Music music;
+/// music.openFromFile("music.ogg");
+/// music.play();
+///
+/// // Render the whole music into memory
+/// std::vector<float> output;
+/// std::vector<float> block(2 * 4800);
+/// while (music.getStatus() == sf::Music::Playing)
+/// {
+///     sf::AudioOutput::render(&block[0], 4800);
+///     output.insert(output.end(), block.begin(), block.end());
+/// }
+/// \endcode
+///
+/// \see sf::Listener
+///
+////////////////////////////////////////////////////////////
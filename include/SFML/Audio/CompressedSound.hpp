@@ -0,0 +1,187 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2023 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_COMPRESSEDSOUND_HPP
+#define SFML_COMPRESSEDSOUND_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/Audio/SoundStream.hpp>
+#include <SFML/Audio/InputSoundFile.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class CompressedSoundBuffer;
+
+////////////////////////////////////////////////////////////
+/// \brief Sound decoded from a compressed sound buffer when it plays
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API CompressedSound : public SoundStream
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    CompressedSound();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the sound with a buffer
+    ///
+    /// \param buffer Compressed sound buffer containing the audio data to play
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit CompressedSound(const CompressedSoundBuffer& buffer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~CompressedSound();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the source buffer containing the audio data to play
+    ///
+    /// It is important to note that the sound buffer is not copied,
+    /// thus the sf::CompressedSoundBuffer instance must remain alive
+    /// as long as it is attached to the sound.
+    /// Changing the buffer stops the sound.
+    ///
+    /// \param buffer Compressed sound buffer to attach to the sound
+    ///
+    /// \see getBuffer
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBuffer(const CompressedSoundBuffer& buffer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the audio buffer attached to the sound
+    ///
+    /// \return Compressed sound buffer attached to the sound (can be NULL)
+    ///
+    ////////////////////////////////////////////////////////////
+    const CompressedSoundBuffer* getBuffer() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the internal buffer of the sound
+    ///
+    /// This function is for internal use only, you don't have
+    /// to use it. It is called by the sf::CompressedSoundBuffer that
+    /// this sound uses, when it is destroyed or loaded again in
+    /// order to prevent the sound from using a dead buffer.
+    ///
+    ////////////////////////////////////////////////////////////
+    void resetBuffer();
+
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Request a new chunk of audio samples from the stream source
+    ///
+    /// This function fills the chunk from the next samples of
+    /// the sound, decoding them if needed.
+    ///
+    /// \param data Chunk of data to fill
+    ///
+    /// \return True to continue playback, false to stop
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool onGetData(Chunk& data);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the current playing position in the stream source
+    ///
+    /// \param timeOffset New playing position, from the beginning of the sound
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onSeek(Time timeOffset);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of samples of a chunk of the preferred duration
+    ///
+    /// \return Number of samples (not frames) in a chunk
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getChunkSampleCount() const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    const CompressedSoundBuffer* m_buffer;  //!< Compressed sound buffer containing the audio data
+    InputSoundFile               m_file;    //!< Decoder of the buffer, for streamed sounds
+    std::vector<Int16>           m_samples; //!< Temporary buffer of samples
+    Uint64                       m_offset;  //!< Offset of the next sample to play, for sounds decoded entirely
+    Mutex                        m_mutex;   //!< Mutex protecting the decoding state
+};
+
+} // namespace sf
+
+
+#endif // SFML_COMPRESSEDSOUND_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::CompressedSound
+/// \ingroup audio
+///
+/// sf::CompressedSound plays the audio data of a
+/// sf::CompressedSoundBuffer, which is kept encoded in memory.
+/// It has the same features as sf::Sound: you can play/pause/stop
+/// it, change the way it is played (pitch, volume, 3D position, ...),
+/// make it loop, etc.
+///
+/// The sound is decoded when it plays: short sounds are decoded
+/// entirely, into a cache shared by all the compressed sounds
+/// so that sounds played often are decoded once, and long sounds
+/// are decoded progressively like sf::Music. Being a sound
+/// stream, a compressed sound is fed by the streaming thread of
+/// SFML, shared with the other streams. Short sounds are decoded
+/// when they are attached to the sound (see setBuffer), and the
+/// sound is fed by chunks of 50 ms, so that each instance only
+/// keeps a few of them in memory.
+///
+/// Usage example:
+/// \code
+/// sf::CompressedSoundBuffer buffer;
+/// buffer.loadFromFile("footstep.ogg");
+///
+/// sf::CompressedSound sound;
+/// sound.setBuffer(buffer);
+/// sound.setVolume(50);
+/// sound.play();
+/// \endcode
+///
+/// \see sf::CompressedSoundBuffer, sf::Sound, sf::Music
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,273 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2023 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_COMPRESSEDSOUNDBUFFER_HPP
+#define SFML_COMPRESSEDSOUNDBUFFER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/Config.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <set>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class CompressedSound;
+class InputStream;
+
+////////////////////////////////////////////////////////////
+/// \brief Storage for a sound kept encoded in memory
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API CompressedSoundBuffer : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    CompressedSoundBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~CompressedSoundBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the sound buffer from a file
+    ///
+    /// See the documentation of sf::InputSoundFile for the list
+    /// of supported formats. The file is read entirely, but
+    /// it is not decoded.
+    ///
+    /// \param filename Path of the sound file to load
+    ///
+    /// \return True if loading succeeded, false if it failed
+    ///
+    /// \see loadFromMemory, loadFromStream
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromFile(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the sound buffer from a file in memory
+    ///
+    /// See the documentation of sf::InputSoundFile for the list
+    /// of supported formats. The data is copied.
+    ///
+    /// \param data        Pointer to the file data in memory
+    /// \param sizeInBytes Size of the data to load, in bytes
+    ///
+    /// \return True if loading succeeded, false if it failed
+    ///
+    /// \see loadFromFile, loadFromStream
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromMemory(const void* data, std::size_t sizeInBytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the sound buffer from a custom stream
+    ///
+    /// See the documentation of sf::InputSoundFile for the list
+    /// of supported formats. The stream is read entirely.
+    ///
+    /// \param stream Source stream to read from
+    ///
+    /// \return True if loading succeeded, false if it failed
+    ///
+    /// \see loadFromFile, loadFromMemory
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromStream(InputStream& stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of samples of the decoded sound
+    ///
+    /// \return Number of samples
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getSampleCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the sample rate of the sound
+    ///
+    /// \return Sample rate (number of samples per second)
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getSampleRate() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of channels used by the sound
+    ///
+    /// \return Number of channels
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getChannelCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the total duration of the sound
+    ///
+    /// \return Sound duration
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getDuration() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the encoded data held in memory
+    ///
+    /// \return Size of the encoded data, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getEncodedSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the maximum size of the decoded samples kept
+    ///        in memory for compressed sound buffers
+    ///
+    /// Short sounds are decoded entirely when they are played,
+    /// and their samples are kept in a cache shared by all the
+    /// compressed sound buffers, so that sounds played often
+    /// are not decoded again. When the cache exceeds this size,
+    /// the samples of the least recently played sounds which
+    /// are not playing are released.
+    /// The default size is 32 MB.
+    ///
+    /// \param sizeInBytes Maximum size of the decoded samples, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setDecodedCacheSize(std::size_t sizeInBytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the duration above which sounds are streamed
+    ///
+    /// Sounds longer than this duration are never decoded
+    /// entirely: they are decoded progressively while they play,
+    /// like sf::Music. The new value applies to the sounds
+    /// loaded afterwards. The default duration is 10 seconds.
+    ///
+    /// \param duration Duration above which sounds are streamed
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setStreamingThreshold(Time duration);
+
+private:
+
+    friend class CompressedSound;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Take the encoded data and read its properties
+    ///
+    /// \param data Encoded file data, emptied on success
+    ///
+    /// \return True if the data can be decoded
+    ///
+    ////////////////////////////////////////////////////////////
+    bool initialize(std::vector<char>& data);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a sound to the list of sounds that use this buffer
+    ///
+    /// \param sound Sound instance to attach
+    ///
+    ////////////////////////////////////////////////////////////
+    void attachSound(CompressedSound* sound) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a sound from the list of sounds that use this buffer
+    ///
+    /// \param sound Sound instance to detach
+    ///
+    ////////////////////////////////////////////////////////////
+    void detachSound(CompressedSound* sound) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Detach the buffer from all the sounds that use it
+    ///
+    ////////////////////////////////////////////////////////////
+    void resetSounds();
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef std::set<CompressedSound*> SoundList; //!< Set of unique sound instances
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<char> m_data;         //!< Encoded file data
+    Uint64            m_id;           //!< Identifier of the contents in the cache of decoded samples, 0 if empty
+    Uint64            m_sampleCount;  //!< Number of samples of the decoded sound
+    unsigned int      m_sampleRate;   //!< Sample rate
+    unsigned int      m_channelCount; //!< Number of channels
+    bool              m_isStreamed;   //!< Is the sound decoded progressively while it plays?
+    mutable SoundList m_sounds;       //!< List of sounds that are using this buffer
+};
+
+} // namespace sf
+
+
+#endif // SFML_COMPRESSEDSOUNDBUFFER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::CompressedSoundBuffer
+/// \ingroup audio
+///
+/// sf::SoundBuffer keeps the decoded samples of a sound in
+/// memory, which is often 5 to 10 times larger than the
+/// compressed file (OGG, FLAC, MP3). For large libraries of
+/// sounds which are rarely played, sf::CompressedSoundBuffer
+/// keeps the encoded file data only, and the sounds are decoded
+/// when they are played by a sf::CompressedSound.
+///
+/// Short sounds are decoded entirely, into a cache of decoded
+/// samples shared by all the compressed sound buffers, which
+/// keeps the sounds played recently; long sounds are decoded
+/// progressively while they play (see setStreamingThreshold).
+///
+/// Like sf::SoundBuffer, a compressed sound buffer which is
+/// destroyed or loaded again stops the sounds using it.
+///
+/// Usage example:
+/// \code
+/// sf::CompressedSoundBuffer buffer;
+/// if (!buffer.loadFromFile("voice_line_0042.ogg"))
+///     return -1;
+///
+/// sf::CompressedSound sound(buffer);
+/// sound.play();
+/// \endcode
+///
+/// \see sf::CompressedSound, sf::SoundBuffer
+///
+////////////////////////////////////////////////////////////
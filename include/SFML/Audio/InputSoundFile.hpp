@@ -200,6 +200,55 @@ public:
     ////////////////////////////////////////////////////////////
     Uint64 read(Int16* samples, Uint64 maxCount);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Read audio samples from the open file, as normalized floats
+    ///
+    /// Compressed formats are decoded straight to floating
+    /// point, without going through 16-bit integers.
+    ///
+    /// \param samples  Pointer to the sample array to fill
+    /// \param maxCount Maximum number of samples to read
+    ///
+    /// \return Number of samples actually read (may be less than \a maxCount)
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 read(float* samples, Uint64 maxCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save the seek table of the open file
+    ///
+    /// Seeking in some compressed formats, such as MP3, requires
+    /// scanning the whole file once to build a seek table. This
+    /// function builds the table if needed and saves it to a
+    /// file, typically stored alongside the sound file, so that
+    /// loadSeekTable() can skip the scan the next time the sound
+    /// file is opened.
+    ///
+    /// \param filename Path of the seek table file to write
+    ///
+    /// \return True if the table was saved, false if the format
+    ///         doesn't need a seek table or an error occurred
+    ///
+    /// \see loadSeekTable
+    ///
+    ////////////////////////////////////////////////////////////
+    bool saveSeekTable(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the seek table of the open file
+    ///
+    /// The table must have been saved by saveSeekTable() for the
+    /// same sound file; it is ignored if it doesn't match.
+    ///
+    /// \param filename Path of the seek table file to read
+    ///
+    /// \return True if the table is used, false otherwise
+    ///
+    /// \see saveSeekTable
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadSeekTable(const std::string& filename);
+
     ////////////////////////////////////////////////////////////
     /// \brief Close the current file
     ///
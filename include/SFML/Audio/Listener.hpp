@@ -194,6 +194,35 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     static Vector3f getUpVector();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start a batch of updates of the listener and sources
+    ///
+    /// Until the matching call to endUpdate, the changes made
+    /// to the listener and to the sound sources (position,
+    /// volume, pitch, ...) are not heard: they are all applied
+    /// at once by endUpdate, so that the audio is never mixed
+    /// with a partially updated scene, and the driver processes
+    /// them in one go. Batches can be nested; the changes are
+    /// applied when the outermost one ends.
+    ///
+    /// Batching relies on the AL_SOFT_deferred_updates extension;
+    /// when it is not available, the changes are applied
+    /// immediately as usual. Batches should be kept short, as
+    /// starting or stopping sounds may be deferred too.
+    ///
+    /// \see endUpdate
+    ///
+    ////////////////////////////////////////////////////////////
+    static void beginUpdate();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief End a batch of updates of the listener and sources
+    ///
+    /// \see beginUpdate
+    ///
+    ////////////////////////////////////////////////////////////
+    static void endUpdate();
 };
 
 } // namespace sf
@@ -229,6 +258,13 @@ public:
 ///
 /// // Reduce the global volume
 /// sf::Listener::setGlobalVolume(50);
+///
+/// // Move many things at once, without intermediate states being heard
+/// sf::Listener::beginUpdate();
+/// sf::Listener::setPosition(playerPosition);
+/// for (std::size_t i = 0; i < sounds.size(); ++i)
+///     sounds[i].setPosition(emitterPositions[i]);
+/// sf::Listener::endUpdate();
 /// \endcode
 ///
 ////////////////////////////////////////////////////////////
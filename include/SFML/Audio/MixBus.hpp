@@ -0,0 +1,313 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2023 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_MIXBUS_HPP
+#define SFML_MIXBUS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/Audio/SoundStream.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <map>
+#include <vector>
+
+
+namespace sf
+{
+class SoundBuffer;
+
+////////////////////////////////////////////////////////////
+/// \brief Sound stream mixing many sound buffers in software
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API MixBus : public SoundStream
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Identifier of a voice of the bus
+    ///
+    /// Identifiers are never reused, so the identifier of a
+    /// finished voice can safely be kept: the functions taking
+    /// it simply have no effect.
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef Uint64 VoiceId;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Constructor
+    ///
+    /// The bus outputs stereo samples. Its chunk duration is
+    /// set to 50 ms, so that new voices are heard quickly.
+    ///
+    /// \param sampleRate Sample rate of the mix, in samples per second
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit MixBus(unsigned int sampleRate = 44100);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~MixBus();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a voice playing a sound buffer to the mix
+    ///
+    /// The voice is heard as soon as the bus itself is playing.
+    /// Mono buffers are panned, the first two channels of other
+    /// buffers are balanced. Buffers at a different sample rate
+    /// than the bus are resampled.
+    ///
+    /// The sound buffer must remain alive and unmodified as long
+    /// as the voice plays, and keep its samples in memory (see
+    /// sf::SoundBuffer::setResidency).
+    ///
+    /// \param buffer Sound buffer to play
+    /// \param volume Volume of the voice, in the range [0, 100]
+    /// \param pan    Pan of the voice, from -1 (left) to 1 (right)
+    ///
+    /// \return Identifier of the new voice
+    ///
+    ////////////////////////////////////////////////////////////
+    VoiceId playVoice(const SoundBuffer& buffer, float volume = 100.f, float pan = 0.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a voice from the mix
+    ///
+    /// \param voice Voice to stop
+    ///
+    ////////////////////////////////////////////////////////////
+    void stopVoice(VoiceId voice);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the voices from the mix
+    ///
+    ////////////////////////////////////////////////////////////
+    void stopAllVoices();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a voice is still playing
+    ///
+    /// \param voice Voice to check
+    ///
+    /// \return True if the voice is playing
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isVoicePlaying(VoiceId voice) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the volume of a voice
+    ///
+    /// \param voice  Voice to modify
+    /// \param volume Volume of the voice, in the range [0, 100]
+    ///
+    ////////////////////////////////////////////////////////////
+    void setVoiceVolume(VoiceId voice, float volume);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the pitch of a voice
+    ///
+    /// The pitch is applied by resampling the buffer, it thus
+    /// changes the playing speed of the voice as well.
+    ///
+    /// \param voice Voice to modify
+    /// \param pitch New pitch of the voice
+    ///
+    ////////////////////////////////////////////////////////////
+    void setVoicePitch(VoiceId voice, float pitch);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the pan of a voice
+    ///
+    /// \param voice Voice to modify
+    /// \param pan   Pan of the voice, from -1 (left) to 1 (right)
+    ///
+    ////////////////////////////////////////////////////////////
+    void setVoicePan(VoiceId voice, float pan);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set whether or not a voice should loop after reaching the end
+    ///
+    /// \param voice Voice to modify
+    /// \param loop  True to play in loop, false to play once
+    ///
+    ////////////////////////////////////////////////////////////
+    void setVoiceLoop(VoiceId voice, bool loop);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of voices in the mix
+    ///
+    /// \return Number of playing voices
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getVoiceCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the cutoff frequency of the low-pass filter of the bus
+    ///
+    /// The filter is a one-pole filter applied to the mix.
+    /// A cutoff of 0 disables it, which is the default.
+    ///
+    /// \param frequency Cutoff frequency, in Hz
+    ///
+    /// \see setHighPassCutoff
+    ///
+    ////////////////////////////////////////////////////////////
+    void setLowPassCutoff(float frequency);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the cutoff frequency of the high-pass filter of the bus
+    ///
+    /// The filter is a one-pole filter applied to the mix.
+    /// A cutoff of 0 disables it, which is the default.
+    ///
+    /// \param frequency Cutoff frequency, in Hz
+    ///
+    /// \see setLowPassCutoff
+    ///
+    ////////////////////////////////////////////////////////////
+    void setHighPassCutoff(float frequency);
+
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mix the voices into a new chunk of audio samples
+    ///
+    /// \param data Chunk of data to fill
+    ///
+    /// \return Always true, the bus plays until it is stopped
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool onGetData(Chunk& data);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the current playing position in the stream source
+    ///
+    /// A bus has no timeline, this function does nothing.
+    ///
+    /// \param timeOffset New playing position, from the beginning of the stream
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onSeek(Time timeOffset);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief State of a voice
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Voice
+    {
+        const SoundBuffer* buffer;   //!< Sound buffer played by the voice
+        float              volume;   //!< Volume, in the range [0, 100]
+        float              pitch;    //!< Pitch
+        float              pan;      //!< Pan, in the range [-1, 1]
+        bool               loop;     //!< Does the voice loop?
+        double             position; //!< Playing position in the buffer, in frames
+    };
+
+    typedef std::map<VoiceId, Voice> VoiceMap;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mix a voice into the mix buffer
+    ///
+    /// \param voice      Voice to mix
+    /// \param frameCount Number of frames to mix
+    ///
+    /// \return False if the voice reached its end
+    ///
+    ////////////////////////////////////////////////////////////
+    bool mixVoice(Voice& voice, std::size_t frameCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply the filters of the bus to the mix buffer
+    ///
+    /// \param frameCount Number of frames to filter
+    ///
+    ////////////////////////////////////////////////////////////
+    void applyFilters(std::size_t frameCount);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    VoiceMap           m_voices;           //!< Voices of the mix
+    VoiceId            m_nextId;           //!< Identifier of the next voice
+    std::vector<float> m_mix;              //!< Mix buffer, interleaved stereo
+    float              m_lowPassCutoff;    //!< Cutoff frequency of the low-pass filter, 0 if disabled
+    float              m_highPassCutoff;   //!< Cutoff frequency of the high-pass filter, 0 if disabled
+    float              m_lowPassState[2];  //!< Output of the low-pass filter, per channel
+    float              m_highPassState[2]; //!< Low-passed signal removed by the high-pass filter, per channel
+    mutable Mutex      m_mutex;            //!< Mutex protecting the voices against the streaming thread
+};
+
+} // namespace sf
+
+
+#endif // SFML_MIXBUS_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::MixBus
+/// \ingroup audio
+///
+/// Each sf::Sound is mixed by OpenAL through its own audio
+/// source. For dense ambiences, crowds or any group of sounds
+/// which don't need individual 3D placement, this costs a lot
+/// of sources and mixing time.
+///
+/// sf::MixBus mixes any number of sound buffers in software,
+/// on the streaming thread, and plays the result through a
+/// single audio source. Each sound played on the bus is a voice,
+/// with its own volume, pitch (by resampling) and pan. The mix
+/// itself can be filtered, and since sf::MixBus is a sound
+/// stream, the bus as a whole can be positioned, attenuated and
+/// given a volume like any other sound source.
+///
+/// The cost of a bus is proportional to the number of samples
+/// mixed, and doesn't depend on the number of sources available.
+///
+/// Usage example:
+/// \code
+/// sf::SoundBuffer footstep;
+/// footstep.loadFromFile("footstep.wav");
+///
+/// sf::MixBus crowd;
+/// crowd.setVolume(60.f);
+/// crowd.setLowPassCutoff(4000.f);
+/// crowd.play();
+///
+/// for (int i = 0; i < 200; ++i)
+/// {
+///     sf::MixBus::VoiceId voice = crowd.playVoice(footstep, 30.f, randomPan());
+///     crowd.setVoicePitch(voice, randomPitch());
+/// }
+/// \endcode
+///
+/// \see sf::SoundStream, sf::VoiceManager
+///
+////////////////////////////////////////////////////////////
@@ -41,6 +41,11 @@ namespace sf
 {
 class InputStream;
 
+namespace priv
+{
+    class ReadAheadDecoder;
+}
+
 ////////////////////////////////////////////////////////////
 /// \brief Streamed music played from an audio file
 ///
@@ -163,6 +168,53 @@ public:
     ////////////////////////////////////////////////////////////
     bool openFromStream(InputStream& stream);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the format of the samples decoded from the file
+    ///
+    /// With sf::Float32Samples, compressed formats are decoded
+    /// straight to floating point and streamed without being
+    /// quantized to 16 bits (if the device supports it).
+    /// Changing the sample format stops the music.
+    /// The default sample format is sf::Int16Samples.
+    ///
+    /// \param sampleFormat New sample format
+    ///
+    /// \see getSampleFormat
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSampleFormat(SampleFormat sampleFormat);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save the seek table of the music
+    ///
+    /// See sf::InputSoundFile::saveSeekTable. Storing the table
+    /// alongside the music file makes the first seek fast the
+    /// next time the music is opened, for formats such as MP3.
+    ///
+    /// \param filename Path of the seek table file to write
+    ///
+    /// \return True if the table was saved
+    ///
+    /// \see loadSeekTable
+    ///
+    ////////////////////////////////////////////////////////////
+    bool saveSeekTable(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the seek table of the music
+    ///
+    /// See sf::InputSoundFile::loadSeekTable. This function
+    /// should be called right after opening the music.
+    ///
+    /// \param filename Path of the seek table file to read
+    ///
+    /// \return True if the table is used
+    ///
+    /// \see saveSeekTable
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadSeekTable(const std::string& filename);
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the total duration of the music
     ///
@@ -239,6 +291,7 @@ protected:
     /// This is called by the underlying SoundStream whenever it needs us to reset
     /// the seek position for a loop. We then determine whether we are looping on a
     /// loop point or the end-of-file, perform the seek, and return the new position.
+    /// The seek is usually already done by the read-ahead decoder.
     ///
     /// \return The seek position after looping (or -1 if there's no loop)
     ///
@@ -253,6 +306,14 @@ private:
     ////////////////////////////////////////////////////////////
     void initialize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of samples of a chunk of the preferred duration
+    ///
+    /// \return Number of samples (not frames) in a chunk
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getChunkSampleCount() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Helper to convert an sf::Time to a sample position
     ///
@@ -276,10 +337,13 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    InputSoundFile     m_file;     //!< The streamed music file
-    std::vector<Int16> m_samples;  //!< Temporary buffer of samples
-    Mutex              m_mutex;    //!< Mutex protecting the data
-    Span<Uint64>       m_loopSpan; //!< Loop Range Specifier
+    InputSoundFile          m_file;         //!< The streamed music file
+    std::vector<Int16>      m_samples;      //!< Temporary buffer of samples
+    std::vector<float>      m_floatSamples; //!< Temporary buffer of samples, for the Float32Samples format
+    SampleFormat            m_sampleFormat; //!< Format of the decoded samples
+    Mutex                   m_mutex;        //!< Mutex protecting the file
+    Span<Uint64>            m_loopSpan;     //!< Loop Range Specifier
+    priv::ReadAheadDecoder* m_decoder;      //!< Decoder filling the samples ahead of the stream
 };
 
 } // namespace sf
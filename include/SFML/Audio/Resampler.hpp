@@ -0,0 +1,255 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2023 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_RESAMPLER_HPP
+#define SFML_RESAMPLER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/Config.hpp>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Converts audio samples to another sample rate
+///        and channel count
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API Resampler
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The default resampler converts 44100 Hz stereo samples
+    /// to the same format, ie. it only copies them.
+    ///
+    ////////////////////////////////////////////////////////////
+    Resampler();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the resampler for a conversion
+    ///
+    /// \param inputSampleRate    Sample rate of the input samples
+    /// \param inputChannelCount  Number of channels of the input samples
+    /// \param outputSampleRate   Sample rate of the output samples
+    /// \param outputChannelCount Number of channels of the output samples
+    ///
+    ////////////////////////////////////////////////////////////
+    Resampler(unsigned int inputSampleRate, unsigned int inputChannelCount, unsigned int outputSampleRate, unsigned int outputChannelCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the conversion done by the resampler
+    ///
+    /// The channel counts must be between 1 and 8; the channels
+    /// are ordered like in OpenAL (see the class description).
+    /// This function resets the resampler.
+    ///
+    /// \param inputSampleRate    Sample rate of the input samples
+    /// \param inputChannelCount  Number of channels of the input samples
+    /// \param outputSampleRate   Sample rate of the output samples
+    /// \param outputChannelCount Number of channels of the output samples
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFormat(unsigned int inputSampleRate, unsigned int inputChannelCount, unsigned int outputSampleRate, unsigned int outputChannelCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert a block of input samples
+    ///
+    /// The resampler keeps the end of the input, so that
+    /// consecutive blocks of a stream are converted as a whole.
+    /// The converted frames are appended to \a output; when the
+    /// sample rate changes, they lag a few frames behind the
+    /// input, until flush() is called.
+    ///
+    /// \param input      Interleaved input samples
+    /// \param frameCount Number of input frames (samples per channel)
+    /// \param output     Vector to which the output samples are appended
+    ///
+    /// \see flush
+    ///
+    ////////////////////////////////////////////////////////////
+    void process(const Int16* input, Uint64 frameCount, std::vector<Int16>& output);
+
+    ////////////////////////////////////////////////////////////
+    /// \overload
+    ///
+    ////////////////////////////////////////////////////////////
+    void process(const float* input, Uint64 frameCount, std::vector<float>& output);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert the end of the stream
+    ///
+    /// This function appends the last frames of the output,
+    /// so that the whole output lasts as long as the whole
+    /// input, and resets the resampler for a new stream.
+    ///
+    /// \param output Vector to which the output samples are appended
+    ///
+    /// \see process, reset
+    ///
+    ////////////////////////////////////////////////////////////
+    void flush(std::vector<Int16>& output);
+
+    ////////////////////////////////////////////////////////////
+    /// \overload
+    ///
+    ////////////////////////////////////////////////////////////
+    void flush(std::vector<float>& output);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Discard the end of the current stream
+    ///
+    /// After a reset, the next input starts a new stream.
+    ///
+    /// \see flush
+    ///
+    ////////////////////////////////////////////////////////////
+    void reset();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of frames of a whole converted stream
+    ///
+    /// \param inputFrameCount  Number of frames of the input stream
+    /// \param inputSampleRate  Sample rate of the input stream
+    /// \param outputSampleRate Sample rate of the output stream
+    ///
+    /// \return Number of frames produced by process() and flush() for the whole stream
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 getOutputFrameCount(Uint64 inputFrameCount, unsigned int inputSampleRate, unsigned int outputSampleRate);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert float input frames to float output frames
+    ///
+    /// \param input      Interleaved input samples
+    /// \param frameCount Number of input frames
+    /// \param output     Vector to which the output samples are appended
+    ///
+    ////////////////////////////////////////////////////////////
+    void processFrames(const float* input, Uint64 frameCount, std::vector<float>& output);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Filter the buffered input into output frames
+    ///
+    /// \param frameLimit Maximum total number of output frames since the last reset
+    /// \param output     Vector to which the output samples are appended
+    ///
+    ////////////////////////////////////////////////////////////
+    void filter(Uint64 frameLimit, std::vector<float>& output);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mix frames from a number of channels to another
+    ///
+    /// \param input      Interleaved input frames
+    /// \param frameCount Number of frames
+    /// \param output     Array to fill with the interleaved output frames
+    ///
+    ////////////////////////////////////////////////////////////
+    void mix(const float* input, std::size_t frameCount, float* output) const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int                     m_inputSampleRate;    //!< Sample rate of the input
+    unsigned int                     m_inputChannelCount;  //!< Number of channels of the input
+    unsigned int                     m_outputSampleRate;   //!< Sample rate of the output
+    unsigned int                     m_outputChannelCount; //!< Number of channels of the output
+    unsigned int                     m_channelCount;       //!< Number of channels which are filtered (the smallest count)
+    Uint64                           m_upFactor;           //!< Interpolation factor of the rate ratio, in lowest terms
+    Uint64                           m_downFactor;         //!< Decimation factor of the rate ratio, in lowest terms
+    std::size_t                      m_phaseCount;         //!< Number of phases of the filter table
+    std::size_t                      m_halfLength;         //!< Half the number of taps of the filter
+    std::vector<float>               m_filter;             //!< Filter table, (phase count + 1) * (2 * half length) coefficients
+    std::vector<float>               m_matrix;             //!< Channel mixing matrix, output channels * input channels gains
+    std::vector<std::vector<float> > m_history;            //!< Buffered input of each filtered channel
+    std::size_t                      m_position;           //!< Index in the history of the last input frame before the next output frame
+    Uint64                           m_fraction;           //!< Position of the next output frame after m_position, in 1 / m_upFactor frames
+    Uint64                           m_inputFrameCount;    //!< Number of frames received since the last reset
+    Uint64                           m_outputFrameCount;   //!< Number of frames produced since the last reset
+    std::vector<float>               m_input;              //!< Temporary buffer of input samples, converted to float
+    std::vector<float>               m_output;             //!< Temporary buffer of output samples, to convert to 16 bits
+    std::vector<float>               m_frames;             //!< Temporary buffer of frames mixed before or after filtering
+};
+
+} // namespace sf
+
+
+#endif // SFML_RESAMPLER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Resampler
+/// \ingroup audio
+///
+/// OpenAL plays sounds of any sample rate, but it resamples
+/// them to the rate of the audio device every time they are
+/// played. sf::Resampler converts samples once and for all,
+/// with a polyphase windowed-sinc filter; its inner loops
+/// work on contiguous arrays of floats, so that they are
+/// vectorized by the compiler. It is used by sf::SoundBuffer
+/// to convert sounds to the rate of the device when they are
+/// loaded (see sf::SoundBuffer::setResampled), and can be used
+/// on recorded samples, or on any other stream of samples.
+///
+/// sf::Resampler also converts the number of channels. The
+/// channels are ordered like in OpenAL:
+/// \li 1 channel: mono
+/// \li 2 channels: left, right
+/// \li 4 channels: front left, front right, rear left, rear right
+/// \li 6 channels (5.1): front left, front right, center, LFE, rear left, rear right
+/// \li 7 channels (6.1): front left, front right, center, LFE, rear center, side left, side right
+/// \li 8 channels (7.1): front left, front right, center, LFE, rear left, rear right, side left, side right
+///
+/// Mono is copied to both sides of stereo, and surround
+/// formats are mixed down to stereo or mono with the usual
+/// gains (the LFE channel is dropped). The other conversions
+/// go through stereo.
+///
+/// Usage example:
+/// \code
+/// // Convert recorded samples to 48 kHz stereo as they arrive
+/// sf::Resampler resampler(recorder.getSampleRate(), 1, 48000, 2);
+///
+/// std::vector<sf::Int16> converted;
+/// sf::Int16 block[1024];
+/// while (recording)
+/// {
+///     std::size_t count = recorder.readSamples(block, 1024);
+///     resampler.process(block, count, converted);
+/// }
+/// resampler.flush(converted);
+/// \endcode
+///
+/// \see sf::SoundBuffer
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,51 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2023 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SAMPLEFORMAT_HPP
+#define SFML_SAMPLEFORMAT_HPP
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \ingroup audio
+/// \brief Types of audio samples handled by the audio module
+///
+/// 16-bit integer samples are the default everywhere. 32-bit
+/// float samples avoid quantization and conversion passes for
+/// applications which process the audio themselves; they are
+/// played natively when the AL_EXT_float32 extension is
+/// available, and converted to 16-bit integers otherwise.
+///
+////////////////////////////////////////////////////////////
+enum SampleFormat
+{
+    Int16Samples,  //!< 16-bit signed integer samples
+    Float32Samples //!< 32-bit floating point samples, normalized in [-1, 1]
+};
+
+} // namespace sf
+
+
+#endif // SFML_SAMPLEFORMAT_HPP
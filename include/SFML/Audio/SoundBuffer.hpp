@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/Export.hpp>
 #include <SFML/Audio/AlResource.hpp>
+#include <SFML/Audio/SampleFormat.hpp>
 #include <SFML/System/Time.hpp>
 #include <string>
 #include <vector>
@@ -39,9 +40,15 @@
 namespace sf
 {
 class Sound;
+class VoiceManager;
 class InputSoundFile;
 class InputStream;
 
+namespace priv
+{
+    struct DecodeJob;
+}
+
 ////////////////////////////////////////////////////////////
 /// \brief Storage for audio samples defining a sound
 ///
@@ -50,6 +57,18 @@ class SFML_AUDIO_API SoundBuffer : AlResource
 {
 public:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief What a sound buffer keeps in memory once its
+    ///        samples are uploaded to the audio device
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Residency
+    {
+        KeepSamples,    //!< Keep a copy of the samples (default)
+        KeepEncoded,    //!< Keep the encoded file data only, and decode it again when the samples are needed
+        ReleaseSamples  //!< Keep nothing, and read the samples back from the audio device when they are needed
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -116,11 +135,78 @@ public:
     ////////////////////////////////////////////////////////////
     bool loadFromStream(InputStream& stream);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Start loading the sound buffer from a file in the background
+    ///
+    /// The file is decoded by a pool of worker threads, with
+    /// one worker per processor, and this function returns
+    /// immediately. The sound buffer acts as the future of the
+    /// operation: call finishLoading() to wait for the decoding
+    /// if needed and actually fill the buffer. The samples are
+    /// decoded in the sample format that the buffer has when
+    /// this function is called.
+    ///
+    /// Any other load replaces a pending background load.
+    ///
+    /// \param filename Path of the sound file to load
+    ///
+    /// \see loadFromFilesAsync, isLoadFinished, finishLoading
+    ///
+    ////////////////////////////////////////////////////////////
+    void loadFromFileAsync(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start loading several sound buffers from files in the background
+    ///
+    /// \a buffers is resized to the number of files, and each
+    /// of its elements starts loading the corresponding file as
+    /// with loadFromFileAsync(). Files are decoded in parallel;
+    /// \a buffers must not be resized until finishLoading()
+    /// has been called on its elements.
+    ///
+    /// \param filenames Paths of the sound files to load
+    /// \param buffers   Sound buffers to fill
+    ///
+    /// \see loadFromFileAsync, finishLoading
+    ///
+    ////////////////////////////////////////////////////////////
+    static void loadFromFilesAsync(const std::vector<std::string>& filenames, std::vector<SoundBuffer>& buffers);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the background load is finished
+    ///
+    /// When this function returns true, finishLoading() doesn't
+    /// block. It also returns true if there's no background
+    /// load pending.
+    ///
+    /// \return True if finishLoading() can be called without blocking
+    ///
+    /// \see loadFromFileAsync, finishLoading
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isLoadFinished() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Complete the background load
+    ///
+    /// This function waits until the file is decoded, and fills
+    /// the buffer with its samples. The upload to the audio
+    /// device is done by the calling thread.
+    ///
+    /// \return True if loading succeeded, false if it failed or
+    ///         if there was no background load pending
+    ///
+    /// \see loadFromFileAsync, isLoadFinished
+    ///
+    ////////////////////////////////////////////////////////////
+    bool finishLoading();
+
     ////////////////////////////////////////////////////////////
     /// \brief Load the sound buffer from an array of audio samples
     ///
     /// The assumed format of the audio samples is 16 bits signed integer
-    /// (sf::Int16).
+    /// (sf::Int16). The sample format of the buffer becomes
+    /// sf::Int16Samples.
     ///
     /// \param samples      Pointer to the array of samples in memory
     /// \param sampleCount  Number of samples in the array
@@ -134,6 +220,24 @@ public:
     ////////////////////////////////////////////////////////////
     bool loadFromSamples(const Int16* samples, Uint64 sampleCount, unsigned int channelCount, unsigned int sampleRate);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the sound buffer from an array of float audio samples
+    ///
+    /// The samples are normalized floats in the range [-1, 1].
+    /// The sample format of the buffer becomes sf::Float32Samples.
+    ///
+    /// \param samples      Pointer to the array of samples in memory
+    /// \param sampleCount  Number of samples in the array
+    /// \param channelCount Number of channels (1 = mono, 2 = stereo, ...)
+    /// \param sampleRate   Sample rate (number of samples to play per second)
+    ///
+    /// \return True if loading succeeded, false if it failed
+    ///
+    /// \see loadFromFile, loadFromMemory, saveToFile
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromSamples(const float* samples, Uint64 sampleCount, unsigned int channelCount, unsigned int sampleRate);
+
     ////////////////////////////////////////////////////////////
     /// \brief Save the sound buffer to an audio file
     ///
@@ -155,14 +259,60 @@ public:
     /// The format of the returned samples is 16 bits signed integer
     /// (sf::Int16). The total number of samples in this array
     /// is given by the getSampleCount() function.
+    /// This function returns a null pointer if the sample format
+    /// of the buffer is sf::Float32Samples, or if the samples were
+    /// released (see setResidency).
     ///
     /// \return Read-only pointer to the array of sound samples
     ///
-    /// \see getSampleCount
+    /// \see getSampleCount, getFloatSamples
     ///
     ////////////////////////////////////////////////////////////
     const Int16* getSamples() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the array of float audio samples stored in the buffer
+    ///
+    /// The total number of samples in this array is given by
+    /// the getSampleCount() function.
+    /// This function returns a null pointer if the sample format
+    /// of the buffer is sf::Int16Samples, or if the samples were
+    /// released (see setResidency).
+    ///
+    /// \return Read-only pointer to the array of sound samples
+    ///
+    /// \see getSampleCount, getSamples
+    ///
+    ////////////////////////////////////////////////////////////
+    const float* getFloatSamples() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the format of the samples stored in the buffer
+    ///
+    /// The current samples, if any, are converted to the new
+    /// format. Sounds loaded afterwards from files, memory or
+    /// streams are decoded directly to this format.
+    /// Float samples are played natively when the device supports
+    /// the AL_EXT_float32 extension.
+    /// The default sample format is sf::Int16Samples.
+    ///
+    /// \param sampleFormat New sample format
+    ///
+    /// \see getSampleFormat
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSampleFormat(SampleFormat sampleFormat);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the format of the samples stored in the buffer
+    ///
+    /// \return Sample format
+    ///
+    /// \see setSampleFormat
+    ///
+    ////////////////////////////////////////////////////////////
+    SampleFormat getSampleFormat() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the number of samples stored in the buffer
     ///
@@ -213,6 +363,121 @@ public:
     ////////////////////////////////////////////////////////////
     Time getDuration() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable the persistent cache of decoded samples
+    ///
+    /// Decoding compressed formats such as OGG, FLAC or MP3
+    /// can take a significant time. When a cache directory is
+    /// set, loadFromFile, loadFromMemory and loadFromStream store
+    /// the decoded samples in this directory, and later loads of
+    /// the same file contents read them back instead of decoding
+    /// the file again.
+    ///
+    /// Entries are identified by a hash of the file contents,
+    /// so modified files are decoded again automatically.
+    /// The directory must exist and be writable; the cache is
+    /// disabled by default.
+    ///
+    /// \param directory Path of the cache directory, or an empty
+    ///                  string to disable the cache
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setCacheDirectory(const std::string& directory);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Choose what the buffer keeps in memory once its
+    ///        samples are uploaded to the audio device
+    ///
+    /// By default, a sound buffer keeps a copy of its samples,
+    /// so the sound is stored twice: by the buffer and by the
+    /// audio device. With the other residencies, the copy is
+    /// released after each upload, and getSamples() and
+    /// getFloatSamples() return a null pointer.
+    ///
+    /// \li KeepEncoded keeps the data of the file loaded with
+    ///     loadFromFile, loadFromMemory or loadFromStream, which
+    ///     is usually much smaller than the samples; saveToFile,
+    ///     setSampleFormat and copies decode it again. Buffers
+    ///     loaded from samples keep their samples.
+    /// \li ReleaseSamples keeps nothing; saveToFile,
+    ///     setSampleFormat and copies read the samples back from
+    ///     the audio device, which requires the AL_SOFT_buffer_samples
+    ///     extension. Without it, they fail.
+    ///
+    /// Changing the residency of a loaded buffer applies it
+    /// immediately; switching back to KeepSamples restores the
+    /// copy of the samples when possible.
+    ///
+    /// \param residency What to keep in memory
+    ///
+    /// \see getResidency, getMemoryUsage
+    ///
+    ////////////////////////////////////////////////////////////
+    void setResidency(Residency residency);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get what the buffer keeps in memory once its
+    ///        samples are uploaded to the audio device
+    ///
+    /// \return Residency of the buffer
+    ///
+    /// \see setResidency
+    ///
+    ////////////////////////////////////////////////////////////
+    Residency getResidency() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the memory held by the buffer
+    ///
+    /// \param cpuBytes    Variable to fill with the number of bytes held in main memory (samples or encoded data)
+    /// \param deviceBytes Variable to fill with the number of bytes held by the audio device
+    ///
+    /// \see getTotalMemoryUsage, setResidency
+    ///
+    ////////////////////////////////////////////////////////////
+    void getMemoryUsage(Uint64& cpuBytes, Uint64& deviceBytes) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the memory held by all the sound buffers
+    ///
+    /// \param cpuBytes    Variable to fill with the number of bytes held in main memory (samples or encoded data)
+    /// \param deviceBytes Variable to fill with the number of bytes held by the audio device
+    ///
+    /// \see getMemoryUsage
+    ///
+    ////////////////////////////////////////////////////////////
+    static void getTotalMemoryUsage(Uint64& cpuBytes, Uint64& deviceBytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the conversion of the samples
+    ///        to the sample rate of the audio device
+    ///
+    /// OpenAL resamples the sounds whose sample rate differs
+    /// from the rate of the audio device every time they are
+    /// played. When this option is enabled, the samples are
+    /// converted once, when they are loaded (see sf::Resampler),
+    /// and getSampleRate() returns the rate of the device.
+    /// It applies to the sounds loaded afterwards.
+    /// The conversion is disabled by default.
+    ///
+    /// \param resampled True to convert the samples when they are loaded
+    ///
+    /// \see isResampled
+    ///
+    ////////////////////////////////////////////////////////////
+    void setResampled(bool resampled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the samples are converted to the
+    ///        sample rate of the audio device
+    ///
+    /// \return True if the samples are converted when they are loaded
+    ///
+    /// \see setResampled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isResampled() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Overload of assignment operator
     ///
@@ -226,6 +491,7 @@ public:
 private:
 
     friend class Sound;
+    friend class VoiceManager;
 
     ////////////////////////////////////////////////////////////
     /// \brief Initialize the internal state after loading a new sound
@@ -237,6 +503,72 @@ private:
     ////////////////////////////////////////////////////////////
     bool initialize(InputSoundFile& file);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Read all the samples of a file, without updating the internal buffer
+    ///
+    /// \param file Sound file providing access to the new loaded sound
+    ///
+    /// \return True if all the samples were read, false on failure
+    ///
+    ////////////////////////////////////////////////////////////
+    bool readSamples(InputSoundFile& file);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the sound buffer from a file in memory, using the cache
+    ///
+    /// \param data        Pointer to the file data in memory
+    /// \param sizeInBytes Size of the data to load, in bytes
+    ///
+    /// \return True if loading succeeded, false if it failed
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromCache(const void* data, std::size_t sizeInBytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the sound buffer from a file in memory, keeping
+    ///        its data if the residency requires it
+    ///
+    /// \param data        Pointer to the file data in memory
+    /// \param sizeInBytes Size of the data to load, in bytes
+    ///
+    /// \return True if loading succeeded, false if it failed
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromEncoded(const void* data, std::size_t sizeInBytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the copy of the samples, according to the residency
+    ///
+    ////////////////////////////////////////////////////////////
+    void applyResidency();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the samples, whether they are resident or not
+    ///
+    /// Only the array matching the sample format is filled.
+    ///
+    /// \param samples      Array to fill with the 16-bit samples
+    /// \param floatSamples Array to fill with the float samples
+    ///
+    /// \return True on success, false if the samples are not available
+    ///
+    ////////////////////////////////////////////////////////////
+    bool restoreSamples(std::vector<Int16>& samples, std::vector<float>& floatSamples) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the memory accounted to the buffer
+    ///
+    /// \param deviceBytes Number of bytes held by the audio device
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateMemoryUsage(Uint64 deviceBytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Cancel the pending background load, if any
+    ///
+    ////////////////////////////////////////////////////////////
+    void cancelLoading();
+
     ////////////////////////////////////////////////////////////
     /// \brief Update the internal buffer with the cached audio samples
     ///
@@ -264,18 +596,54 @@ private:
     ////////////////////////////////////////////////////////////
     void detachSound(Sound* sound) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a voice manager to the list of managers playing this buffer
+    ///
+    /// \param voiceManager Voice manager to attach
+    ///
+    ////////////////////////////////////////////////////////////
+    void attachVoiceManager(VoiceManager* voiceManager) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a voice manager from the list of managers playing this buffer
+    ///
+    /// \param voiceManager Voice manager to detach
+    ///
+    ////////////////////////////////////////////////////////////
+    void detachVoiceManager(VoiceManager* voiceManager) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop the voices playing this buffer
+    ///
+    /// Their audio sources must not use the buffer anymore when
+    /// it is refilled or destroyed.
+    ///
+    ////////////////////////////////////////////////////////////
+    void stopVoices();
+
     ////////////////////////////////////////////////////////////
     // Types
     ////////////////////////////////////////////////////////////
-    typedef std::set<Sound*> SoundList; //!< Set of unique sound instances
+    typedef std::set<Sound*>        SoundList;        //!< Set of unique sound instances
+    typedef std::set<VoiceManager*> VoiceManagerList; //!< Set of unique voice managers
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    unsigned int       m_buffer;   //!< OpenAL buffer identifier
-    std::vector<Int16> m_samples;  //!< Samples buffer
-    Time               m_duration; //!< Sound duration
-    mutable SoundList  m_sounds;   //!< List of sounds that are using this buffer
+    unsigned int             m_buffer;        //!< OpenAL buffer identifier
+    std::vector<Int16>       m_samples;       //!< Samples buffer
+    std::vector<float>       m_floatSamples;  //!< Samples buffer, for the Float32Samples format
+    SampleFormat             m_sampleFormat;  //!< Format of the samples
+    Uint64                   m_sampleCount;   //!< Number of samples, even when they are not resident
+    Time                     m_duration;      //!< Sound duration
+    mutable SoundList        m_sounds;        //!< List of sounds that are using this buffer
+    mutable VoiceManagerList m_voiceManagers; //!< List of voice managers playing this buffer
+    priv::DecodeJob*         m_loadJob;       //!< Pending background load
+    Residency                m_residency;     //!< What is kept in memory once the samples are uploaded
+    std::vector<char>        m_encoded;       //!< Encoded file data, for the KeepEncoded residency
+    Uint64                   m_cpuBytes;      //!< Main memory accounted to the buffer, in bytes
+    Uint64                   m_deviceBytes;   //!< Audio device memory accounted to the buffer, in bytes
+    bool                     m_resampled;     //!< Are the samples converted to the sample rate of the device?
 };
 
 } // namespace sf
@@ -31,6 +31,7 @@
 #include <SFML/Audio/Export.hpp>
 #include <SFML/Audio/SoundBuffer.hpp>
 #include <SFML/Audio/SoundRecorder.hpp>
+#include <deque>
 #include <vector>
 
 
@@ -45,6 +46,12 @@ class SFML_AUDIO_API SoundBufferRecorder : public SoundRecorder
 {
 public:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    SoundBufferRecorder();
+
     ////////////////////////////////////////////////////////////
     /// \brief destructor
     ///
@@ -96,8 +103,9 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    std::vector<Int16> m_samples; //!< Temporary sample buffer to hold the recorded data
-    SoundBuffer        m_buffer;  //!< Sound buffer that will contain the recorded data
+    std::deque<std::vector<Int16> > m_blocks;     //!< Fixed-size blocks holding the recorded data, reused between captures
+    std::size_t                     m_blockCount; //!< Number of blocks used by the current capture
+    SoundBuffer                     m_buffer;     //!< Sound buffer that will contain the recorded data
 };
 
 } // namespace sf
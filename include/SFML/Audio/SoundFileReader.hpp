@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/Export.hpp>
 #include <string>
+#include <vector>
 
 
 namespace sf
@@ -55,6 +56,19 @@ public:
         unsigned int sampleRate;   //!< Samples rate of the sound, in samples per second
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Entry of a seek table, mapping a position in the
+    ///        decoded samples to a position in the encoded data
+    ///
+    /// The exact meaning of the values is specific to each reader.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SeekPoint
+    {
+        Uint64 sampleOffset; //!< Position in the decoded samples
+        Uint64 byteOffset;   //!< Position in the encoded data, in bytes
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Virtual destructor
     ///
@@ -101,6 +115,55 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     virtual Uint64 read(Int16* samples, Uint64 maxCount) = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read audio samples from the open file, as normalized floats
+    ///
+    /// Readers whose codec produces floating point or high
+    /// resolution samples should override this function to
+    /// avoid quantizing them to 16 bits. The default
+    /// implementation reads 16-bit samples with read() and
+    /// converts them.
+    ///
+    /// \param samples  Pointer to the sample array to fill
+    /// \param maxCount Maximum number of samples to read
+    ///
+    /// \return Number of samples actually read (may be less than \a maxCount)
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Uint64 readFloat(float* samples, Uint64 maxCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the seek table of the open file
+    ///
+    /// Readers of formats which can't seek without scanning the
+    /// encoded data from the beginning should override this
+    /// function, as well as setSeekTable. The table is built if
+    /// needed, so that it can be stored alongside the file and
+    /// given back to setSeekTable the next time the file is
+    /// opened. The default implementation returns false.
+    ///
+    /// \param table Vector to fill with the seek table
+    ///
+    /// \return True if the reader provides a seek table
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool getSeekTable(std::vector<SeekPoint>& table);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Provide the seek table of the open file
+    ///
+    /// The table must have been returned by getSeekTable for
+    /// the same file. Readers check the table and ignore it if
+    /// it doesn't match the file. The default implementation
+    /// returns false.
+    ///
+    /// \param table Seek table of the file
+    ///
+    /// \return True if the table is used by the reader
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool setSeekTable(const std::vector<SeekPoint>& table);
 };
 
 } // namespace sf
@@ -117,9 +180,12 @@ public:
 /// supported by SFML, and thus extend the set of supported readable
 /// audio formats.
 ///
-/// A valid sound file reader must override the open, seek and write functions,
+/// A valid sound file reader must override the open, seek and read functions,
 /// as well as providing a static check function; the latter is used by
 /// SFML to find a suitable writer for a given input file.
+/// Readers may also override readFloat to provide floating point
+/// samples without going through 16-bit integers, and
+/// getSeekTable/setSeekTable if seeking requires scanning the file.
 ///
 /// To register a new reader, use the sf::SoundFileFactory::registerReader
 /// template function.
@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/Export.hpp>
 #include <SFML/Audio/AlResource.hpp>
+#include <SFML/System/Mutex.hpp>
 #include <SFML/System/Thread.hpp>
 #include <SFML/System/Time.hpp>
 #include <vector>
@@ -38,6 +39,11 @@
 
 namespace sf
 {
+namespace priv
+{
+    template <typename T> class RingBuffer;
+}
+
 ////////////////////////////////////////////////////////////
 /// \brief Abstract base class for capturing sound data
 ///
@@ -185,6 +191,110 @@ public:
     ////////////////////////////////////////////////////////////
     static bool isAvailable();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the buffered capture mode
+    ///
+    /// In buffered mode, the capture thread writes the captured
+    /// samples into a ring buffer allocated when the capture
+    /// starts, and onProcessSamples is never called. Consumers
+    /// pull the samples from their own thread with readSamples
+    /// or readFrame, so that a slow consumer never delays the
+    /// capture. If the consumer doesn't keep up and the ring
+    /// buffer is full, the new samples are dropped and counted
+    /// (see getOverrunCount).
+    ///
+    /// Only one thread may read the samples at a time.
+    /// The buffered mode can't be changed while recording.
+    /// A duration of zero disables it, which is the default.
+    ///
+    /// \param duration Duration of audio that the ring buffer can hold
+    ///
+    /// \see getRingBufferDuration, readSamples, readFrame
+    ///
+    ////////////////////////////////////////////////////////////
+    void setRingBufferDuration(Time duration);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the duration of audio that the ring buffer can hold
+    ///
+    /// \return Duration of the ring buffer, zero if the buffered mode is disabled
+    ///
+    /// \see setRingBufferDuration
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getRingBufferDuration() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read captured samples from the ring buffer
+    ///
+    /// This function never blocks: it returns the samples
+    /// captured so far, up to \a maxCount, rounded down to a
+    /// whole number of frames (one sample per channel).
+    /// It only applies to the buffered mode.
+    ///
+    /// \param samples  Array to fill with the samples
+    /// \param maxCount Maximum number of samples to read
+    ///
+    /// \return Number of samples actually read
+    ///
+    /// \see readFrame, getAvailableSampleCount
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t readSamples(Int16* samples, std::size_t maxCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read a fixed number of captured samples from the ring buffer
+    ///
+    /// This function never blocks: it reads nothing unless at
+    /// least \a sampleCount samples are available, which makes
+    /// it convenient to feed encoders working on fixed-size
+    /// frames. \a sampleCount must be a multiple of the
+    /// channel count. It only applies to the buffered mode.
+    ///
+    /// \param samples     Array to fill with the samples
+    /// \param sampleCount Number of samples to read
+    ///
+    /// \return True if the samples were read, false if not enough samples are
+    ///         available yet or \a sampleCount is not a whole number of frames
+    ///
+    /// \see readSamples, getAvailableSampleCount
+    ///
+    ////////////////////////////////////////////////////////////
+    bool readFrame(Int16* samples, std::size_t sampleCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of captured samples waiting in the ring buffer
+    ///
+    /// \return Number of samples available for reading
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getAvailableSampleCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of ring buffer overruns
+    ///
+    /// An overrun happens when the capture thread finds the
+    /// ring buffer full, because the consumer doesn't read the
+    /// samples fast enough. The counters are reset when the
+    /// capture starts.
+    ///
+    /// \return Number of overruns since the capture started
+    ///
+    /// \see getDroppedSampleCount
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getOverrunCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of captured samples dropped by overruns
+    ///
+    /// \return Number of samples dropped since the capture started
+    ///
+    /// \see getOverrunCount
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getDroppedSampleCount() const;
+
 protected:
 
     ////////////////////////////////////////////////////////////
@@ -285,13 +395,18 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Thread             m_thread;             //!< Thread running the background recording task
-    std::vector<Int16> m_samples;            //!< Buffer to store captured samples
-    unsigned int       m_sampleRate;         //!< Sample rate
-    Time               m_processingInterval; //!< Time period between calls to onProcessSamples
-    bool               m_isCapturing;        //!< Capturing state
-    std::string        m_deviceName;         //!< Name of the audio capture device
-    unsigned int       m_channelCount;       //!< Number of recording channels
+    Thread                   m_thread;             //!< Thread running the background recording task
+    std::vector<Int16>       m_samples;            //!< Buffer to store captured samples
+    unsigned int             m_sampleRate;         //!< Sample rate
+    Time                     m_processingInterval; //!< Time period between calls to onProcessSamples
+    bool                     m_isCapturing;        //!< Capturing state
+    std::string              m_deviceName;         //!< Name of the audio capture device
+    unsigned int             m_channelCount;       //!< Number of recording channels
+    priv::RingBuffer<Int16>* m_ring;               //!< Ring buffer receiving the captured samples in buffered mode
+    Time                     m_ringDuration;       //!< Duration of the ring buffer, zero if the buffered mode is disabled
+    Uint64                   m_overrunCount;       //!< Number of times the ring buffer was found full
+    Uint64                   m_droppedSampleCount; //!< Number of samples dropped because the ring buffer was full
+    mutable Mutex            m_overrunMutex;       //!< Mutex protecting the overrun counters
 };
 
 } // namespace sf
@@ -344,6 +459,13 @@ private:
 /// have to decide whether you want to record in mono or stereo
 /// before starting the recording.
 ///
+/// When the processing of the samples is slow (encoding them,
+/// sending them over the network, ...), the buffered mode
+/// (see setRingBufferDuration) decouples it from the capture:
+/// the capture thread only stores the samples into a ring
+/// buffer, and a thread of your own pulls them with readFrame
+/// or readSamples, at its own pace.
+///
 /// It is important to note that the audio capture happens in a
 /// separate thread, so that it doesn't block the rest of the
 /// program. In particular, the onProcessSamples virtual function
@@ -31,6 +31,7 @@
 #include <SFML/Audio/Export.hpp>
 #include <SFML/Audio/AlResource.hpp>
 #include <SFML/System/Vector3.hpp>
+#include <cstddef>
 
 
 namespace sf
@@ -127,6 +128,22 @@ public:
     ////////////////////////////////////////////////////////////
     void setPosition(const Vector3f& position);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the 3D positions of many sounds at once
+    ///
+    /// The new positions are applied together, in a single
+    /// batch of updates (see sf::Listener::beginUpdate), so that
+    /// all the sounds move at the same time.
+    ///
+    /// \param sources   Sounds to move
+    /// \param positions New positions of the sounds, one per sound
+    /// \param count     Number of sounds
+    ///
+    /// \see setPosition
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setPositions(SoundSource* const* sources, const Vector3f* positions, std::size_t count);
+
     ////////////////////////////////////////////////////////////
     /// \brief Make the sound's position relative to the listener or absolute
     ///
@@ -30,14 +30,20 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/Export.hpp>
 #include <SFML/Audio/SoundSource.hpp>
-#include <SFML/System/Thread.hpp>
+#include <SFML/Audio/SampleFormat.hpp>
 #include <SFML/System/Time.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <cstdlib>
+#include <vector>
 
 
 namespace sf
 {
+namespace priv
+{
+    class SoundStreamScheduler;
+}
+
 ////////////////////////////////////////////////////////////
 /// \brief Abstract base class for streamed audio sources
 ///
@@ -52,8 +58,9 @@ public:
     ////////////////////////////////////////////////////////////
     struct Chunk
     {
-        const Int16* samples;     //!< Pointer to the audio samples
-        std::size_t  sampleCount; //!< Number of samples pointed by Samples
+        const Int16* samples;      //!< Pointer to the audio samples
+        std::size_t  sampleCount;  //!< Number of samples pointed by Samples
+        const float* floatSamples; //!< Pointer to the audio samples, for streams in the Float32Samples format
     };
 
     ////////////////////////////////////////////////////////////
@@ -68,8 +75,9 @@ public:
     /// This function starts the stream if it was stopped, resumes
     /// it if it was paused, and restarts it from the beginning if
     /// it was already playing.
-    /// This function uses its own thread so that it doesn't block
-    /// the rest of the program while the stream is played.
+    /// The stream is fed by a streaming thread shared by all the
+    /// streams so that it doesn't block the rest of the program
+    /// while the stream is played.
     ///
     /// \see pause, stop
     ///
@@ -120,6 +128,14 @@ public:
     ////////////////////////////////////////////////////////////
     unsigned int getSampleRate() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the format of the samples provided by the stream
+    ///
+    /// \return Sample format
+    ///
+    ////////////////////////////////////////////////////////////
+    SampleFormat getSampleFormat() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the current status of the stream (stopped, paused, playing)
     ///
@@ -178,11 +194,94 @@ public:
     ////////////////////////////////////////////////////////////
     bool getLoop() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of audio buffers queued by the stream
+    ///
+    /// More buffers make the stream more robust against late
+    /// refills, fewer buffers reduce the latency. The value is
+    /// clamped to the range [2, MaxBufferCount], and takes effect
+    /// the next time the stream is started.
+    /// The default buffer count is 3.
+    ///
+    /// \param count Number of audio buffers
+    ///
+    /// \see getBufferCount, setChunkDuration
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBufferCount(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of audio buffers queued by the stream
+    ///
+    /// \return Number of audio buffers
+    ///
+    /// \see setBufferCount
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getBufferCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the preferred duration of the chunks of audio data
+    ///
+    /// This is the amount of audio that derived classes should
+    /// provide in each call to onGetData; sf::Music honours it,
+    /// custom streams may query it with getChunkDuration().
+    /// The total latency of the stream is roughly the chunk
+    /// duration multiplied by the buffer count.
+    /// The duration is clamped to at least 1 millisecond.
+    /// The default chunk duration is 1 second.
+    ///
+    /// \param duration Preferred duration of a chunk
+    ///
+    /// \see getChunkDuration, setBufferCount
+    ///
+    ////////////////////////////////////////////////////////////
+    void setChunkDuration(Time duration);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the preferred duration of the chunks of audio data
+    ///
+    /// \return Preferred duration of a chunk
+    ///
+    /// \see setChunkDuration
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getChunkDuration() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the low-latency streaming preset
+    ///
+    /// The low-latency preset uses 4 buffers of 10 ms chunks
+    /// and refills them every 5 ms. Disabling it restores the
+    /// default settings (3 buffers of 1 second chunks, refilled
+    /// every 10 ms).
+    /// This function overrides the values set with setBufferCount,
+    /// setChunkDuration and setProcessingInterval.
+    ///
+    /// \param lowLatency True to enable the low-latency preset, false to restore the defaults
+    ///
+    ////////////////////////////////////////////////////////////
+    void setLowLatency(bool lowLatency);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of buffer underruns of the stream
+    ///
+    /// An underrun happens when all the queued buffers have been
+    /// played before the stream could refill them, and results
+    /// in an audible gap. The counter is never reset, it can be
+    /// sampled periodically for monitoring.
+    ///
+    /// \return Number of underruns since the stream was created
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getUnderrunCount() const;
+
 protected:
 
     enum
     {
-        NoLoop = -1 //!< "Invalid" endSeeks value, telling us to continue uninterrupted
+        NoLoop = -1,        //!< "Invalid" endSeeks value, telling us to continue uninterrupted
+        MaxBufferCount = 16 //!< Maximum number of audio buffers used by the streaming loop
     };
 
     ////////////////////////////////////////////////////////////
@@ -203,11 +302,17 @@ protected:
     /// It can be called multiple times if the settings of the
     /// audio stream change, but only when the stream is stopped.
     ///
+    /// Streams in the sf::Float32Samples format provide their
+    /// data through the floatSamples member of the chunks. They
+    /// are played natively if the device supports float samples,
+    /// and converted to 16-bit samples otherwise.
+    ///
     /// \param channelCount Number of channels of the stream
     /// \param sampleRate   Sample rate, in samples per second
+    /// \param sampleFormat Format of the samples provided in onGetData
     ///
     ////////////////////////////////////////////////////////////
-    void initialize(unsigned int channelCount, unsigned int sampleRate);
+    void initialize(unsigned int channelCount, unsigned int sampleRate, SampleFormat sampleFormat = Int16Samples);
 
     ////////////////////////////////////////////////////////////
     /// \brief Request a new chunk of audio samples from the stream source
@@ -220,6 +325,8 @@ protected:
     /// If you return true (i.e. continue streaming) it is important that
     /// the returned array of samples is not empty; this would stop the stream
     /// due to an internal limitation.
+    /// The streaming thread is shared by all the streams, so this
+    /// function should return quickly.
     ///
     /// \param data Chunk of data to fill
     ///
@@ -267,14 +374,29 @@ protected:
 
 private:
 
+    friend class priv::SoundStreamScheduler;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Run one iteration of the streaming loop
+    ///
+    /// This function is called periodically by the streaming
+    /// thread. The first call creates the buffers and starts
+    /// the playback, the following ones refill the buffers
+    /// which have been consumed.
+    ///
+    /// \return True while the stream must be serviced, false when it is over
+    ///
+    ////////////////////////////////////////////////////////////
+    bool updateStream();
+
     ////////////////////////////////////////////////////////////
-    /// \brief Function called as the entry point of the thread
+    /// \brief Stop the playback and release the streaming buffers
     ///
-    /// This function starts the streaming loop, and returns
-    /// only when the sound is stopped.
+    /// This function is called when the stream is no longer
+    /// serviced by the streaming thread.
     ///
     ////////////////////////////////////////////////////////////
-    void streamData();
+    void endStreaming();
 
     ////////////////////////////////////////////////////////////
     /// \brief Fill a new buffer with audio samples, and append
@@ -284,7 +406,7 @@ private:
     /// consumed; it fills it again and inserts it back into the
     /// playing queue.
     ///
-    /// \param bufferNum Number of the buffer to fill (in [0, BufferCount])
+    /// \param bufferNum Number of the buffer to fill (in [0, m_activeBufferCount])
     /// \param immediateLoop Treat empty buffers as spent, and act on loops immediately
     ///
     /// \return True if the stream source has requested to stop, false otherwise
@@ -313,24 +435,33 @@ private:
 
     enum
     {
-        BufferCount = 3,    //!< Number of audio buffers used by the streaming loop
         BufferRetries = 2   //!< Number of retries (excluding initial try) for onGetData()
     };
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Thread        m_thread;                   //!< Thread running the background tasks
-    mutable Mutex m_threadMutex;              //!< Thread mutex
-    Status        m_threadStartState;         //!< State the thread starts in (Playing, Paused, Stopped)
+    mutable Mutex m_threadMutex;              //!< Mutex protecting the streaming state
+    Mutex         m_streamingMutex;           //!< Mutex held by the streaming thread while it services the stream
+    Status        m_threadStartState;         //!< State the stream starts in (Playing, Paused, Stopped)
     bool          m_isStreaming;              //!< Streaming state (true = playing, false = stopped)
-    unsigned int  m_buffers[BufferCount];     //!< Sound buffers used to store temporary audio data
+    bool          m_hasStarted;               //!< Whether the streaming buffers have been created and queued
+    bool          m_requestStop;              //!< Whether the stream source has requested to stop
+    std::size_t   m_schedulerSlot;            //!< Index of the stream in the streaming scheduler
+    unsigned int  m_buffers[MaxBufferCount];  //!< Sound buffers used to store temporary audio data
+    unsigned int  m_bufferCount;              //!< Number of buffers to use when the stream starts
+    unsigned int  m_activeBufferCount;        //!< Number of buffers used by the running stream
+    Time          m_chunkDuration;            //!< Preferred duration of the chunks returned by onGetData
+    Uint64        m_underrunCount;            //!< Number of times the queue ran dry while streaming
     unsigned int  m_channelCount;             //!< Number of channels (1 = mono, 2 = stereo, ...)
     unsigned int  m_sampleRate;               //!< Frequency (samples / second)
     Int32         m_format;                   //!< Format of the internal sound buffers
+    SampleFormat  m_sampleFormat;             //!< Format of the samples provided by the stream source
+    bool          m_convertSamples;           //!< Whether float samples must be converted to 16 bits before being queued
+    std::vector<Int16> m_convertedSamples;    //!< Float samples converted for devices which can't play them
     bool          m_loop;                     //!< Loop flag (true to loop, false to play once)
     Uint64        m_samplesProcessed;         //!< Number of samples processed since beginning of the stream
-    Int64         m_bufferSeeks[BufferCount]; //!< If buffer is an "end buffer", holds next seek position, else NoLoop. For play offset calculation.
+    Int64         m_bufferSeeks[MaxBufferCount]; //!< If buffer is an "end buffer", holds next seek position, else NoLoop. For play offset calculation.
     Time          m_processingInterval;       //!< Interval for checking and filling the internal sound buffers.
 };
 
@@ -365,10 +496,11 @@ private:
 /// \li onGetData fills a new chunk of audio data to be played
 /// \li onSeek changes the current playing position in the source
 ///
-/// It is important to note that each SoundStream is played in its
-/// own separate thread, so that the streaming loop doesn't block the
-/// rest of the program. In particular, the OnGetData and OnSeek
-/// virtual functions may sometimes be called from this separate thread.
+/// It is important to note that SoundStreams are fed by a separate
+/// streaming thread, shared by all the streams, so that the streaming
+/// loop doesn't block the rest of the program. In particular, the
+/// OnGetData and OnSeek virtual functions may sometimes be called
+/// from this separate thread.
 /// It is important to keep this in mind, because you may have to take
 /// care of synchronization issues if you share data between threads.
 ///
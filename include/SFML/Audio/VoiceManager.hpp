@@ -0,0 +1,431 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2023 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_VOICEMANAGER_HPP
+#define SFML_VOICEMANAGER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/Audio/AlResource.hpp>
+#include <SFML/Config.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <SFML/System/Vector3.hpp>
+#include <map>
+#include <vector>
+
+
+namespace sf
+{
+class SoundBuffer;
+
+////////////////////////////////////////////////////////////
+/// \brief Player of many short sounds sharing a fixed pool
+///        of audio sources
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API VoiceManager : AlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Identifier of a voice
+    ///
+    /// Identifiers are never reused, so the identifier of a
+    /// finished voice can safely be kept: the functions taking
+    /// it simply have no effect.
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef Uint64 VoiceId;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Constructor
+    ///
+    /// All the audio sources are created once and for all.
+    ///
+    /// \param sourceCount Number of audio sources in the pool
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit VoiceManager(unsigned int sourceCount = 32);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// All the voices are stopped.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~VoiceManager();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start playing a sound buffer
+    ///
+    /// If all the sources are in use, the least important voice
+    /// (lowest priority, then quietest) gives its source to the
+    /// new one, if the latter is more important; otherwise the
+    /// new voice starts virtual.
+    ///
+    /// The voice is stopped if the sound buffer is reloaded or
+    /// destroyed while it plays.
+    ///
+    /// \param buffer   Sound buffer to play
+    /// \param priority Priority of the voice, higher is more important
+    /// \param volume   Volume of the voice, in the range [0, 100]
+    ///
+    /// \return Identifier of the new voice
+    ///
+    ////////////////////////////////////////////////////////////
+    VoiceId play(const SoundBuffer& buffer, int priority = 0, float volume = 100.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop a voice
+    ///
+    /// \param voice Voice to stop
+    ///
+    ////////////////////////////////////////////////////////////
+    void stop(VoiceId voice);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop all the voices
+    ///
+    ////////////////////////////////////////////////////////////
+    void stopAll();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a voice is still playing
+    ///
+    /// Virtual voices are playing too.
+    ///
+    /// \param voice Voice to check
+    ///
+    /// \return True if the voice is playing
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isPlaying(VoiceId voice) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a voice is virtual
+    ///
+    /// A virtual voice has no audio source: it is silent, and
+    /// only its playing position is tracked.
+    ///
+    /// \param voice Voice to check
+    ///
+    /// \return True if the voice is playing without an audio source
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isVirtual(VoiceId voice) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the volume of a voice
+    ///
+    /// \param voice  Voice to modify
+    /// \param volume Volume of the voice, in the range [0, 100]
+    ///
+    ////////////////////////////////////////////////////////////
+    void setVolume(VoiceId voice, float volume);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the pitch of a voice
+    ///
+    /// \param voice Voice to modify
+    /// \param pitch New pitch to apply to the voice
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPitch(VoiceId voice, float pitch);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the 3D position of a voice in the audio scene
+    ///
+    /// The position is taken into account to estimate how
+    /// audible the voice is. The default position is (0, 0, 0).
+    ///
+    /// \param voice    Voice to modify
+    /// \param position Position of the voice in the scene
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPosition(VoiceId voice, const Vector3f& position);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make a voice's position relative to the listener or absolute
+    ///
+    /// \param voice    Voice to modify
+    /// \param relative True to set the position relative, false to set it absolute
+    ///
+    ////////////////////////////////////////////////////////////
+    void setRelativeToListener(VoiceId voice, bool relative);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set whether or not a voice should loop after reaching the end
+    ///
+    /// \param voice Voice to modify
+    /// \param loop  True to play in loop, false to play once
+    ///
+    ////////////////////////////////////////////////////////////
+    void setLoop(VoiceId voice, bool loop);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the minimum distance of all the voices
+    ///
+    /// See sf::SoundSource::setMinDistance. The default value
+    /// is 1.
+    ///
+    /// \param distance New minimum distance of the voices
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMinDistance(float distance);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the attenuation factor of all the voices
+    ///
+    /// See sf::SoundSource::setAttenuation. The default value
+    /// is 1.
+    ///
+    /// \param attenuation New attenuation factor of the voices
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAttenuation(float attenuation);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the audibility under which voices are virtual
+    ///
+    /// The audibility of a voice is its volume (in the range
+    /// [0, 1]) multiplied by its distance attenuation. Voices
+    /// less audible than the threshold never get a source.
+    /// The default value is 0.001 (-60 dB).
+    ///
+    /// \param threshold New audibility threshold
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAudibilityThreshold(float threshold);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the voices
+    ///
+    /// This function must be called regularly, typically once
+    /// per frame. It releases the finished voices, advances the
+    /// virtual ones, and gives the sources to the most important
+    /// voices: a virtual voice which gets a source resumes at
+    /// its tracked position.
+    ///
+    /// The virtual voices advance by \a elapsed, which must
+    /// follow the time of the audio device: the time of the
+    /// frame when it plays in real time, or the duration of the
+    /// rendered samples when it renders offline.
+    ///
+    /// \param elapsed Audio time elapsed since the last update
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(Time elapsed);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of audio sources in the pool
+    ///
+    /// \return Number of audio sources
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getSourceCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of playing voices
+    ///
+    /// \return Number of voices, including the virtual ones
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getVoiceCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of virtual voices
+    ///
+    /// \return Number of voices playing without an audio source
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getVirtualVoiceCount() const;
+
+private:
+
+    friend class SoundBuffer;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief State of a voice
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Voice
+    {
+        const SoundBuffer* buffer;   //!< Sound buffer played by the voice
+        int                priority; //!< Priority of the voice
+        float              volume;   //!< Volume, in the range [0, 100]
+        float              pitch;    //!< Pitch
+        Vector3f           position; //!< 3D position
+        bool               relative; //!< Is the position relative to the listener?
+        bool               loop;     //!< Does the voice loop?
+        unsigned int       source;   //!< Audio source of the voice, 0 if virtual
+        Time               offset;   //!< Playing position, tracked while virtual
+    };
+
+    typedef std::map<VoiceId, Voice>                 VoiceMap;
+    typedef std::map<const SoundBuffer*, unsigned int> BufferUseMap;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute how audible a voice is
+    ///
+    /// \param voice Voice to evaluate
+    ///
+    /// \return Volume of the voice, attenuated by its distance
+    ///
+    ////////////////////////////////////////////////////////////
+    float getAudibility(const Voice& voice) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a voice is less important than another
+    ///
+    /// \param left  First voice
+    /// \param right Second voice
+    ///
+    /// \return True if \a left is less important than \a right
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isLessImportant(const Voice& left, const Voice& right) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give a free source to a virtual voice and start it
+    ///
+    /// \param voice Voice to start
+    ///
+    ////////////////////////////////////////////////////////////
+    void realize(Voice& voice);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Take the source of a voice, keeping its position
+    ///
+    /// \param voice Voice to virtualize
+    ///
+    ////////////////////////////////////////////////////////////
+    void virtualize(Voice& voice);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop a voice and release its source
+    ///
+    /// \param voice Voice to release
+    ///
+    ////////////////////////////////////////////////////////////
+    void release(Voice& voice);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop a voice and forget it
+    ///
+    /// The manager is detached from the sound buffer of the
+    /// voice if no other voice plays it.
+    ///
+    /// \param voice Iterator to the voice to remove
+    ///
+    ////////////////////////////////////////////////////////////
+    void remove(VoiceMap::iterator voice);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop all the voices playing a sound buffer
+    ///
+    /// This function is called by the sound buffer before it is
+    /// refilled or destroyed.
+    ///
+    /// \param buffer Sound buffer which is about to change
+    ///
+    ////////////////////////////////////////////////////////////
+    void stopVoices(const SoundBuffer& buffer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply the parameters of a voice to its source
+    ///
+    /// \param voice Voice to apply
+    ///
+    ////////////////////////////////////////////////////////////
+    void applyParameters(const Voice& voice);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<unsigned int> m_sources;     //!< All the audio sources of the pool
+    std::vector<unsigned int> m_freeSources; //!< Audio sources not used by any voice
+    VoiceMap                  m_voices;      //!< Playing voices
+    BufferUseMap              m_bufferUses;  //!< Number of voices playing each sound buffer
+    VoiceId                   m_nextId;      //!< Identifier of the next voice
+    float                     m_minDistance; //!< Minimum distance of the voices
+    float                     m_attenuation; //!< Attenuation factor of the voices
+    float                     m_threshold;   //!< Audibility under which voices are virtual
+};
+
+} // namespace sf
+
+
+#endif // SFML_VOICEMANAGER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::VoiceManager
+/// \ingroup audio
+///
+/// Each sf::Sound owns an audio source, and the audio device
+/// only supports a limited number of them (often 256). Creating
+/// and destroying sounds for every shot is also costly.
+///
+/// sf::VoiceManager plays sound buffers on a fixed pool of
+/// audio sources created once. Each playing sound is a voice,
+/// identified by a sf::VoiceManager::VoiceId. When there are
+/// more voices than sources, the most important voices play
+/// for real; the other ones are virtual: they are silent, but
+/// their playing position keeps advancing, so that they resume
+/// at the right position when a source becomes available.
+/// Voices which are too quiet or too far away to be heard are
+/// virtual as well.
+///
+/// The importance of a voice is first its priority, then how
+/// audible it is.
+///
+/// Usage example:
+/// \code
+/// sf::SoundBuffer shot;
+/// shot.loadFromFile("shot.wav");
+///
+/// sf::VoiceManager voices(64);
+/// sf::Clock frameClock;
+///
+/// while (window.isOpen())
+/// {
+///     // Fire and forget
+///     if (playerFires)
+///     {
+///         sf::VoiceManager::VoiceId voice = voices.play(shot);
+///         voices.setPosition(voice, bulletPosition);
+///     }
+///
+///     // Once per frame
+///     voices.update(frameClock.restart());
+/// }
+/// \endcode
+///
+/// \see sf::Sound, sf::SoundBuffer
+///
+////////////////////////////////////////////////////////////
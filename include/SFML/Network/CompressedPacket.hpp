@@ -0,0 +1,218 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2023 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_COMPRESSEDPACKET_HPP
+#define SFML_COMPRESSEDPACKET_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <SFML/System/Time.hpp>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Packet compressed with LZ4 over the network
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API CompressedPacket : public Packet
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    // Constants
+    ////////////////////////////////////////////////////////////
+    enum
+    {
+        DefaultThreshold = 128 //!< Default size below which packets are sent uncompressed, in bytes
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure defining the compression statistics of a packet
+    ///
+    /// The compression ratio is compressedSize / originalSize.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Statistics
+    {
+        Uint64 compressedCount;   //!< Number of times the packet was sent compressed
+        Uint64 storedCount;       //!< Number of times the packet was sent uncompressed, because it was small or incompressible
+        Uint64 originalSize;      //!< Total size of the data that was compressed, in bytes
+        Uint64 compressedSize;    //!< Total size of the data after compression, in bytes
+        Time   compressionTime;   //!< Total time spent compressing
+        Time   decompressionTime; //!< Total time spent decompressing
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty packet.
+    ///
+    ////////////////////////////////////////////////////////////
+    CompressedPacket();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct an empty packet whose storage comes from a pool
+    ///
+    /// \param pool Pool providing the storage of the packet
+    ///
+    /// \see Packet::Packet(PacketPool&)
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit CompressedPacket(PacketPool& pool);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the size below which the packet is sent uncompressed
+    ///
+    /// Compressing small packets costs more time than it
+    /// saves bandwidth, and rarely makes them smaller.
+    /// The default threshold is DefaultThreshold.
+    ///
+    /// \param threshold Smallest size of the packets to compress, in bytes
+    ///
+    /// \see getThreshold
+    ///
+    ////////////////////////////////////////////////////////////
+    void setThreshold(std::size_t threshold);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size below which the packet is sent uncompressed
+    ///
+    /// \return Smallest size of the packets to compress, in bytes
+    ///
+    /// \see setThreshold
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getThreshold() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the compression statistics of the packet
+    ///
+    /// The statistics accumulate over all the sends and
+    /// receives of the packet, until they are reset.
+    ///
+    /// \return Compression statistics
+    ///
+    /// \see resetStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    const Statistics& getStatistics() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the compression statistics of the packet
+    ///
+    /// \see getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    void resetStatistics();
+
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compress the data of the packet before it is sent
+    ///
+    /// When a partial send is resumed, the data compressed for
+    /// the first attempt is returned again, and isn't counted
+    /// twice in the statistics.
+    ///
+    /// \param size Variable to fill with the size of data to send
+    ///
+    /// \return Pointer to the array of bytes to send
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual const void* onSend(std::size_t& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decompress the data of the packet after it is received
+    ///
+    /// If the data is corrupted, the packet is left empty
+    /// and invalid.
+    ///
+    /// \param data Pointer to the received bytes
+    /// \param size Number of bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onReceive(const void* data, std::size_t size);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::size_t       m_threshold;  //!< Size below which the packet is sent uncompressed
+    std::vector<char> m_buffer;     //!< Data sent by the last call to onSend, reused from one send to the next
+    std::size_t       m_sentSize;   //!< Size of the data in m_buffer
+    Statistics        m_statistics; //!< Compression statistics
+};
+
+} // namespace sf
+
+
+#endif // SFML_COMPRESSEDPACKET_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::CompressedPacket
+/// \ingroup network
+///
+/// sf::CompressedPacket is a sf::Packet whose data is
+/// compressed when it is sent, and decompressed when it is
+/// received: it is used exactly like sf::Packet, and must be
+/// received into a sf::CompressedPacket as well.
+///
+/// The data is compressed in the LZ4 block format, which is
+/// fast enough to save bandwidth without adding noticeable
+/// latency; it works best on repetitive data such as text or
+/// serialized game states, and doesn't help with data that is
+/// already compressed or random. Packets smaller than the
+/// threshold (see setThreshold), and packets whose data
+/// doesn't get smaller, are sent uncompressed with a single
+/// byte of overhead.
+///
+/// The compressed data is kept in a buffer owned by the
+/// packet, and the state of the compressor is shared between
+/// the packets, so that a packet which is reused doesn't
+/// allocate memory in steady state. Decompressed data is
+/// written directly into the packet.
+///
+/// Usage example:
+/// \code
+/// sf::CompressedPacket packet;
+/// packet << worldState;
+/// socket.send(packet);
+///
+/// ...
+///
+/// const sf::CompressedPacket::Statistics& statistics = packet.getStatistics();
+/// std::cout << "Sent " << statistics.compressedSize << " bytes instead of " << statistics.originalSize << std::endl;
+/// \endcode
+///
+/// \see sf::Packet
+///
+////////////////////////////////////////////////////////////
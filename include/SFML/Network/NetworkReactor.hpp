@@ -0,0 +1,390 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2023 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_NETWORKREACTOR_HPP
+#define SFML_NETWORKREACTOR_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/Network/PacketPool.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <map>
+#include <vector>
+
+
+namespace sf
+{
+class IpAddress;
+class Packet;
+class Socket;
+class TcpListener;
+class TcpSocket;
+class UdpSocket;
+
+////////////////////////////////////////////////////////////
+/// \brief Event loop which handles many sockets on one or
+///        more threads, and notifies completed operations
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API NetworkReactor : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Sockets are distributed among the threads when they are
+    /// added, and all the handlers of a socket are then called
+    /// from the same thread.
+    ///
+    /// \param threadCount Number of threads which run the loop
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit NetworkReactor(unsigned int threadCount = 1);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The reactor must not be running when it is destroyed.
+    /// The sockets accepted by the reactor are destroyed with it.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~NetworkReactor();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of threads which run the loop
+    ///
+    /// \return Number of threads
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getThreadCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a listener to the reactor
+    ///
+    /// The connections accepted by the listener are owned by
+    /// the reactor, and notified with onAccept.
+    /// This function keeps a weak reference to the listener,
+    /// which must be listening, and alive until it is removed
+    /// and the reactor is stopped.
+    /// This function can be called from any thread.
+    ///
+    /// \param listener Listener to add
+    ///
+    /// \return True if the listener was added, false otherwise
+    ///
+    /// \see remove
+    ///
+    ////////////////////////////////////////////////////////////
+    bool add(TcpListener& listener);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a connected TCP socket to the reactor
+    ///
+    /// The socket is made non-blocking, its packets are
+    /// notified with onReceive, and its disconnection with
+    /// onDisconnect, after which the reactor doesn't reference
+    /// it anymore.
+    /// This function can be called from any thread.
+    ///
+    /// \param socket Socket to add
+    ///
+    /// \return True if the socket was added, false otherwise
+    ///
+    /// \see remove, send
+    ///
+    ////////////////////////////////////////////////////////////
+    bool add(TcpSocket& socket);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a bound UDP socket to the reactor
+    ///
+    /// The socket is made non-blocking, and its packets are
+    /// notified with onReceiveFrom. Packets are sent directly
+    /// with the socket.
+    /// This function keeps a weak reference to the socket,
+    /// which must be alive until it is removed and the
+    /// reactor is stopped.
+    /// This function can be called from any thread.
+    ///
+    /// \param socket Socket to add
+    ///
+    /// \return True if the socket was added, false otherwise
+    ///
+    /// \see remove
+    ///
+    ////////////////////////////////////////////////////////////
+    bool add(UdpSocket& socket);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a socket from the reactor
+    ///
+    /// While the reactor runs, the socket is removed by its
+    /// thread before it waits again. TCP sockets are then
+    /// notified with onDisconnect, and the sockets accepted
+    /// by the reactor are destroyed.
+    /// This function can be called from any thread.
+    ///
+    /// \param socket Socket to remove
+    ///
+    /// \see add
+    ///
+    ////////////////////////////////////////////////////////////
+    void remove(Socket& socket);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue a packet to send with a TCP socket of the reactor
+    ///
+    /// The data of the packet, as returned by its onSend
+    /// function, is copied, and sent by the thread of the
+    /// socket along with the other queued packets, in as few
+    /// system calls as possible. Once all the queued packets
+    /// are sent, the socket is notified with onSent.
+    /// This function can be called from any thread.
+    ///
+    /// \param socket Socket to send the packet with
+    /// \param packet Packet to send
+    ///
+    /// \return True if the packet was queued, false if the socket is not in the reactor
+    ///
+    ////////////////////////////////////////////////////////////
+    bool send(TcpSocket& socket, Packet& packet);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Run the loop until stop is called
+    ///
+    /// The calling thread runs the loop of the first thread,
+    /// the other ones are launched by this function, which
+    /// returns when they are all finished.
+    ///
+    /// \see stop
+    ///
+    ////////////////////////////////////////////////////////////
+    void run();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make the loop return as soon as possible
+    ///
+    /// This function can be called from any thread, including
+    /// from the handlers.
+    ///
+    /// \see run
+    ///
+    ////////////////////////////////////////////////////////////
+    void stop();
+
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Called when a listener has accepted a new connection
+    ///
+    /// This function is called from the thread which handles
+    /// the new socket, before any of its other handlers.
+    ///
+    /// \param listener Listener which accepted the connection
+    /// \param socket   New connected socket, owned by the reactor
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onAccept(TcpListener& listener, TcpSocket& socket);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Called when a TCP socket has received a packet
+    ///
+    /// \param socket Socket which received the packet
+    /// \param packet Packet received, only valid during the call
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onReceive(TcpSocket& socket, Packet& packet);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Called when a UDP socket has received a packet
+    ///
+    /// \param socket Socket which received the packet
+    /// \param packet Packet received, only valid during the call
+    /// \param sender Address of the peer which sent the packet
+    /// \param port   Port of the peer which sent the packet
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onReceiveFrom(UdpSocket& socket, Packet& packet, const IpAddress& sender, unsigned short port);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Called when all the packets queued for a TCP socket are sent
+    ///
+    /// \param socket Socket whose packets are sent
+    ///
+    /// \see send
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onSent(TcpSocket& socket);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Called when a TCP socket leaves the reactor
+    ///
+    /// This happens when the peer disconnects, on errors, and
+    /// when the socket is removed. After this call the reactor
+    /// doesn't reference the socket anymore; if it was
+    /// accepted by the reactor, it is destroyed.
+    ///
+    /// \param socket Socket which left the reactor
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onDisconnect(TcpSocket& socket);
+
+private:
+
+    struct Connection;
+    struct Worker;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Register a new connection and hand it to a thread
+    ///
+    /// \param connection Connection to add, whose worker is chosen by this function
+    ///
+    /// \return True if the connection was added, false if its socket is already in the reactor
+    ///
+    ////////////////////////////////////////////////////////////
+    bool addConnection(Connection* connection);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Run the loop of a thread
+    ///
+    /// \param worker Thread to run
+    ///
+    ////////////////////////////////////////////////////////////
+    void process(Worker& worker);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Handle the commands posted to a thread
+    ///
+    /// \param worker Thread whose commands are handled
+    ///
+    /// \return False if the thread must stop, true otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    bool processCommands(Worker& worker);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Accept all the pending connections of a listener
+    ///
+    /// \param connection Connection of the listener
+    ///
+    ////////////////////////////////////////////////////////////
+    void accept(Connection& connection);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive the available packets of a socket
+    ///
+    /// \param connection Connection of the socket
+    ///
+    ////////////////////////////////////////////////////////////
+    void receive(Connection& connection);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send the packets queued for a TCP socket
+    ///
+    /// \param connection Connection of the socket
+    ///
+    ////////////////////////////////////////////////////////////
+    void flush(Connection& connection);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a connection from the reactor
+    ///
+    /// The connection is destroyed at the end of the
+    /// current iteration of its thread.
+    ///
+    /// \param connection Connection to close
+    ///
+    ////////////////////////////////////////////////////////////
+    void close(Connection& connection);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Worker*>           m_workers;     //!< Threads which run the loop
+    std::map<Socket*, Connection*> m_connections; //!< Connections of the reactor, by socket
+    unsigned int                   m_nextWorker;  //!< Thread which receives the next connection
+    Mutex                          m_mutex;       //!< Mutex protecting the connections
+    PacketPool                     m_pool;        //!< Storage of the queued packets
+};
+
+} // namespace sf
+
+
+#endif // SFML_NETWORKREACTOR_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::NetworkReactor
+/// \ingroup network
+///
+/// sf::NetworkReactor runs an event loop over a set of
+/// listeners, TCP sockets and UDP sockets, based on
+/// sf::SocketPoller. Instead of waiting for sockets to be
+/// ready, the application is notified when operations are
+/// complete, by overriding the handlers of the reactor:
+/// \li onAccept: a listener has accepted a new connection
+/// \li onReceive: a TCP socket has received a whole packet
+/// \li onReceiveFrom: a UDP socket has received a packet
+/// \li onSent: all the packets queued with send are sent
+/// \li onDisconnect: a TCP socket has left the reactor
+///
+/// The loop can run on several threads: each socket is
+/// assigned to one of them when it is added, and all its
+/// handlers are called from that thread, so the state of a
+/// connection doesn't need to be protected from concurrent
+/// accesses. The functions add, remove, send and stop can
+/// be called from any thread.
+///
+/// Usage example:
+/// \code
+/// class EchoServer : public sf::NetworkReactor
+/// {
+/// public:
+///
+///     EchoServer() : sf::NetworkReactor(4) {}
+///
+/// private:
+///
+///     virtual void onReceive(sf::TcpSocket& socket, sf::Packet& packet)
+///     {
+///         // Send back every packet received
+///         send(socket, packet);
+///     }
+/// };
+///
+/// sf::TcpListener listener;
+/// listener.listen(55001);
+///
+/// EchoServer server;
+/// server.add(listener);
+/// server.run();
+/// \endcode
+///
+/// \see sf::SocketPoller, sf::TcpSocket, sf::UdpSocket
+///
+////////////////////////////////////////////////////////////
@@ -35,7 +35,9 @@
 
 namespace sf
 {
+class PacketPool;
 class String;
+template <typename T> class Serializer;
 class TcpSocket;
 class UdpSocket;
 
@@ -59,12 +61,46 @@ public:
     ////////////////////////////////////////////////////////////
     Packet();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct an empty packet whose storage comes from a pool
+    ///
+    /// Data that doesn't fit in the packet itself is stored
+    /// in blocks of the pool, which must outlive the packet.
+    ///
+    /// \param pool Pool providing the storage of the packet
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit Packet(PacketPool& pool);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    ///
+    /// The new packet uses the same pool as \a copy, if any.
+    ///
+    /// \param copy Instance to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet(const Packet& copy);
+
     ////////////////////////////////////////////////////////////
     /// \brief Virtual destructor
     ///
     ////////////////////////////////////////////////////////////
     virtual ~Packet();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of assignment operator
+    ///
+    /// The data is copied in the storage of the packet, which
+    /// keeps its own pool.
+    ///
+    /// \param right Instance to assign
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& operator =(const Packet& right);
+
     ////////////////////////////////////////////////////////////
     /// \brief Append data to the end of the packet
     ///
@@ -93,12 +129,50 @@ public:
     /// \brief Clear the packet
     ///
     /// After calling Clear, the packet is empty.
+    /// Its storage is kept, so that the packet can be filled
+    /// again without allocating memory.
     ///
-    /// \see append
+    /// \see append, reset
     ///
     ////////////////////////////////////////////////////////////
     void clear();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the packet, to reuse it for a new message
+    ///
+    /// Like clear, this function empties the packet and keeps
+    /// its storage; it also drops the progress of a partial
+    /// send, so that the next send starts from the beginning
+    /// of the new data.
+    ///
+    /// \see clear, reserve
+    ///
+    ////////////////////////////////////////////////////////////
+    void reset();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reserve storage for the data of the packet
+    ///
+    /// After this call, appending data doesn't allocate memory
+    /// until the size of the packet exceeds \a size.
+    ///
+    /// \param size Number of bytes to reserve
+    ///
+    /// \see getCapacity
+    ///
+    ////////////////////////////////////////////////////////////
+    void reserve(std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of bytes the packet can store without allocating memory
+    ///
+    /// \return Capacity of the packet, in bytes
+    ///
+    /// \see reserve
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCapacity() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get a pointer to the data contained in the packet
     ///
@@ -347,6 +421,9 @@ public:
 
 protected:
 
+    friend class CompressedPacket;
+    friend class NetworkReactor;
+    template <typename T> friend class Serializer;
     friend class TcpSocket;
     friend class UdpSocket;
 
@@ -410,13 +487,41 @@ private:
     ////////////////////////////////////////////////////////////
     bool checkSize(std::size_t size);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Replace the storage of the packet with a larger one
+    ///
+    /// The data of the packet is preserved.
+    ///
+    /// \param capacity Minimum capacity of the new storage
+    ///
+    ////////////////////////////////////////////////////////////
+    void grow(std::size_t capacity);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the storage of the packet, if it's not inline
+    ///
+    ////////////////////////////////////////////////////////////
+    void release();
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    enum
+    {
+        InlineCapacity = 256 //!< Number of bytes stored inside the packet itself
+    };
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    std::vector<char> m_data;    //!< Data stored in the packet
-    std::size_t       m_readPos; //!< Current reading position in the packet
-    std::size_t       m_sendPos; //!< Current send position in the packet (for handling partial sends)
-    bool              m_isValid; //!< Reading state of the packet
+    char*       m_data;                   //!< Data stored in the packet (inline, in a block of the pool, or on the heap)
+    std::size_t m_size;                   //!< Number of bytes stored in the packet
+    std::size_t m_capacity;               //!< Number of bytes the storage can hold
+    PacketPool* m_pool;                   //!< Pool providing the storage of the packet, if any
+    std::size_t m_readPos;                //!< Current reading position in the packet
+    std::size_t m_sendPos;                //!< Current send position in the packet (for handling partial sends)
+    bool        m_isValid;                //!< Reading state of the packet
+    char        m_inline[InlineCapacity]; //!< Storage of the small packets
 };
 
 } // namespace sf
@@ -506,6 +611,13 @@ private:
 /// }
 /// \endcode
 ///
+/// Packets up to 256 bytes are stored inside the sf::Packet
+/// instance itself. Larger packets allocate their storage,
+/// unless they are constructed with an sf::PacketPool. Packets
+/// keep their storage when they are cleared, so a packet reused
+/// for every message (see reset and reserve) doesn't allocate
+/// memory once it has reached its largest size.
+///
 /// Packets also provide an extra feature that allows to apply
 /// custom transformations to the data before it is sent,
 /// and after it is received. This is typically used to
@@ -0,0 +1,181 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2023 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_PACKETPOOL_HPP
+#define SFML_PACKETPOOL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Cache of memory blocks for the data of packets
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API PacketPool : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Sizes of the blocks provided by the pool
+    ///
+    ////////////////////////////////////////////////////////////
+    enum
+    {
+        MinBlockSize   = 512,   //!< Size of the smallest blocks, in bytes
+        MaxBlockSize   = 65536, //!< Size of the largest blocks, in bytes
+        SizeClassCount = 8      //!< Number of block sizes, each one twice the previous one
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    PacketPool();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Releases the cached blocks. The pool must outlive the
+    /// packets which use it.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~PacketPool();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a block of memory from the pool
+    ///
+    /// The requested size is rounded up to the next block size.
+    /// Cached blocks are reused, new ones are allocated only
+    /// when there's none left of the requested size.
+    /// This function can be called from any thread.
+    ///
+    /// \param size Minimum size of the block, in bytes; receives its actual size
+    ///
+    /// \return Address of the block, or NULL if the size is larger than MaxBlockSize
+    ///
+    /// \see deallocate
+    ///
+    ////////////////////////////////////////////////////////////
+    void* allocate(std::size_t& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give a block of memory back to the pool
+    ///
+    /// The block is kept by the pool, to be reused by the next
+    /// allocations of the same size.
+    /// This function can be called from any thread.
+    ///
+    /// \param block Block to give back, obtained from allocate
+    /// \param size  Actual size of the block, as returned by allocate
+    ///
+    /// \see allocate
+    ///
+    ////////////////////////////////////////////////////////////
+    void deallocate(void* block, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release all the cached blocks
+    ///
+    /// The blocks used by packets are not affected.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of bytes cached by the pool
+    ///
+    /// \return Total size of the blocks waiting to be reused
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCachedSize() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Free list of the blocks of a given size
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SizeClass
+    {
+        SizeClass();
+
+        void*         blocks; //!< First free block, each one storing the address of the next one
+        std::size_t   count;  //!< Number of free blocks
+        mutable Mutex mutex;  //!< Mutex protecting the free list
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    SizeClass m_classes[SizeClassCount]; //!< Free lists, by increasing block size
+};
+
+} // namespace sf
+
+
+#endif // SFML_PACKETPOOL_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::PacketPool
+/// \ingroup network
+///
+/// sf::PacketPool keeps the memory blocks released by packets,
+/// so that the next packets can reuse them instead of
+/// allocating memory. Blocks are sorted by size, from 512
+/// bytes to 64 KB, each size twice the previous one; larger
+/// packets use the heap.
+///
+/// Packets draw their storage from a pool when it is given
+/// to their constructor. Small packets (up to 256 bytes) are
+/// stored inside the packet itself and never use the pool.
+///
+/// A pool can be shared by several threads, and must outlive
+/// the packets which use it.
+///
+/// Usage example:
+/// \code
+/// sf::PacketPool pool;
+///
+/// while (running)
+/// {
+///     // After the first iterations, the storage of the packet
+///     // comes from the pool and no memory is allocated
+///     sf::Packet packet(pool);
+///     packet << largeMessage;
+///     socket.send(packet);
+/// }
+/// \endcode
+///
+/// \see sf::Packet
+///
+////////////////////////////////////////////////////////////
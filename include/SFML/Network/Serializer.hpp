@@ -0,0 +1,249 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2023 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SERIALIZER_HPP
+#define SFML_SERIALIZER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Packet.hpp>
+#include <SFML/System/String.hpp>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+namespace Encoding
+{
+    ////////////////////////////////////////////////////////////
+    /// \ingroup network
+    /// \brief Enumeration of the encodings of serialized fields
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Type
+    {
+        Default, //!< Fixed for numbers, Utf8 for strings
+        Fixed,   //!< Big-endian numbers of their own size, UTF-32 for strings
+        Varint,  //!< Integers on 1 to 10 bytes, 7 bits per byte: small values are shorter
+        Zigzag,  //!< Varint where small negative integers are short too
+        Utf8     //!< UTF-8 for strings
+    };
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Description of the fields of a serializable type
+///
+/// This template is specialized for each serializable type
+/// with the SFML_SERIALIZER_BEGIN, SFML_SERIALIZER_FIELD
+/// and SFML_SERIALIZER_END macros.
+///
+////////////////////////////////////////////////////////////
+template <typename T>
+struct SerializerFields;
+
+////////////////////////////////////////////////////////////
+/// \brief Write and read structures to and from packets
+///        according to the description of their fields
+///
+////////////////////////////////////////////////////////////
+template <typename T>
+class Serializer
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of bytes taken by an object in a packet
+    ///
+    /// \param object Object to measure
+    ///
+    /// \return Size of the encoded object, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::size_t getSize(const T& object);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append an object to the end of a packet
+    ///
+    /// The size of the object is computed first, so that the
+    /// packet grows at most once and the fields are encoded
+    /// in place in a single pass.
+    ///
+    /// \param packet Packet to fill
+    /// \param object Object to write
+    ///
+    /// \see read
+    ///
+    ////////////////////////////////////////////////////////////
+    static void write(Packet& packet, const T& object);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Extract an object from a packet
+    ///
+    /// If the packet doesn't contain a whole object, the
+    /// packet is marked as invalid like with its own
+    /// extraction operators, and the object is left
+    /// partially filled.
+    ///
+    /// \param packet Packet to read from
+    /// \param object Object to fill
+    ///
+    /// \return True if the object was read successfully
+    ///
+    /// \see write
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool read(Packet& packet, T& object);
+};
+
+#include <SFML/Network/Serializer.inl>
+
+} // namespace sf
+
+
+////////////////////////////////////////////////////////////
+/// \brief Start the description of the fields of a type
+///
+/// This macro must be used in the global namespace.
+///
+/// \param type Type to describe, with its namespaces
+///
+////////////////////////////////////////////////////////////
+#define SFML_SERIALIZER_BEGIN(type) \
+    namespace sf \
+    { \
+    template <> \
+    struct SerializerFields<type> \
+    { \
+        template <typename Visitor, typename Object> \
+        static void visit(Visitor& visitor, Object& object) \
+        {
+
+////////////////////////////////////////////////////////////
+/// \brief Describe a field with its default encoding
+///
+/// \param name Name of the member variable
+///
+////////////////////////////////////////////////////////////
+#define SFML_SERIALIZER_FIELD(name) \
+            visitor(object.name, sf::Encoding::Default);
+
+////////////////////////////////////////////////////////////
+/// \brief Describe a field with a specific encoding
+///
+/// \param name     Name of the member variable
+/// \param encoding Encoding of the field (see sf::Encoding)
+///
+////////////////////////////////////////////////////////////
+#define SFML_SERIALIZER_FIELD_AS(name, encoding) \
+            visitor(object.name, encoding);
+
+////////////////////////////////////////////////////////////
+/// \brief End the description of the fields of a type
+///
+////////////////////////////////////////////////////////////
+#define SFML_SERIALIZER_END() \
+        } \
+    }; \
+    }
+
+
+#endif // SFML_SERIALIZER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Serializer
+/// \ingroup network
+///
+/// sf::Serializer writes structures to packets, and reads
+/// them back, from a description of their fields given
+/// once with the SFML_SERIALIZER_* macros. Because the
+/// layout is known at compile time, the size of an object
+/// is computed before writing it: the packet grows once and
+/// the fields are encoded directly into its storage, instead
+/// of going through one operator << per field.
+///
+/// The supported field types are bool, the sized integer
+/// types (sf::Int8 to sf::Uint64), float, double, std::string,
+/// sf::String, fixed-size arrays and std::vector of any of
+/// them, and other types described with the same macros.
+///
+/// Each field can be given an encoding:
+/// \li sf::Encoding::Fixed writes numbers in big-endian order
+///     on their own size, like sf::Packet does
+/// \li sf::Encoding::Varint writes integers on 1 byte per
+///     7 significant bits: identifiers, counters and most
+///     sizes take 1 or 2 bytes instead of 4 or 8
+/// \li sf::Encoding::Zigzag does the same for signed values
+///     that are often small but negative, like deltas
+/// \li sf::Encoding::Utf8 writes sf::String as UTF-8 instead
+///     of 4 bytes per character
+///
+/// The encoding of a std::vector or an array field applies to
+/// its elements. Arrays of numbers with a fixed encoding are
+/// written and read in bulk, with a byte swapping loop that
+/// the compiler can vectorize. The lengths of strings and
+/// vectors are always written as varints.
+///
+/// Usage example:
+/// \code
+/// struct Player
+/// {
+///     sf::Uint32         id;
+///     sf::Int32          scoreDelta;
+///     sf::String         name;
+///     std::vector<float> position;
+/// };
+///
+/// SFML_SERIALIZER_BEGIN(Player)
+///     SFML_SERIALIZER_FIELD_AS(id, sf::Encoding::Varint)
+///     SFML_SERIALIZER_FIELD_AS(scoreDelta, sf::Encoding::Zigzag)
+///     SFML_SERIALIZER_FIELD(name)
+///     SFML_SERIALIZER_FIELD(position)
+/// SFML_SERIALIZER_END()
+///
+/// Player player = ...;
+/// sf::Packet packet;
+/// sf::Serializer<Player>::write(packet, player);
+/// socket.send(packet);
+///
+/// ...
+///
+/// socket.receive(packet);
+/// if (sf::Serializer<Player>::read(packet, player))
+/// {
+///     // ok, player is filled
+/// }
+/// \endcode
+///
+/// Objects written with sf::Serializer must be read with
+/// sf::Serializer, with the same description of their fields.
+///
+/// \see sf::Packet
+///
+////////////////////////////////////////////////////////////
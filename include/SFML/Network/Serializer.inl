@@ -0,0 +1,770 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2023 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+// Categories of field types, used to pick their encoding functions
+////////////////////////////////////////////////////////////
+struct IntegerTag {};
+struct FloatTag {};
+struct ObjectTag {};
+
+
+////////////////////////////////////////////////////////////
+// Properties of the field types; types that are not numbers
+// are objects described with the SFML_SERIALIZER_* macros
+////////////////////////////////////////////////////////////
+template <typename T>
+struct FieldTraits
+{
+    typedef ObjectTag Category;
+};
+
+template <> struct FieldTraits<bool>   {typedef IntegerTag Category; typedef Uint8  Bits; static const bool isSigned = false;};
+template <> struct FieldTraits<Int8>   {typedef IntegerTag Category; typedef Uint8  Bits; static const bool isSigned = true;};
+template <> struct FieldTraits<Uint8>  {typedef IntegerTag Category; typedef Uint8  Bits; static const bool isSigned = false;};
+template <> struct FieldTraits<Int16>  {typedef IntegerTag Category; typedef Uint16 Bits; static const bool isSigned = true;};
+template <> struct FieldTraits<Uint16> {typedef IntegerTag Category; typedef Uint16 Bits; static const bool isSigned = false;};
+template <> struct FieldTraits<Int32>  {typedef IntegerTag Category; typedef Uint32 Bits; static const bool isSigned = true;};
+template <> struct FieldTraits<Uint32> {typedef IntegerTag Category; typedef Uint32 Bits; static const bool isSigned = false;};
+template <> struct FieldTraits<Int64>  {typedef IntegerTag Category; typedef Uint64 Bits; static const bool isSigned = true;};
+template <> struct FieldTraits<Uint64> {typedef IntegerTag Category; typedef Uint64 Bits; static const bool isSigned = false;};
+template <> struct FieldTraits<float>  {typedef FloatTag   Category; typedef Uint32 Bits;};
+template <> struct FieldTraits<double> {typedef FloatTag   Category; typedef Uint64 Bits;};
+
+
+////////////////////////////////////////////////////////////
+// Bounds-checked cursor over the data of a packet
+////////////////////////////////////////////////////////////
+struct SerializerReader
+{
+    bool check(Uint64 size)
+    {
+        valid = valid && (size <= static_cast<Uint64>(end - current));
+        return valid;
+    }
+
+    const char* current;
+    const char* end;
+    bool        valid;
+};
+
+
+////////////////////////////////////////////////////////////
+// Declarations of the encoding functions, so that the
+// functions of nested fields find all of them
+////////////////////////////////////////////////////////////
+template <typename T> std::size_t fieldSize(const T& value, Encoding::Type encoding);
+template <typename T> std::size_t fieldSize(const std::vector<T>& value, Encoding::Type encoding);
+template <typename T, std::size_t N> std::size_t fieldSize(const T (&value)[N], Encoding::Type encoding);
+inline std::size_t fieldSize(const std::string& value, Encoding::Type encoding);
+inline std::size_t fieldSize(const String& value, Encoding::Type encoding);
+
+template <typename T> void writeField(char*& output, const T& value, Encoding::Type encoding);
+template <typename T> void writeField(char*& output, const std::vector<T>& value, Encoding::Type encoding);
+template <typename T, std::size_t N> void writeField(char*& output, const T (&value)[N], Encoding::Type encoding);
+inline void writeField(char*& output, const std::string& value, Encoding::Type encoding);
+inline void writeField(char*& output, const String& value, Encoding::Type encoding);
+
+template <typename T> void readField(SerializerReader& reader, T& value, Encoding::Type encoding);
+template <typename T> void readField(SerializerReader& reader, std::vector<T>& value, Encoding::Type encoding);
+template <typename T, std::size_t N> void readField(SerializerReader& reader, T (&value)[N], Encoding::Type encoding);
+inline void readField(SerializerReader& reader, std::string& value, Encoding::Type encoding);
+inline void readField(SerializerReader& reader, String& value, Encoding::Type encoding);
+
+
+////////////////////////////////////////////////////////////
+// Visitors of the fields of an object
+////////////////////////////////////////////////////////////
+struct SerializerSizer
+{
+    template <typename T>
+    void operator ()(const T& field, Encoding::Type encoding)
+    {
+        size += fieldSize(field, encoding);
+    }
+
+    std::size_t size;
+};
+
+struct SerializerWriter
+{
+    template <typename T>
+    void operator ()(const T& field, Encoding::Type encoding)
+    {
+        writeField(output, field, encoding);
+    }
+
+    char* output;
+};
+
+struct SerializerExtractor
+{
+    template <typename T>
+    void operator ()(T& field, Encoding::Type encoding)
+    {
+        if (reader.valid)
+            readField(reader, field, encoding);
+    }
+
+    SerializerReader reader;
+};
+
+
+////////////////////////////////////////////////////////////
+// Whether an encoding writes integers with a variable length
+inline bool isVariable(Encoding::Type encoding)
+{
+    return (encoding == Encoding::Varint) || (encoding == Encoding::Zigzag);
+}
+
+
+////////////////////////////////////////////////////////////
+// Number of bytes of a varint
+inline std::size_t varintSize(Uint64 value)
+{
+    std::size_t size = 1;
+    while (value >= 0x80)
+    {
+        value >>= 7;
+        ++size;
+    }
+
+    return size;
+}
+
+
+////////////////////////////////////////////////////////////
+// Write a varint: 7 bits per byte, least significant first,
+// with the high bit set on all bytes but the last one
+inline void writeVarint(char*& output, Uint64 value)
+{
+    while (value >= 0x80)
+    {
+        *output++ = static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+
+    *output++ = static_cast<char>(value);
+}
+
+
+////////////////////////////////////////////////////////////
+inline bool readVarint(SerializerReader& reader, Uint64& value)
+{
+    value = 0;
+    for (unsigned int shift = 0; shift < 64; shift += 7)
+    {
+        if (!reader.check(1))
+            return false;
+
+        Uint8 byte = static_cast<Uint8>(*reader.current++);
+        value |= static_cast<Uint64>(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+            return true;
+    }
+
+    // More than 10 bytes: this is not a 64-bit varint
+    reader.valid = false;
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+// Convert an integer to the value of its varint: signed values
+// are sign-extended, or zigzag-encoded (0, -1, 1, -2, ... become
+// 0, 1, 2, 3, ...) so that small negative values stay short
+template <typename T>
+Uint64 toVarint(T value, Encoding::Type encoding)
+{
+    if (!FieldTraits<T>::isSigned)
+        return static_cast<Uint64>(value);
+
+    Int64 extended = static_cast<Int64>(value);
+    if (encoding == Encoding::Zigzag)
+        return (static_cast<Uint64>(extended) << 1) ^ static_cast<Uint64>(extended >> 63);
+
+    return static_cast<Uint64>(extended);
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+T fromVarint(Uint64 value, Encoding::Type encoding)
+{
+    if (FieldTraits<T>::isSigned && (encoding == Encoding::Zigzag))
+        return static_cast<T>(static_cast<Int64>(value >> 1) ^ -static_cast<Int64>(value & 1));
+
+    return static_cast<T>(value);
+}
+
+
+////////////////////////////////////////////////////////////
+// Whether the host stores numbers with their least significant
+// byte first; this is a constant once the function is inlined
+inline bool isLittleEndian()
+{
+    const Uint16 one = 1;
+    Uint8 first;
+    std::memcpy(&first, &one, 1);
+    return first == 1;
+}
+
+
+////////////////////////////////////////////////////////////
+// Convert numbers between the host and the network (big-endian)
+// byte order; the shifts compile to byte swap instructions, and
+// to vector shuffles in the array loops below
+inline Uint8 networkOrder(Uint8 value)
+{
+    return value;
+}
+
+inline Uint16 networkOrder(Uint16 value)
+{
+    return isLittleEndian() ? static_cast<Uint16>((value >> 8) | (value << 8)) : value;
+}
+
+inline Uint32 networkOrder(Uint32 value)
+{
+    if (!isLittleEndian())
+        return value;
+
+    return (value >> 24) | ((value >> 8) & 0xFF00) | ((value << 8) & 0xFF0000) | (value << 24);
+}
+
+inline Uint64 networkOrder(Uint64 value)
+{
+    if (!isLittleEndian())
+        return value;
+
+    return (static_cast<Uint64>(networkOrder(static_cast<Uint32>(value))) << 32) |
+           networkOrder(static_cast<Uint32>(value >> 32));
+}
+
+
+////////////////////////////////////////////////////////////
+// Write and read numbers in network byte order, at any alignment
+template <typename T>
+void writeFixed(char* output, T bits)
+{
+    bits = networkOrder(bits);
+    std::memcpy(output, &bits, sizeof(bits));
+}
+
+template <typename T>
+void readFixed(const char* input, T& bits)
+{
+    std::memcpy(&bits, input, sizeof(bits));
+    bits = networkOrder(bits);
+}
+
+
+////////////////////////////////////////////////////////////
+// Conversions between numbers and the bits that are written
+template <typename T>
+typename FieldTraits<T>::Bits toBits(T value, IntegerTag)
+{
+    return static_cast<typename FieldTraits<T>::Bits>(value);
+}
+
+template <typename T>
+typename FieldTraits<T>::Bits toBits(T value, FloatTag)
+{
+    typename FieldTraits<T>::Bits bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+template <typename T>
+T fromBits(typename FieldTraits<T>::Bits bits, IntegerTag)
+{
+    return static_cast<T>(bits);
+}
+
+template <typename T>
+T fromBits(typename FieldTraits<T>::Bits bits, FloatTag)
+{
+    T value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+
+////////////////////////////////////////////////////////////
+// Single numbers and objects
+////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t fieldSize(const T& value, Encoding::Type encoding, IntegerTag)
+{
+    return isVariable(encoding) ? varintSize(toVarint(value, encoding)) : sizeof(T);
+}
+
+template <typename T>
+std::size_t fieldSize(const T&, Encoding::Type, FloatTag)
+{
+    return sizeof(T);
+}
+
+template <typename T>
+std::size_t fieldSize(const T& value, Encoding::Type, ObjectTag)
+{
+    SerializerSizer sizer = {0};
+    SerializerFields<T>::visit(sizer, value);
+    return sizer.size;
+}
+
+template <typename T>
+std::size_t fieldSize(const T& value, Encoding::Type encoding)
+{
+    return fieldSize(value, encoding, typename FieldTraits<T>::Category());
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void writeField(char*& output, const T& value, Encoding::Type encoding, IntegerTag)
+{
+    if (isVariable(encoding))
+    {
+        writeVarint(output, toVarint(value, encoding));
+    }
+    else
+    {
+        writeFixed(output, toBits(value, IntegerTag()));
+        output += sizeof(T);
+    }
+}
+
+template <typename T>
+void writeField(char*& output, const T& value, Encoding::Type, FloatTag)
+{
+    writeFixed(output, toBits(value, FloatTag()));
+    output += sizeof(T);
+}
+
+template <typename T>
+void writeField(char*& output, const T& value, Encoding::Type, ObjectTag)
+{
+    SerializerWriter writer = {output};
+    SerializerFields<T>::visit(writer, value);
+    output = writer.output;
+}
+
+template <typename T>
+void writeField(char*& output, const T& value, Encoding::Type encoding)
+{
+    writeField(output, value, encoding, typename FieldTraits<T>::Category());
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void readField(SerializerReader& reader, T& value, Encoding::Type encoding, IntegerTag)
+{
+    if (isVariable(encoding))
+    {
+        Uint64 varint;
+        if (readVarint(reader, varint))
+            value = fromVarint<T>(varint, encoding);
+    }
+    else if (reader.check(sizeof(T)))
+    {
+        typename FieldTraits<T>::Bits bits;
+        readFixed(reader.current, bits);
+        value = fromBits<T>(bits, IntegerTag());
+        reader.current += sizeof(T);
+    }
+}
+
+template <typename T>
+void readField(SerializerReader& reader, T& value, Encoding::Type, FloatTag)
+{
+    if (reader.check(sizeof(T)))
+    {
+        typename FieldTraits<T>::Bits bits;
+        readFixed(reader.current, bits);
+        value = fromBits<T>(bits, FloatTag());
+        reader.current += sizeof(T);
+    }
+}
+
+template <typename T>
+void readField(SerializerReader& reader, T& value, Encoding::Type, ObjectTag)
+{
+    SerializerExtractor extractor = {reader};
+    SerializerFields<T>::visit(extractor, value);
+    reader = extractor.reader;
+}
+
+template <typename T>
+void readField(SerializerReader& reader, T& value, Encoding::Type encoding)
+{
+    readField(reader, value, encoding, typename FieldTraits<T>::Category());
+}
+
+
+////////////////////////////////////////////////////////////
+// Arrays: numbers with a fixed size are converted in bulk
+////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t arraySize(const T* data, std::size_t count, Encoding::Type encoding, ObjectTag)
+{
+    std::size_t size = 0;
+    for (std::size_t i = 0; i < count; ++i)
+        size += fieldSize(data[i], encoding);
+
+    return size;
+}
+
+template <typename T>
+std::size_t arraySize(const T* data, std::size_t count, Encoding::Type encoding, IntegerTag)
+{
+    return isVariable(encoding) ? arraySize(data, count, encoding, ObjectTag()) : count * sizeof(T);
+}
+
+template <typename T>
+std::size_t arraySize(const T*, std::size_t count, Encoding::Type, FloatTag)
+{
+    return count * sizeof(T);
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T, typename Category>
+void writeBulk(char*& output, const T* data, std::size_t count, Category category)
+{
+    // Work on a local pointer: the bytes written could alias the output variable
+    char* destination = output;
+    for (std::size_t i = 0; i < count; ++i)
+        writeFixed(destination + i * sizeof(T), toBits(data[i], category));
+
+    output += count * sizeof(T);
+}
+
+template <typename T>
+void writeArray(char*& output, const T* data, std::size_t count, Encoding::Type encoding, ObjectTag)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        writeField(output, data[i], encoding);
+}
+
+template <typename T>
+void writeArray(char*& output, const T* data, std::size_t count, Encoding::Type encoding, IntegerTag)
+{
+    if (isVariable(encoding))
+        writeArray(output, data, count, encoding, ObjectTag());
+    else
+        writeBulk(output, data, count, IntegerTag());
+}
+
+template <typename T>
+void writeArray(char*& output, const T* data, std::size_t count, Encoding::Type, FloatTag)
+{
+    writeBulk(output, data, count, FloatTag());
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T, typename Category>
+void readBulk(SerializerReader& reader, T* data, std::size_t count, Category category)
+{
+    if (!reader.check(static_cast<Uint64>(count) * sizeof(T)))
+        return;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        typename FieldTraits<T>::Bits bits;
+        readFixed(reader.current + i * sizeof(T), bits);
+        data[i] = fromBits<T>(bits, category);
+    }
+
+    reader.current += count * sizeof(T);
+}
+
+template <typename T>
+void readArray(SerializerReader& reader, T* data, std::size_t count, Encoding::Type encoding, ObjectTag)
+{
+    for (std::size_t i = 0; (i < count) && reader.valid; ++i)
+        readField(reader, data[i], encoding);
+}
+
+template <typename T>
+void readArray(SerializerReader& reader, T* data, std::size_t count, Encoding::Type encoding, IntegerTag)
+{
+    if (isVariable(encoding))
+        readArray(reader, data, count, encoding, ObjectTag());
+    else
+        readBulk(reader, data, count, IntegerTag());
+}
+
+template <typename T>
+void readArray(SerializerReader& reader, T* data, std::size_t count, Encoding::Type, FloatTag)
+{
+    readBulk(reader, data, count, FloatTag());
+}
+
+
+////////////////////////////////////////////////////////////
+// Fixed-size arrays: only the elements are written
+////////////////////////////////////////////////////////////
+template <typename T, std::size_t N>
+std::size_t fieldSize(const T (&value)[N], Encoding::Type encoding)
+{
+    return arraySize(value, N, encoding, typename FieldTraits<T>::Category());
+}
+
+template <typename T, std::size_t N>
+void writeField(char*& output, const T (&value)[N], Encoding::Type encoding)
+{
+    writeArray(output, value, N, encoding, typename FieldTraits<T>::Category());
+}
+
+template <typename T, std::size_t N>
+void readField(SerializerReader& reader, T (&value)[N], Encoding::Type encoding)
+{
+    readArray(reader, value, N, encoding, typename FieldTraits<T>::Category());
+}
+
+
+////////////////////////////////////////////////////////////
+// Vectors: the number of elements, then the elements
+////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t fieldSize(const std::vector<T>& value, Encoding::Type encoding)
+{
+    std::size_t size = varintSize(value.size());
+    if (!value.empty())
+        size += arraySize(&value[0], value.size(), encoding, typename FieldTraits<T>::Category());
+
+    return size;
+}
+
+template <typename T>
+void writeField(char*& output, const std::vector<T>& value, Encoding::Type encoding)
+{
+    writeVarint(output, value.size());
+    if (!value.empty())
+        writeArray(output, &value[0], value.size(), encoding, typename FieldTraits<T>::Category());
+}
+
+template <typename T>
+void readField(SerializerReader& reader, std::vector<T>& value, Encoding::Type encoding)
+{
+    // Elements take at least one byte: a larger count can only
+    // come from corrupted data, don't allocate memory for it
+    Uint64 count;
+    if (!readVarint(reader, count) || !reader.check(count))
+        return;
+
+    value.resize(static_cast<std::size_t>(count));
+    if (!value.empty())
+        readArray(reader, &value[0], value.size(), encoding, typename FieldTraits<T>::Category());
+}
+
+
+////////////////////////////////////////////////////////////
+// Strings: the number of bytes (or characters with UTF-32),
+// then the bytes
+////////////////////////////////////////////////////////////
+inline std::size_t fieldSize(const std::string& value, Encoding::Type)
+{
+    return varintSize(value.size()) + value.size();
+}
+
+inline void writeField(char*& output, const std::string& value, Encoding::Type)
+{
+    writeVarint(output, value.size());
+    if (!value.empty())
+        std::memcpy(output, value.data(), value.size());
+
+    output += value.size();
+}
+
+inline void readField(SerializerReader& reader, std::string& value, Encoding::Type)
+{
+    Uint64 length;
+    if (readVarint(reader, length) && reader.check(length))
+    {
+        value.assign(reader.current, static_cast<std::size_t>(length));
+        reader.current += static_cast<std::size_t>(length);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+// Number of bytes of a character in UTF-8; invalid characters
+// are replaced with U+FFFD
+inline std::size_t utf8Size(Uint32 character)
+{
+    if (character < 0x80)
+        return 1;
+    else if (character < 0x800)
+        return 2;
+    else if (character < 0x10000)
+        return 3;
+    else if (character < 0x110000)
+        return 4;
+    else
+        return 3;
+}
+
+
+////////////////////////////////////////////////////////////
+inline std::size_t utf8Size(const String& value)
+{
+    const Uint32* characters = value.getData();
+
+    std::size_t size = 0;
+    for (std::size_t i = 0; i < value.getSize(); ++i)
+        size += utf8Size(characters[i]);
+
+    return size;
+}
+
+
+////////////////////////////////////////////////////////////
+inline void writeUtf8(char*& output, Uint32 character)
+{
+    if (character >= 0x110000)
+        character = 0xFFFD;
+
+    if (character < 0x80)
+    {
+        *output++ = static_cast<char>(character);
+    }
+    else if (character < 0x800)
+    {
+        *output++ = static_cast<char>(0xC0 | (character >> 6));
+        *output++ = static_cast<char>(0x80 | (character & 0x3F));
+    }
+    else if (character < 0x10000)
+    {
+        *output++ = static_cast<char>(0xE0 | (character >> 12));
+        *output++ = static_cast<char>(0x80 | ((character >> 6) & 0x3F));
+        *output++ = static_cast<char>(0x80 | (character & 0x3F));
+    }
+    else
+    {
+        *output++ = static_cast<char>(0xF0 | (character >> 18));
+        *output++ = static_cast<char>(0x80 | ((character >> 12) & 0x3F));
+        *output++ = static_cast<char>(0x80 | ((character >> 6) & 0x3F));
+        *output++ = static_cast<char>(0x80 | (character & 0x3F));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+inline std::size_t fieldSize(const String& value, Encoding::Type encoding)
+{
+    if (encoding == Encoding::Fixed)
+        return varintSize(value.getSize()) + value.getSize() * sizeof(Uint32);
+
+    std::size_t size = utf8Size(value);
+    return varintSize(size) + size;
+}
+
+inline void writeField(char*& output, const String& value, Encoding::Type encoding)
+{
+    if (encoding == Encoding::Fixed)
+    {
+        writeVarint(output, value.getSize());
+        writeBulk(output, value.getData(), value.getSize(), IntegerTag());
+    }
+    else
+    {
+        const Uint32* characters = value.getData();
+
+        writeVarint(output, utf8Size(value));
+        for (std::size_t i = 0; i < value.getSize(); ++i)
+            writeUtf8(output, characters[i]);
+    }
+}
+
+inline void readField(SerializerReader& reader, String& value, Encoding::Type encoding)
+{
+    Uint64 length;
+    if (!readVarint(reader, length))
+        return;
+
+    if (encoding == Encoding::Fixed)
+    {
+        if (reader.check(length) && reader.check(length * sizeof(Uint32)))
+        {
+            std::basic_string<Uint32> characters(static_cast<std::size_t>(length), 0);
+            if (!characters.empty())
+                readBulk(reader, &characters[0], characters.size(), IntegerTag());
+
+            value = characters;
+        }
+    }
+    else if (reader.check(length))
+    {
+        value = String::fromUtf8(reader.current, reader.current + static_cast<std::size_t>(length));
+        reader.current += static_cast<std::size_t>(length);
+    }
+}
+
+} // namespace priv
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t Serializer<T>::getSize(const T& object)
+{
+    return priv::fieldSize(object, Encoding::Default);
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void Serializer<T>::write(Packet& packet, const T& object)
+{
+    std::size_t size = getSize(object);
+
+    // Grow the packet once, then encode the fields in place
+    packet.reserve(packet.m_size + size);
+
+    char* output = packet.m_data + packet.m_size;
+    priv::writeField(output, object, Encoding::Default);
+    packet.m_size += size;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+bool Serializer<T>::read(Packet& packet, T& object)
+{
+    priv::SerializerReader reader = {packet.m_data + packet.m_readPos, packet.m_data + packet.m_size, packet.m_isValid};
+    priv::readField(reader, object, Encoding::Default);
+
+    if (reader.valid)
+        packet.m_readPos = static_cast<std::size_t>(reader.current - packet.m_data);
+    else
+        packet.m_isValid = false;
+
+    return reader.valid;
+}
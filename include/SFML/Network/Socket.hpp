@@ -166,8 +166,23 @@ protected:
     ////////////////////////////////////////////////////////////
     void close();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the socket holds received data not read yet
+    ///
+    /// Sockets which buffer the received data must be reported
+    /// as ready by selectors even when the system has nothing
+    /// more to give. This must only be true when the buffered
+    /// data can be received without waiting, otherwise the
+    /// selectors would keep waking up for nothing.
+    ///
+    /// \return True if buffered data can be received right away
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool hasBufferedData() const;
+
 private:
 
+    friend class SocketPoller;
     friend class SocketSelector;
 
     ////////////////////////////////////////////////////////////
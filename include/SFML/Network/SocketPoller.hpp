@@ -0,0 +1,297 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2023 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SOCKETPOLLER_HPP
+#define SFML_SOCKETPOLLER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+class Socket;
+
+////////////////////////////////////////////////////////////
+/// \brief Scalable multiplexer that waits for events on many sockets
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API SocketPoller : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Events that a socket can be watched for
+    ///
+    ////////////////////////////////////////////////////////////
+    enum EventType
+    {
+        Read  = 1 << 0, //!< The socket can receive data, or accept a connection
+        Write = 1 << 1, //!< The socket can send data
+        Error = 1 << 2  //!< The socket is disconnected or in error (reported only)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief When the events of a socket are reported
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Trigger
+    {
+        LevelTriggered, //!< Report the socket as long as it is ready
+        EdgeTriggered   //!< Report the socket only when it becomes ready
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Socket reported as ready by wait
+    ///
+    ////////////////////////////////////////////////////////////
+    struct ReadySocket
+    {
+        Socket*      socket;   //!< Socket which is ready
+        unsigned int events;   //!< Combination of EventType flags which occurred
+        void*        userData; //!< User data given when the socket was added
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    SocketPoller();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~SocketPoller();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a new socket to the poller
+    ///
+    /// This function keeps a weak reference to the socket,
+    /// so you have to make sure that the socket is not destroyed
+    /// or closed while it is stored in the poller.
+    /// This function fails if the socket is not valid, or
+    /// if it is already in the poller.
+    ///
+    /// \param socket   Reference to the socket to add
+    /// \param events   Combination of Read and Write flags to watch
+    /// \param userData User data to give back when the socket is ready
+    /// \param trigger  When the events of the socket are reported
+    ///
+    /// \return True if the socket was added, false otherwise
+    ///
+    /// \see modify, remove, clear
+    ///
+    ////////////////////////////////////////////////////////////
+    bool add(Socket& socket, unsigned int events = Read, void* userData = NULL, Trigger trigger = LevelTriggered);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the events watched for a socket of the poller
+    ///
+    /// A typical use is to watch the Write event only while
+    /// some data couldn't be sent.
+    ///
+    /// \param socket   Reference to the socket to modify
+    /// \param events   Combination of Read and Write flags to watch
+    /// \param userData User data to give back when the socket is ready
+    /// \param trigger  When the events of the socket are reported
+    ///
+    /// \return True if the socket was modified, false if it is not in the poller
+    ///
+    /// \see add
+    ///
+    ////////////////////////////////////////////////////////////
+    bool modify(Socket& socket, unsigned int events, void* userData = NULL, Trigger trigger = LevelTriggered);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a socket from the poller
+    ///
+    /// This function doesn't destroy the socket, it simply
+    /// removes the reference that the poller has to it.
+    /// If the socket was reported by the last call to wait,
+    /// its ready socket entry is cleared (its socket is set
+    /// to NULL and it has no events), so that it is safe to
+    /// remove sockets while handling the ready ones.
+    ///
+    /// \param socket Reference to the socket to remove
+    ///
+    /// \see add, clear
+    ///
+    ////////////////////////////////////////////////////////////
+    void remove(Socket& socket);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the sockets stored in the poller
+    ///
+    /// \see add, remove
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of sockets stored in the poller
+    ///
+    /// \return Number of sockets
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSocketCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until one or more sockets are ready
+    ///
+    /// This function returns as soon as at least one socket
+    /// is ready for one of its watched events. The ready
+    /// sockets, and only them, can then be retrieved with
+    /// getReadySocket.
+    /// If you use a timeout and no socket is ready before the
+    /// timeout is over, the function returns 0.
+    ///
+    /// \param timeout Maximum time to wait, (use Time::Zero for infinity)
+    ///
+    /// \return Number of ready sockets
+    ///
+    /// \see getReadySocket
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t wait(Time timeout = Time::Zero);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a socket reported as ready by the last call to wait
+    ///
+    /// \param index Index of the ready socket, in range [0, count returned by wait[
+    ///
+    /// \return The ready socket, with its events and user data
+    ///
+    /// \see wait
+    ///
+    ////////////////////////////////////////////////////////////
+    const ReadySocket& getReadySocket(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether edge-triggered events are supported
+    ///
+    /// When they are not, EdgeTriggered sockets are reported
+    /// as LevelTriggered ones, which gives the same results
+    /// when all the available data is received after a
+    /// socket is reported, at the cost of extra wake-ups.
+    ///
+    /// \return True if edge-triggered events are supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isEdgeTriggeredSupported();
+
+private:
+
+    struct SocketPollerImpl;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    SocketPollerImpl* m_impl; //!< Opaque pointer to the implementation (which requires OS-specific types)
+};
+
+} // namespace sf
+
+
+#endif // SFML_SOCKETPOLLER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SocketPoller
+/// \ingroup network
+///
+/// sf::SocketPoller has the same purpose as sf::SocketSelector:
+/// it allows a single thread to handle many sockets, by waiting
+/// until some of them are ready. It is designed for servers
+/// with many connections:
+/// \li it is based on epoll where available (Linux and Android),
+///     and on poll elsewhere, so the number of sockets is not
+///     limited by FD_SETSIZE
+/// \li wait returns only the sockets which are ready, so there's
+///     no need to test every socket after each wake-up
+/// \li sockets can be watched for writing as well as for reading
+/// \li a user data pointer is stored with each socket, typically
+///     to find the connection object it belongs to
+///
+/// Like sf::SocketSelector, the poller keeps references to
+/// the sockets that you add, not copies: they must be removed
+/// from the poller before they are closed or destroyed.
+///
+/// Packets received by a TCP socket may be buffered by the
+/// socket itself: sockets holding buffered data are reported
+/// as ready, as long as they were added, modified or reported
+/// by the previous call to wait before being received from.
+///
+/// Sockets can be watched in level-triggered mode (the default),
+/// where they are reported by every call to wait as long as they
+/// are ready, or in edge-triggered mode, where they are reported
+/// only when they become ready; the latter requires non-blocking
+/// sockets, and all the available data must then be received
+/// until the socket returns sf::Socket::NotReady.
+///
+/// Usage example:
+/// \code
+/// sf::TcpListener listener;
+/// listener.listen(55001);
+///
+/// sf::SocketPoller poller;
+/// poller.add(listener);
+///
+/// while (running)
+/// {
+///     std::size_t count = poller.wait();
+///     for (std::size_t i = 0; i < count; ++i)
+///     {
+///         const sf::SocketPoller::ReadySocket& ready = poller.getReadySocket(i);
+///         if (ready.socket == &listener)
+///         {
+///             // The listener is ready: there is a pending connection
+///             Client* client = new Client;
+///             if (listener.accept(client->socket) == sf::Socket::Done)
+///                 poller.add(client->socket, sf::SocketPoller::Read, client);
+///             else
+///                 delete client;
+///         }
+///         else
+///         {
+///             // A client has sent some data, we can receive it
+///             Client* client = static_cast<Client*>(ready.userData);
+///             sf::Packet packet;
+///             if (client->socket.receive(packet) == sf::Socket::Done)
+///             {
+///                 ...
+///             }
+///         }
+///     }
+/// }
+/// \endcode
+///
+/// \see sf::SocketSelector, sf::Socket
+///
+////////////////////////////////////////////////////////////
@@ -69,7 +69,10 @@ public:
     ///
     /// This function keeps a weak reference to the socket,
     /// so you have to make sure that the socket is not destroyed
-    /// while it is stored in the selector.
+    /// while it is stored in the selector: the socket is accessed
+    /// by wait, to know whether it holds buffered packets, so
+    /// destroying it without removing it first leads to
+    /// undefined behavior.
     /// This function does nothing if the socket is not valid.
     ///
     /// \param socket Reference to the socket to add
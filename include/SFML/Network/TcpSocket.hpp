@@ -192,11 +192,37 @@ public:
     ////////////////////////////////////////////////////////////
     Status send(Packet& packet);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Send several formatted packets of data to the remote peer
+    ///
+    /// The packets are sent in order, and as few system calls as
+    /// possible; they are received as if they were sent one by one.
+    /// Their data is not copied.
+    /// In non-blocking mode, if this function returns sf::Socket::Partial,
+    /// you \em must retry sending the same unmodified packets before
+    /// sending anything else; the packets which were already sent
+    /// are skipped.
+    /// This function will fail if the socket is not connected.
+    ///
+    /// \param packets Array of packets to send
+    /// \param count   Number of packets in the array
+    ///
+    /// \return Status code
+    ///
+    /// \see receive
+    ///
+    ////////////////////////////////////////////////////////////
+    Status send(Packet* packets, std::size_t count);
+
     ////////////////////////////////////////////////////////////
     /// \brief Receive a formatted packet of data from the remote peer
     ///
     /// In blocking mode, this function will wait until the whole packet
     /// has been received.
+    /// The socket reads as much data as available at once, into
+    /// a buffer of its own, so that several small packets sent in
+    /// a row are received with a single system call; bytes which
+    /// follow the packet are kept for the next calls to receive.
     /// This function will fail if the socket is not connected.
     ///
     /// \param packet Packet to fill with the received data
@@ -208,27 +234,64 @@ public:
     ////////////////////////////////////////////////////////////
     Status receive(Packet& packet);
 
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the socket holds a received packet not read yet
+    ///
+    /// Only complete packets are taken into account: the
+    /// beginning of a packet whose data is still on its way
+    /// doesn't make the socket ready.
+    ///
+    /// \return True if a complete packet is buffered
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool hasBufferedData() const;
+
 private:
 
     friend class TcpListener;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive raw data from the socket itself
+    ///
+    /// Unlike the public receive function, this function
+    /// ignores the data already buffered by the socket.
+    ///
+    /// \param data     Pointer to the array to fill with the received bytes
+    /// \param size     Maximum number of bytes that can be received
+    /// \param received This variable is filled with the actual number of bytes received
+    ///
+    /// \return Status code
+    ///
+    ////////////////////////////////////////////////////////////
+    Status receiveBytes(void* data, std::size_t size, std::size_t& received);
+
     ////////////////////////////////////////////////////////////
     /// \brief Structure holding the data of a pending packet
     ///
+    /// Packets are parsed from the receive buffer of the socket,
+    /// unless they are larger than it: their data is then
+    /// received directly in the pending packet.
+    ///
     ////////////////////////////////////////////////////////////
     struct PendingPacket
     {
         PendingPacket();
 
-        Uint32            Size;         //!< Data of packet size
-        std::size_t       SizeReceived; //!< Number of size bytes received so far
-        std::vector<char> Data;         //!< Data of the packet
+        Uint32            Size;     //!< Size of the packet data, read from its header
+        std::size_t       Received; //!< Number of data bytes received so far
+        bool              Large;    //!< Is a packet too large for the receive buffer being received?
+        std::vector<char> Data;     //!< Data of the packet, grown as it is received
     };
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    PendingPacket m_pendingPacket; //!< Temporary data of the packet currently being received
+    PendingPacket     m_pendingPacket; //!< Temporary data of the packet currently being received
+    std::vector<char> m_buffer;        //!< Data received but not read yet, allocated on first use
+    std::size_t       m_bufferBegin;   //!< Position of the first unread byte in the buffer
+    std::size_t       m_bufferEnd;     //!< Position after the last received byte in the buffer
 };
 
 } // namespace sf
@@ -54,6 +54,23 @@ public:
         MaxDatagramSize = 65507 //!< The maximum number of bytes that can be sent in a single UDP datagram
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure defining a datagram of a batch
+    ///
+    /// Datagrams to send have their data, size and receiver
+    /// defined; received datagrams have their received size
+    /// and sender filled.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Datagram
+    {
+        void*          data;          //!< Bytes to send, or buffer to fill with the received bytes
+        std::size_t    size;          //!< Number of bytes to send, or size of the buffer to fill
+        std::size_t    received;      //!< Number of bytes received
+        IpAddress      remoteAddress; //!< Address of the receiver, or of the sender
+        unsigned short remotePort;    //!< Port of the receiver, or of the sender
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -189,6 +206,54 @@ public:
     ////////////////////////////////////////////////////////////
     Status receive(Packet& packet, IpAddress& remoteAddress, unsigned short& remotePort);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Send several datagrams, each to its own receiver
+    ///
+    /// The datagrams are sent in order, with as few system
+    /// calls as possible (sendmmsg where it is available).
+    /// The \a received member of the datagrams is ignored.
+    /// If a datagram is bigger than UdpSocket::MaxDatagramSize,
+    /// this function fails and no data is sent.
+    /// In non-blocking mode, this function returns
+    /// sf::Socket::Partial if only some of the datagrams could
+    /// be sent; \a sent tells how many, the next call should
+    /// start with the following one.
+    ///
+    /// \param datagrams Array of datagrams to send
+    /// \param count     Number of datagrams in the array
+    /// \param sent      This variable is filled with the number of datagrams sent
+    ///
+    /// \return Status code
+    ///
+    /// \see receive
+    ///
+    ////////////////////////////////////////////////////////////
+    Status send(const Datagram* datagrams, std::size_t count, std::size_t& sent);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive several datagrams
+    ///
+    /// In blocking mode, this function waits for the first
+    /// datagram, then it takes the datagrams which are already
+    /// waiting in the socket, up to \a count, without blocking
+    /// again; it uses as few system calls as possible (recvmmsg
+    /// where it is available).
+    /// Each datagram must have its \a data and \a size members
+    /// defined; its other members are filled with the received
+    /// size and the sender. The bytes of a datagram which don't
+    /// fit in its buffer are lost.
+    ///
+    /// \param datagrams Array of datagrams to fill
+    /// \param count     Number of datagrams in the array
+    /// \param received  This variable is filled with the number of datagrams received
+    ///
+    /// \return Status code
+    ///
+    /// \see send
+    ///
+    ////////////////////////////////////////////////////////////
+    Status receive(Datagram* datagrams, std::size_t count, std::size_t& received);
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -287,6 +352,25 @@ private:
 /// socket.send(message.c_str(), message.size() + 1, sender, port);
 /// \endcode
 ///
+/// Servers which exchange many datagrams can send and receive
+/// them in batches, to save system calls:
+/// \code
+/// char buffers[64][512];
+/// sf::UdpSocket::Datagram datagrams[64];
+/// for (int i = 0; i < 64; ++i)
+/// {
+///     datagrams[i].data = buffers[i];
+///     datagrams[i].size = sizeof(buffers[i]);
+/// }
+///
+/// std::size_t count = 0;
+/// if (socket.receive(datagrams, 64, count) == sf::Socket::Done)
+/// {
+///     for (std::size_t i = 0; i < count; ++i)
+///         process(buffers[i], datagrams[i].received, datagrams[i].remoteAddress, datagrams[i].remotePort);
+/// }
+/// \endcode
+///
 /// \see sf::Socket, sf::TcpSocket, sf::Packet
 ///
 ////////////////////////////////////////////////////////////
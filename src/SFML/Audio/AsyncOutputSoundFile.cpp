@@ -0,0 +1,237 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2023 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/AsyncOutputSoundFile.hpp>
+#include <SFML/Audio/RingBuffer.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+
+#ifdef _MSC_VER
+    #pragma warning(disable: 4355) // 'this' used in base member initializer list
+#endif
+
+
+namespace
+{
+    // Maximum number of samples given to the writer at once
+    const std::size_t encodeBlockSize = 16384;
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+AsyncOutputSoundFile::AsyncOutputSoundFile() :
+m_file          (),
+m_queue         (new priv::RingBuffer<Int16>),
+m_encodeBuffer  (),
+m_thread        (&AsyncOutputSoundFile::encode, this),
+m_queueDuration (seconds(5)),
+m_overflowPolicy(Block),
+m_channelCount  (0),
+m_isOpen        (false),
+m_isEncoding    (false),
+m_droppedCount  (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+AsyncOutputSoundFile::~AsyncOutputSoundFile()
+{
+    // Write the queued samples and close the file in case it was open
+    close();
+
+    delete m_queue;
+}
+
+
+////////////////////////////////////////////////////////////
+bool AsyncOutputSoundFile::openFromFile(const std::string& filename, unsigned int sampleRate, unsigned int channelCount)
+{
+    // If the file is already open, first close it
+    close();
+
+    if (!m_file.openFromFile(filename, sampleRate, channelCount))
+        return false;
+
+    // Allocate the queue, with room for whole frames only
+    std::size_t frameCount = static_cast<std::size_t>(m_queueDuration.asSeconds() * static_cast<float>(sampleRate));
+    frameCount = std::max(frameCount, static_cast<std::size_t>(1));
+    m_queue->resize(frameCount * channelCount);
+    m_encodeBuffer.resize(std::max(encodeBlockSize - encodeBlockSize % channelCount, static_cast<std::size_t>(channelCount)));
+
+    m_channelCount = channelCount;
+    m_isOpen       = true;
+    m_droppedCount = 0;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 AsyncOutputSoundFile::write(const Int16* samples, Uint64 count)
+{
+    if (!m_isOpen || !samples || !count)
+        return 0;
+
+    Uint64 written = 0;
+    while (written < count)
+    {
+        std::size_t size = static_cast<std::size_t>(std::min(count - written, static_cast<Uint64>(m_queue->getCapacity())));
+        written += m_queue->write(samples + written, size);
+
+        // Make sure that the background thread encodes the new samples
+        startEncoding();
+
+        if (written < count)
+        {
+            if (m_overflowPolicy == Drop)
+            {
+                Lock lock(m_mutex);
+                m_droppedCount += count - written;
+                break;
+            }
+
+            // Make room in the queue: encode the next block from this thread, or
+            // wait until the background thread has encoded the one it is working on
+            Lock lock(m_encoderMutex);
+            encodeBlock();
+        }
+    }
+
+    return written;
+}
+
+
+////////////////////////////////////////////////////////////
+void AsyncOutputSoundFile::flush()
+{
+    if (!m_isOpen)
+        return;
+
+    // Help the background thread rather than waiting for it: when nothing is left
+    // to encode while holding the encoder mutex, all the samples are written
+    for (;;)
+    {
+        Lock lock(m_encoderMutex);
+        if (encodeBlock() == 0)
+            return;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void AsyncOutputSoundFile::close()
+{
+    if (!m_isOpen)
+        return;
+
+    // Let the background thread write the queued samples, it finishes once the queue is empty
+    m_thread.wait();
+
+    m_file.close();
+    m_queue->resize(0);
+    m_isOpen = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void AsyncOutputSoundFile::setQueueDuration(Time duration)
+{
+    m_queueDuration = duration;
+}
+
+
+////////////////////////////////////////////////////////////
+void AsyncOutputSoundFile::setOverflowPolicy(OverflowPolicy policy)
+{
+    m_overflowPolicy = policy;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 AsyncOutputSoundFile::getDroppedSampleCount() const
+{
+    Lock lock(m_mutex);
+    return m_droppedCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void AsyncOutputSoundFile::startEncoding()
+{
+    {
+        Lock lock(m_mutex);
+        if (m_isEncoding)
+            return;
+
+        m_isEncoding = true;
+    }
+
+    m_thread.launch();
+}
+
+
+////////////////////////////////////////////////////////////
+void AsyncOutputSoundFile::encode()
+{
+    for (;;)
+    {
+        std::size_t count = 0;
+        {
+            Lock lock(m_encoderMutex);
+            count = encodeBlock();
+        }
+
+        // Stop once the queue is empty; checking it under the mutex makes
+        // sure that the samples queued meanwhile start the thread again
+        if (count == 0)
+        {
+            Lock lock(m_mutex);
+            if (m_queue->getReadableCount() == 0)
+            {
+                m_isEncoding = false;
+                return;
+            }
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t AsyncOutputSoundFile::encodeBlock()
+{
+    std::size_t count = m_queue->read(&m_encodeBuffer[0], m_encodeBuffer.size());
+    if (count > 0)
+        m_file.write(&m_encodeBuffer[0], count);
+
+    return count;
+}
+
+} // namespace sf
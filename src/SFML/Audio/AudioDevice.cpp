@@ -29,8 +29,16 @@
 #include <SFML/Audio/ALCheck.hpp>
 #include <SFML/Audio/Listener.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <alext.h>
 #include <vector>
 
+#ifndef AL_SOFT_deferred_updates
+    typedef void (AL_APIENTRY *LPALDEFERUPDATESSOFT)(void);
+    typedef void (AL_APIENTRY *LPALPROCESSUPDATESSOFT)(void);
+#endif
+
 #if defined(__APPLE__)
     #if defined(__clang__)
         #pragma clang diagnostic ignored "-Wdeprecated-declarations"
@@ -48,6 +56,84 @@ namespace
     sf::Vector3f listenerPosition (0.f, 0.f, 0.f);
     sf::Vector3f listenerDirection(0.f, 0.f, -1.f);
     sf::Vector3f listenerUpVector (0.f, 1.f, 0.f);
+
+    // AL_SOFT_deferred_updates entry points, NULL if the extension is not supported
+    LPALDEFERUPDATESSOFT   alDeferUpdates   = NULL;
+    LPALPROCESSUPDATESSOFT alProcessUpdates = NULL;
+
+    // Nesting depth of the deferred updates, shared by all the threads as the deferral applies to the whole context
+    unsigned int deferDepth = 0;
+    sf::Mutex    deferMutex;
+
+    // AL_SOFT_buffer_samples entry point, NULL if the extension is not supported
+    LPALGETBUFFERSAMPLESSOFT alGetBufferSamples = NULL;
+
+    // Destination of the output, and format of the output rendered by the loopback device
+    sf::AudioOutput::Mode outputMode         = sf::AudioOutput::Device;
+    unsigned int          outputSampleRate   = 44100;
+    unsigned int          outputChannelCount = 2;
+
+    // ALC_SOFT_loopback entry point, NULL if no loopback device is open
+    LPALCRENDERSAMPLESSOFT alcRenderSamples = NULL;
+    sf::Uint64             renderedFrames   = 0;
+
+    // Name of the null output device of OpenAL Soft
+    const char* nullDeviceName = "No Output";
+
+    // Get the ALC_SOFT_loopback channel configuration that matches a number of channels
+    ALCenum getLoopbackChannels(unsigned int channelCount)
+    {
+        switch (channelCount)
+        {
+            case 1:  return ALC_MONO_SOFT;
+            case 2:  return ALC_STEREO_SOFT;
+            case 4:  return ALC_QUAD_SOFT;
+            case 6:  return ALC_5POINT1_SOFT;
+            case 7:  return ALC_6POINT1_SOFT;
+            case 8:  return ALC_7POINT1_SOFT;
+            default: return 0;
+        }
+    }
+
+    // Open a loopback device, and create its context rendering in the selected format
+    ALCcontext* createLoopbackContext()
+    {
+        LPALCLOOPBACKOPENDEVICESOFT alcLoopbackOpenDevice = NULL;
+        LPALCISRENDERFORMATSUPPORTEDSOFT alcIsRenderFormatSupported = NULL;
+        if (alcIsExtensionPresent(NULL, "ALC_SOFT_loopback") != AL_FALSE)
+        {
+            alcLoopbackOpenDevice      = reinterpret_cast<LPALCLOOPBACKOPENDEVICESOFT>(alcGetProcAddress(NULL, "alcLoopbackOpenDeviceSOFT"));
+            alcIsRenderFormatSupported = reinterpret_cast<LPALCISRENDERFORMATSUPPORTEDSOFT>(alcGetProcAddress(NULL, "alcIsRenderFormatSupportedSOFT"));
+            alcRenderSamples           = reinterpret_cast<LPALCRENDERSAMPLESSOFT>(alcGetProcAddress(NULL, "alcRenderSamplesSOFT"));
+        }
+
+        if (!alcLoopbackOpenDevice || !alcIsRenderFormatSupported || !alcRenderSamples)
+        {
+            sf::err() << "Failed to open the loopback audio device: ALC_SOFT_loopback is not supported" << std::endl;
+            alcRenderSamples = NULL;
+            return NULL;
+        }
+
+        audioDevice = alcLoopbackOpenDevice(NULL);
+        if (!audioDevice)
+            return NULL;
+
+        ALCenum channels = getLoopbackChannels(outputChannelCount);
+        ALCsizei frequency = static_cast<ALCsizei>(outputSampleRate);
+        if (!alcIsRenderFormatSupported(audioDevice, frequency, channels, ALC_FLOAT_SOFT))
+        {
+            sf::err() << "Failed to open the loopback audio device: unsupported format ("
+                      << outputSampleRate << " Hz, " << outputChannelCount << " channels)" << std::endl;
+            return NULL;
+        }
+
+        ALCint attributes[] = {ALC_FORMAT_CHANNELS_SOFT, channels,
+                               ALC_FORMAT_TYPE_SOFT,     ALC_FLOAT_SOFT,
+                               ALC_FREQUENCY,            frequency,
+                               0};
+
+        return alcCreateContext(audioDevice, attributes);
+    }
 }
 
 namespace sf
@@ -57,14 +143,22 @@ namespace priv
 ////////////////////////////////////////////////////////////
 AudioDevice::AudioDevice()
 {
-    // Create the device
-    audioDevice = alcOpenDevice(NULL);
+    renderedFrames = 0;
 
-    if (audioDevice)
+    // Create the device and its context
+    if (outputMode == AudioOutput::Loopback)
     {
-        // Create the context
-        audioContext = alcCreateContext(audioDevice, NULL);
+        audioContext = createLoopbackContext();
+    }
+    else
+    {
+        audioDevice = alcOpenDevice(outputMode == AudioOutput::Null ? nullDeviceName : NULL);
+        if (audioDevice)
+            audioContext = alcCreateContext(audioDevice, NULL);
+    }
 
+    if (audioDevice)
+    {
         if (audioContext)
         {
             // Set the context as the current one (we'll only need one)
@@ -80,6 +174,17 @@ AudioDevice::AudioDevice()
             alCheck(alListenerf(AL_GAIN, listenerVolume * 0.01f));
             alCheck(alListener3f(AL_POSITION, listenerPosition.x, listenerPosition.y, listenerPosition.z));
             alCheck(alListenerfv(AL_ORIENTATION, orientation));
+
+            // Load the functions to batch updates, if available
+            if (alIsExtensionPresent("AL_SOFT_deferred_updates") != AL_FALSE)
+            {
+                alDeferUpdates   = reinterpret_cast<LPALDEFERUPDATESSOFT>(alGetProcAddress("alDeferUpdatesSOFT"));
+                alProcessUpdates = reinterpret_cast<LPALPROCESSUPDATESSOFT>(alGetProcAddress("alProcessUpdatesSOFT"));
+            }
+
+            // Load the function to read back buffers, if available
+            if (alIsExtensionPresent("AL_SOFT_buffer_samples") != AL_FALSE)
+                alGetBufferSamples = reinterpret_cast<LPALGETBUFFERSAMPLESSOFT>(alGetProcAddress("alGetBufferSamplesSOFT"));
         }
         else
         {
@@ -96,6 +201,11 @@ AudioDevice::AudioDevice()
 ////////////////////////////////////////////////////////////
 AudioDevice::~AudioDevice()
 {
+    alDeferUpdates     = NULL;
+    alProcessUpdates   = NULL;
+    alGetBufferSamples = NULL;
+    alcRenderSamples   = NULL;
+
     // Destroy the context
     alcMakeContextCurrent(NULL);
     if (audioContext)
@@ -104,6 +214,9 @@ AudioDevice::~AudioDevice()
     // Destroy the device
     if (audioDevice)
         alcCloseDevice(audioDevice);
+
+    audioContext = NULL;
+    audioDevice  = NULL;
 }
 
 
@@ -165,6 +278,45 @@ int AudioDevice::getFormatFromChannelCount(unsigned int channelCount)
 }
 
 
+////////////////////////////////////////////////////////////
+int AudioDevice::getFormatFromChannelCount(unsigned int channelCount, SampleFormat sampleFormat)
+{
+    if (sampleFormat == Int16Samples)
+        return getFormatFromChannelCount(channelCount);
+
+    // Create a temporary audio device in case none exists yet.
+    // This device will not be used in this function and merely
+    // makes sure there is a valid OpenAL device for format
+    // queries if none has been created yet.
+    std::vector<AudioDevice> device;
+    if (!audioDevice)
+        device.resize(1);
+
+    // Float samples require the AL_EXT_float32 extension
+    if (alIsExtensionPresent("AL_EXT_float32") == AL_FALSE)
+        return 0;
+
+    // Find the good format according to the number of channels
+    int format = 0;
+    switch (channelCount)
+    {
+        case 1:  format = alGetEnumValue("AL_FORMAT_MONO_FLOAT32");   break;
+        case 2:  format = alGetEnumValue("AL_FORMAT_STEREO_FLOAT32"); break;
+        case 4:  format = alGetEnumValue("AL_FORMAT_QUAD32");         break;
+        case 6:  format = alGetEnumValue("AL_FORMAT_51CHN32");        break;
+        case 7:  format = alGetEnumValue("AL_FORMAT_61CHN32");        break;
+        case 8:  format = alGetEnumValue("AL_FORMAT_71CHN32");        break;
+        default: format = 0;                                          break;
+    }
+
+    // Fixes a bug on OS X
+    if (format == -1)
+        format = 0;
+
+    return format;
+}
+
+
 ////////////////////////////////////////////////////////////
 void AudioDevice::setGlobalVolume(float volume)
 {
@@ -238,6 +390,140 @@ Vector3f AudioDevice::getUpVector()
     return listenerUpVector;
 }
 
+
+////////////////////////////////////////////////////////////
+void AudioDevice::beginDeferredUpdates()
+{
+    Lock lock(deferMutex);
+
+    if ((deferDepth++ == 0) && audioContext && alDeferUpdates && alProcessUpdates)
+        alCheck(alDeferUpdates());
+}
+
+
+////////////////////////////////////////////////////////////
+void AudioDevice::endDeferredUpdates()
+{
+    Lock lock(deferMutex);
+
+    if (deferDepth == 0)
+        return;
+
+    if ((--deferDepth == 0) && audioContext && alDeferUpdates && alProcessUpdates)
+        alCheck(alProcessUpdates());
+}
+
+
+////////////////////////////////////////////////////////////
+bool AudioDevice::canReadBufferSamples()
+{
+    return audioContext && alGetBufferSamples;
+}
+
+
+////////////////////////////////////////////////////////////
+bool AudioDevice::readBufferSamples(unsigned int buffer, unsigned int channelCount, SampleFormat sampleFormat, void* samples, Uint64 frameCount)
+{
+    if (!canReadBufferSamples())
+        return false;
+
+    // Find the channel configuration matching the number of channels
+    ALenum channels = 0;
+    switch (channelCount)
+    {
+        case 1:  channels = AL_MONO_SOFT;    break;
+        case 2:  channels = AL_STEREO_SOFT;  break;
+        case 4:  channels = AL_QUAD_SOFT;    break;
+        case 6:  channels = AL_5POINT1_SOFT; break;
+        case 7:  channels = AL_6POINT1_SOFT; break;
+        case 8:  channels = AL_7POINT1_SOFT; break;
+        default: return false;
+    }
+
+    ALenum type = (sampleFormat == Float32Samples) ? AL_FLOAT_SOFT : AL_SHORT_SOFT;
+    alCheck(alGetBufferSamples(buffer, 0, static_cast<ALsizei>(frameCount), channels, type, samples));
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int AudioDevice::getSampleRate()
+{
+    if (!audioDevice)
+        return 0;
+
+    ALCint sampleRate = 0;
+    alcGetIntegerv(audioDevice, ALC_FREQUENCY, 1, &sampleRate);
+
+    return static_cast<unsigned int>(sampleRate);
+}
+
+
+////////////////////////////////////////////////////////////
+bool AudioDevice::setOutputMode(AudioOutput::Mode mode, unsigned int sampleRate, unsigned int channelCount)
+{
+    if (audioDevice)
+    {
+        err() << "Failed to change the audio output mode: audio resources still exist" << std::endl;
+        return false;
+    }
+
+    if ((mode == AudioOutput::Loopback) && ((sampleRate == 0) || (getLoopbackChannels(channelCount) == 0)))
+    {
+        err() << "Failed to change the audio output mode: unsupported format ("
+              << sampleRate << " Hz, " << channelCount << " channels)" << std::endl;
+        return false;
+    }
+
+    outputMode         = mode;
+    outputSampleRate   = sampleRate;
+    outputChannelCount = channelCount;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+AudioOutput::Mode AudioDevice::getOutputMode()
+{
+    return outputMode;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int AudioDevice::getOutputChannelCount()
+{
+    return outputChannelCount;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int AudioDevice::getOutputSampleRate()
+{
+    return outputSampleRate;
+}
+
+
+////////////////////////////////////////////////////////////
+bool AudioDevice::renderSamples(float* samples, Uint64 frameCount)
+{
+    if (!audioContext || !alcRenderSamples)
+        return false;
+
+    alcRenderSamples(audioDevice, samples, static_cast<ALCsizei>(frameCount));
+    renderedFrames += frameCount;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 AudioDevice::getRenderedFrameCount()
+{
+    return renderedFrames;
+}
+
 } // namespace priv
 
 } // namespace sf
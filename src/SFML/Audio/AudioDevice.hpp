@@ -28,6 +28,9 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <SFML/Audio/AudioOutput.hpp>
+#include <SFML/Audio/SampleFormat.hpp>
+#include <SFML/Config.hpp>
 #include <SFML/System/Vector3.hpp>
 #include <set>
 #include <string>
@@ -83,6 +86,17 @@ public:
     ////////////////////////////////////////////////////////////
     static int getFormatFromChannelCount(unsigned int channelCount);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the OpenAL format that matches the given number of channels and sample format
+    ///
+    /// \param channelCount Number of channels
+    /// \param sampleFormat Format of the samples
+    ///
+    /// \return Corresponding format, or 0 if the combination is not supported by the device
+    ///
+    ////////////////////////////////////////////////////////////
+    static int getFormatFromChannelCount(unsigned int channelCount, SampleFormat sampleFormat);
+
     ////////////////////////////////////////////////////////////
     /// \brief Change the global volume of all the sounds and musics
     ///
@@ -182,6 +196,117 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     static Vector3f getUpVector();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start deferring the updates of the listener and sources
+    ///
+    /// Calls can be nested, also from different threads: the
+    /// updates are applied when the outermost batch ends. Without
+    /// the AL_SOFT_deferred_updates extension, the updates are
+    /// applied immediately.
+    ///
+    /// \see endDeferredUpdates
+    ///
+    ////////////////////////////////////////////////////////////
+    static void beginDeferredUpdates();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop deferring the updates of the listener and sources
+    ///
+    /// \see beginDeferredUpdates
+    ///
+    ////////////////////////////////////////////////////////////
+    static void endDeferredUpdates();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the samples of audio buffers can be read back
+    ///
+    /// Reading back requires the AL_SOFT_buffer_samples extension.
+    ///
+    /// \return True if readBufferSamples is supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool canReadBufferSamples();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read back the samples of an audio buffer
+    ///
+    /// \param buffer       OpenAL buffer identifier
+    /// \param channelCount Number of channels of the buffer
+    /// \param sampleFormat Format of the samples to read
+    /// \param samples      Array to fill, large enough for \a frameCount frames
+    /// \param frameCount   Number of frames to read
+    ///
+    /// \return True on success, false if reading back is not supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool readBufferSamples(unsigned int buffer, unsigned int channelCount, SampleFormat sampleFormat, void* samples, Uint64 frameCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the sample rate of the audio device
+    ///
+    /// \return Output sample rate of the device, 0 if no device is open
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getSampleRate();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Select the destination of the mixed audio output
+    ///
+    /// It only applies to the next device, and fails if
+    /// a device is currently open.
+    ///
+    /// \param mode         New output mode
+    /// \param sampleRate   Sample rate of the rendered output, for the Loopback mode
+    /// \param channelCount Number of channels of the rendered output, for the Loopback mode
+    ///
+    /// \return True if the mode was changed
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool setOutputMode(AudioOutput::Mode mode, unsigned int sampleRate, unsigned int channelCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the destination of the mixed audio output
+    ///
+    /// \return Current output mode
+    ///
+    ////////////////////////////////////////////////////////////
+    static AudioOutput::Mode getOutputMode();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of channels of the rendered output
+    ///
+    /// \return Number of channels, for the Loopback mode
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getOutputChannelCount();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the sample rate of the rendered output
+    ///
+    /// \return Sample rate, for the Loopback mode
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getOutputSampleRate();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Render the next frames of the mixed output of a loopback device
+    ///
+    /// \param samples    Array to fill with interleaved float samples
+    /// \param frameCount Number of frames to render
+    ///
+    /// \return True on success, false if no loopback device is open
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool renderSamples(float* samples, Uint64 frameCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of frames rendered by the loopback device
+    ///
+    /// \return Number of frames rendered since the device was opened
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 getRenderedFrameCount();
 };
 
 } // namespace priv
@@ -0,0 +1,177 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2023 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/AudioOutput.hpp>
+#include <SFML/Audio/ALCheck.hpp>
+#include <SFML/Audio/AudioDevice.hpp>
+#include <SFML/Audio/SampleConversion.hpp>
+#include <SFML/Audio/SoundStreamScheduler.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+#include <vector>
+
+
+namespace
+{
+    // Protects the rendering state
+    sf::Mutex mutex;
+
+    // Rendered frame at which the sound streams must be serviced again
+    sf::Uint64 nextUpdateFrame = 0;
+
+    // Rendered samples which are discarded or converted
+    std::vector<float> scratch;
+
+    // Render frames, servicing the sound streams as often as they require
+    bool renderFrames(float* samples, sf::Uint64 frameCount)
+    {
+        unsigned int channelCount = sf::priv::AudioDevice::getOutputChannelCount();
+        unsigned int sampleRate   = sf::priv::AudioDevice::getOutputSampleRate();
+
+        while (frameCount > 0)
+        {
+            // The rendered frame count starts again from zero when a new device is opened
+            sf::Uint64 renderedFrames = sf::priv::AudioDevice::getRenderedFrameCount();
+            if ((renderedFrames == 0) || (renderedFrames >= nextUpdateFrame))
+            {
+                sf::Time interval = sf::priv::SoundStreamScheduler::update();
+                sf::Uint64 intervalFrames = static_cast<sf::Uint64>(interval.asMicroseconds()) * sampleRate / 1000000;
+                nextUpdateFrame = renderedFrames + std::max<sf::Uint64>(intervalFrames, 1);
+            }
+
+            // Render up to the next servicing of the streams
+            sf::Uint64 count = std::min(frameCount, nextUpdateFrame - renderedFrames);
+            if (!sf::priv::AudioDevice::renderSamples(samples, count))
+                return false;
+
+            samples    += count * channelCount;
+            frameCount -= count;
+        }
+
+        return true;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+bool AudioOutput::setMode(Mode mode, unsigned int sampleRate, unsigned int channelCount)
+{
+    if ((mode == Loopback) && !isLoopbackAvailable())
+        return false;
+
+    return priv::AudioDevice::setOutputMode(mode, sampleRate, channelCount);
+}
+
+
+////////////////////////////////////////////////////////////
+AudioOutput::Mode AudioOutput::getMode()
+{
+    return priv::AudioDevice::getOutputMode();
+}
+
+
+////////////////////////////////////////////////////////////
+bool AudioOutput::isLoopbackAvailable()
+{
+    // This is an ALC extension which doesn't need a device to be queried
+    return alcIsExtensionPresent(NULL, "ALC_SOFT_loopback") != ALC_FALSE;
+}
+
+
+////////////////////////////////////////////////////////////
+bool AudioOutput::render(float* samples, Uint64 frameCount)
+{
+    if (getMode() != Loopback)
+        return false;
+
+    Lock lock(mutex);
+
+    if (samples)
+        return renderFrames(samples, frameCount);
+
+    // Render into a scratch buffer, in blocks of bounded size
+    const Uint64 blockSize = 4096;
+    scratch.resize(static_cast<std::size_t>(blockSize * priv::AudioDevice::getOutputChannelCount()));
+    while (frameCount > 0)
+    {
+        Uint64 count = std::min(frameCount, blockSize);
+        if (!renderFrames(&scratch[0], count))
+            return false;
+
+        frameCount -= count;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool AudioOutput::render(Int16* samples, Uint64 frameCount)
+{
+    if (!samples)
+        return render(static_cast<float*>(NULL), frameCount);
+
+    if (getMode() != Loopback)
+        return false;
+
+    Lock lock(mutex);
+
+    // Render float samples into a scratch buffer, and convert them
+    const Uint64 blockSize = 4096;
+    unsigned int channelCount = priv::AudioDevice::getOutputChannelCount();
+    scratch.resize(static_cast<std::size_t>(blockSize * channelCount));
+    while (frameCount > 0)
+    {
+        Uint64 count = std::min(frameCount, blockSize);
+        if (!renderFrames(&scratch[0], count))
+            return false;
+
+        std::size_t sampleCount = static_cast<std::size_t>(count * channelCount);
+        priv::convertSamples(&scratch[0], samples, sampleCount);
+        samples    += sampleCount;
+        frameCount -= count;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+Time AudioOutput::getRenderedDuration()
+{
+    if (getMode() != Loopback)
+        return Time::Zero;
+
+    Uint64 frames = priv::AudioDevice::getRenderedFrameCount();
+    return microseconds(static_cast<Int64>(frames * 1000000 / priv::AudioDevice::getOutputSampleRate()));
+}
+
+} // namespace sf
@@ -0,0 +1,197 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2023 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/CompressedSound.hpp>
+#include <SFML/Audio/CompressedSoundBuffer.hpp>
+#include <SFML/Audio/DecodedSoundCache.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+#include <cstring>
+
+
+namespace
+{
+    // Duration of the chunks of audio data, in milliseconds
+    const sf::Int32 chunkDuration = 50;
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+CompressedSound::CompressedSound() :
+m_buffer(NULL),
+m_offset(0)
+{
+    // Short chunks keep the memory used by each sound small
+    setChunkDuration(milliseconds(chunkDuration));
+}
+
+
+////////////////////////////////////////////////////////////
+CompressedSound::CompressedSound(const CompressedSoundBuffer& buffer) :
+m_buffer(NULL),
+m_offset(0)
+{
+    setChunkDuration(milliseconds(chunkDuration));
+    setBuffer(buffer);
+}
+
+
+////////////////////////////////////////////////////////////
+CompressedSound::~CompressedSound()
+{
+    // We must stop before the buffer is detached
+    resetBuffer();
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressedSound::setBuffer(const CompressedSoundBuffer& buffer)
+{
+    // First detach from the previous buffer
+    resetBuffer();
+
+    Lock lock(m_mutex);
+
+    // Assign and use the new buffer
+    m_buffer = &buffer;
+    m_buffer->attachSound(this);
+    m_offset = 0;
+
+    // Long sounds are decoded progressively from the encoded data
+    if (m_buffer->m_isStreamed && !m_file.openFromMemory(&m_buffer->m_data[0], m_buffer->m_data.size()))
+        return;
+
+    // Short sounds are decoded now, rather than by the streaming thread which feeds all the streams
+    if (!m_buffer->m_isStreamed && !m_buffer->m_data.empty())
+        priv::DecodedSoundCache::prefetch(m_buffer->m_id, &m_buffer->m_data[0], m_buffer->m_data.size());
+
+    if (m_buffer->getChannelCount() > 0)
+        initialize(m_buffer->getChannelCount(), m_buffer->getSampleRate());
+}
+
+
+////////////////////////////////////////////////////////////
+const CompressedSoundBuffer* CompressedSound::getBuffer() const
+{
+    return m_buffer;
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressedSound::resetBuffer()
+{
+    // First stop the sound in case it is playing
+    stop();
+
+    // Detach the buffer
+    if (m_buffer)
+    {
+        Lock lock(m_mutex);
+
+        m_buffer->detachSound(this);
+        m_buffer = NULL;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool CompressedSound::onGetData(SoundStream::Chunk& data)
+{
+    Lock lock(m_mutex);
+
+    if (!m_buffer)
+        return false;
+
+    std::size_t toFill = getChunkSampleCount();
+    if (m_samples.size() < toFill)
+        m_samples.resize(toFill);
+
+    std::size_t count = 0;
+    if (m_buffer->m_isStreamed)
+    {
+        // Decode the next chunk, like sf::Music
+        count = static_cast<std::size_t>(m_file.read(&m_samples[0], toFill));
+    }
+    else
+    {
+        // Get the samples decoded entirely, from the shared cache.
+        // They are copied, because they are only pinned during this call
+        // and may be evicted before the chunk is queued
+        const std::vector<Int16>* samples = priv::DecodedSoundCache::acquire(m_buffer->m_id, &m_buffer->m_data[0], m_buffer->m_data.size());
+        if (!samples)
+            return false;
+
+        if (m_offset < samples->size())
+        {
+            count = static_cast<std::size_t>(std::min<Uint64>(toFill, samples->size() - m_offset));
+            std::memcpy(&m_samples[0], &(*samples)[static_cast<std::size_t>(m_offset)], count * sizeof(Int16));
+            m_offset += count;
+        }
+
+        priv::DecodedSoundCache::release(m_buffer->m_id);
+    }
+
+    data.samples     = &m_samples[0];
+    data.sampleCount = count;
+
+    // Check if we have reached the end of the sound
+    return count == toFill;
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressedSound::onSeek(Time timeOffset)
+{
+    Lock lock(m_mutex);
+
+    if (!m_buffer)
+        return;
+
+    if (m_buffer->m_isStreamed)
+    {
+        m_file.seek(timeOffset);
+    }
+    else
+    {
+        Uint64 frame = static_cast<Uint64>(timeOffset.asMicroseconds()) * m_buffer->getSampleRate() / 1000000;
+        m_offset = frame * m_buffer->getChannelCount();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t CompressedSound::getChunkSampleCount() const
+{
+    // Always provide at least one sample per channel
+    Uint64 frames = static_cast<Uint64>(getChunkDuration().asMicroseconds()) * m_buffer->getSampleRate() / 1000000;
+    return static_cast<std::size_t>(std::max<Uint64>(frames, 1)) * m_buffer->getChannelCount();
+}
+
+} // namespace sf
@@ -0,0 +1,214 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2023 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/CompressedSoundBuffer.hpp>
+#include <SFML/Audio/CompressedSound.hpp>
+#include <SFML/Audio/DecodedSoundCache.hpp>
+#include <SFML/Audio/InputSoundFile.hpp>
+#include <SFML/System/FileInputStream.hpp>
+#include <SFML/System/InputStream.hpp>
+#include <SFML/System/Err.hpp>
+
+
+namespace
+{
+    sf::Time streamingThreshold = sf::seconds(10);
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+CompressedSoundBuffer::CompressedSoundBuffer() :
+m_id          (0),
+m_sampleCount (0),
+m_sampleRate  (0),
+m_channelCount(0),
+m_isStreamed  (false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+CompressedSoundBuffer::~CompressedSoundBuffer()
+{
+    resetSounds();
+
+    if (m_id)
+        priv::DecodedSoundCache::remove(m_id);
+}
+
+
+////////////////////////////////////////////////////////////
+bool CompressedSoundBuffer::loadFromFile(const std::string& filename)
+{
+    FileInputStream stream;
+    if (!stream.open(filename))
+    {
+        err() << "Failed to open sound file \"" << filename << "\"" << std::endl;
+        return false;
+    }
+
+    return loadFromStream(stream);
+}
+
+
+////////////////////////////////////////////////////////////
+bool CompressedSoundBuffer::loadFromMemory(const void* data, std::size_t sizeInBytes)
+{
+    if (!data || !sizeInBytes)
+        return false;
+
+    std::vector<char> contents(static_cast<const char*>(data), static_cast<const char*>(data) + sizeInBytes);
+    return initialize(contents);
+}
+
+
+////////////////////////////////////////////////////////////
+bool CompressedSoundBuffer::loadFromStream(InputStream& stream)
+{
+    Int64 size = stream.getSize();
+    if ((size <= 0) || (stream.seek(0) != 0))
+    {
+        err() << "Failed to read sound data from stream" << std::endl;
+        return false;
+    }
+
+    std::vector<char> contents(static_cast<std::size_t>(size));
+    if (stream.read(&contents[0], size) != size)
+    {
+        err() << "Failed to read sound data from stream" << std::endl;
+        return false;
+    }
+
+    return initialize(contents);
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 CompressedSoundBuffer::getSampleCount() const
+{
+    return m_sampleCount;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int CompressedSoundBuffer::getSampleRate() const
+{
+    return m_sampleRate;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int CompressedSoundBuffer::getChannelCount() const
+{
+    return m_channelCount;
+}
+
+
+////////////////////////////////////////////////////////////
+Time CompressedSoundBuffer::getDuration() const
+{
+    if (!m_sampleRate || !m_channelCount)
+        return Time::Zero;
+
+    return seconds(static_cast<float>(m_sampleCount) / static_cast<float>(m_sampleRate) / static_cast<float>(m_channelCount));
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t CompressedSoundBuffer::getEncodedSize() const
+{
+    return m_data.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressedSoundBuffer::setDecodedCacheSize(std::size_t sizeInBytes)
+{
+    priv::DecodedSoundCache::setCapacity(sizeInBytes);
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressedSoundBuffer::setStreamingThreshold(Time duration)
+{
+    streamingThreshold = duration;
+}
+
+
+////////////////////////////////////////////////////////////
+bool CompressedSoundBuffer::initialize(std::vector<char>& data)
+{
+    // Check that the data can be decoded, and read its properties
+    InputSoundFile file;
+    if (!file.openFromMemory(&data[0], data.size()))
+        return false;
+
+    // The sounds using the previous contents can't play them anymore
+    resetSounds();
+    if (m_id)
+        priv::DecodedSoundCache::remove(m_id);
+
+    m_data.swap(data);
+    m_id           = priv::DecodedSoundCache::createId();
+    m_sampleCount  = file.getSampleCount();
+    m_sampleRate   = file.getSampleRate();
+    m_channelCount = file.getChannelCount();
+    m_isStreamed   = getDuration() > streamingThreshold;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressedSoundBuffer::attachSound(CompressedSound* sound) const
+{
+    m_sounds.insert(sound);
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressedSoundBuffer::detachSound(CompressedSound* sound) const
+{
+    m_sounds.erase(sound);
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressedSoundBuffer::resetSounds()
+{
+    // Move the list away, as resetBuffer detaches the sounds from it
+    SoundList sounds;
+    sounds.swap(m_sounds);
+
+    for (SoundList::const_iterator it = sounds.begin(); it != sounds.end(); ++it)
+        (*it)->resetBuffer();
+}
+
+} // namespace sf
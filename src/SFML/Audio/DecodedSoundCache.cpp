@@ -0,0 +1,218 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2023 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/DecodedSoundCache.hpp>
+#include <SFML/Audio/InputSoundFile.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <map>
+
+
+namespace
+{
+    struct Entry
+    {
+        std::vector<sf::Int16> samples;  // Decoded samples
+        unsigned int           pins;     // Number of users of the samples
+        sf::Uint64             lastUse;  // Value of the use counter at the last acquisition
+        bool                   removed;  // Must the entry be removed once released?
+    };
+
+    typedef std::map<sf::Uint64, Entry> EntryMap;
+
+    sf::Mutex   mutex;
+    EntryMap    entries;
+    sf::Uint64  nextId   = 1;
+    sf::Uint64  useCount = 0;
+    std::size_t size     = 0;
+    std::size_t capacity = 32 * 1024 * 1024;
+
+    std::size_t getEntrySize(const Entry& entry)
+    {
+        return entry.samples.size() * sizeof(sf::Int16);
+    }
+
+    // Pin an entry, which becomes the most recently used one; the cache mutex must be locked
+    const std::vector<sf::Int16>* pin(Entry& entry)
+    {
+        ++entry.pins;
+        entry.lastUse = ++useCount;
+        return &entry.samples;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+Uint64 DecodedSoundCache::createId()
+{
+    Lock lock(mutex);
+    return nextId++;
+}
+
+
+////////////////////////////////////////////////////////////
+const std::vector<Int16>* DecodedSoundCache::acquire(Uint64 id, const void* data, std::size_t sizeInBytes)
+{
+    {
+        Lock lock(mutex);
+
+        EntryMap::iterator it = entries.find(id);
+        if (it != entries.end())
+            return pin(it->second);
+    }
+
+    // Cache miss: decode the whole contents, without blocking the other users of the cache
+    InputSoundFile file;
+    if (!file.openFromMemory(data, sizeInBytes))
+        return NULL;
+
+    std::vector<Int16> samples(static_cast<std::size_t>(file.getSampleCount()));
+    if (!samples.empty())
+        samples.resize(static_cast<std::size_t>(file.read(&samples[0], samples.size())));
+
+    Lock lock(mutex);
+
+    // Another thread may have decoded the same contents meanwhile
+    EntryMap::iterator it = entries.find(id);
+    if (it == entries.end())
+    {
+        Entry entry;
+        entry.pins    = 0;
+        entry.lastUse = 0;
+        entry.removed = false;
+
+        it = entries.insert(std::make_pair(id, entry)).first;
+        it->second.samples.swap(samples);
+
+        size += getEntrySize(it->second);
+    }
+
+    const std::vector<Int16>* result = pin(it->second);
+
+    // Make room for the new samples among the entries which are not in use
+    evict();
+
+    return result;
+}
+
+
+////////////////////////////////////////////////////////////
+void DecodedSoundCache::prefetch(Uint64 id, const void* data, std::size_t sizeInBytes)
+{
+    if (acquire(id, data, sizeInBytes))
+        release(id);
+}
+
+
+////////////////////////////////////////////////////////////
+void DecodedSoundCache::release(Uint64 id)
+{
+    Lock lock(mutex);
+
+    EntryMap::iterator it = entries.find(id);
+    if ((it == entries.end()) || (it->second.pins == 0))
+        return;
+
+    if ((--it->second.pins == 0) && it->second.removed)
+    {
+        size -= getEntrySize(it->second);
+        entries.erase(it);
+    }
+
+    evict();
+}
+
+
+////////////////////////////////////////////////////////////
+void DecodedSoundCache::remove(Uint64 id)
+{
+    Lock lock(mutex);
+
+    EntryMap::iterator it = entries.find(id);
+    if (it == entries.end())
+        return;
+
+    if (it->second.pins > 0)
+    {
+        it->second.removed = true;
+    }
+    else
+    {
+        size -= getEntrySize(it->second);
+        entries.erase(it);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void DecodedSoundCache::setCapacity(std::size_t sizeInBytes)
+{
+    Lock lock(mutex);
+
+    capacity = sizeInBytes;
+    evict();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t DecodedSoundCache::getSize()
+{
+    Lock lock(mutex);
+    return size;
+}
+
+
+////////////////////////////////////////////////////////////
+void DecodedSoundCache::evict()
+{
+    while (size > capacity)
+    {
+        // Find the least recently used entry which is not in use
+        EntryMap::iterator victim = entries.end();
+        for (EntryMap::iterator it = entries.begin(); it != entries.end(); ++it)
+        {
+            if ((it->second.pins == 0) && ((victim == entries.end()) || (it->second.lastUse < victim->second.lastUse)))
+                victim = it;
+        }
+
+        // Everything left is in use
+        if (victim == entries.end())
+            return;
+
+        size -= getEntrySize(victim->second);
+        entries.erase(victim);
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,142 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2023 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_DECODEDSOUNDCACHE_HPP
+#define SFML_DECODEDSOUNDCACHE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief In-memory LRU cache of the decoded samples of
+///        compressed sound buffers
+///
+/// Entries in use are pinned and never evicted; the least
+/// recently used of the other ones are evicted when the total
+/// size of the decoded samples exceeds the capacity.
+///
+////////////////////////////////////////////////////////////
+class DecodedSoundCache
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create a new identifier for encoded contents
+    ///
+    /// \return Identifier, never 0 and never reused
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 createId();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the decoded samples of encoded contents, and pin them
+    ///
+    /// The contents are decoded if they are not in the cache;
+    /// the cache stays available to the other threads meanwhile.
+    /// Each successful call must be matched by a call to release.
+    ///
+    /// \param id          Identifier of the contents
+    /// \param data        Pointer to the encoded file data
+    /// \param sizeInBytes Size of the encoded data, in bytes
+    ///
+    /// \return Decoded samples, or a null pointer if decoding failed
+    ///
+    ////////////////////////////////////////////////////////////
+    static const std::vector<Int16>* acquire(Uint64 id, const void* data, std::size_t sizeInBytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode contents into the cache, if they are not in it already
+    ///
+    /// This lets the decoding happen ahead of time, on the
+    /// calling thread, rather than in the first call to acquire.
+    ///
+    /// \param id          Identifier of the contents
+    /// \param data        Pointer to the encoded file data
+    /// \param sizeInBytes Size of the encoded data, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    static void prefetch(Uint64 id, const void* data, std::size_t sizeInBytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Unpin decoded samples
+    ///
+    /// \param id Identifier of the contents
+    ///
+    ////////////////////////////////////////////////////////////
+    static void release(Uint64 id);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove decoded samples from the cache
+    ///
+    /// Pinned samples are removed when they are released.
+    ///
+    /// \param id Identifier of the contents
+    ///
+    ////////////////////////////////////////////////////////////
+    static void remove(Uint64 id);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the maximum size of the decoded samples kept
+    ///        when they are not in use
+    ///
+    /// \param sizeInBytes New capacity, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setCapacity(std::size_t sizeInBytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the total size of the decoded samples in the cache
+    ///
+    /// \return Size of the decoded samples, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::size_t getSize();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Evict unpinned entries until the cache fits its capacity
+    ///
+    /// The cache mutex must be locked.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void evict();
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_DECODEDSOUNDCACHE_HPP
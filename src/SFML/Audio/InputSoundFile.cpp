@@ -33,7 +33,17 @@
 #include <SFML/System/MemoryInputStream.hpp>
 #include <SFML/System/Err.hpp>
 #include <iostream>
+#include <fstream>
 #include <algorithm>
+#include <vector>
+
+
+namespace
+{
+    // Identification of the seek table files
+    const sf::Uint32 seekTableMagic   = 0x54534653; // "SFST"
+    const sf::Uint32 seekTableVersion = 1;
+}
 
 
 namespace sf
@@ -255,6 +265,77 @@ Uint64 InputSoundFile::read(Int16* samples, Uint64 maxCount)
 }
 
 
+////////////////////////////////////////////////////////////
+Uint64 InputSoundFile::read(float* samples, Uint64 maxCount)
+{
+    Uint64 readSamples = 0;
+    if (m_reader && samples && maxCount)
+        readSamples = m_reader->readFloat(samples, maxCount);
+    m_sampleOffset += readSamples;
+    return readSamples;
+}
+
+
+////////////////////////////////////////////////////////////
+bool InputSoundFile::saveSeekTable(const std::string& filename)
+{
+    std::vector<SoundFileReader::SeekPoint> table;
+    if (!m_reader || !m_reader->getSeekTable(table))
+        return false;
+
+    std::ofstream file(filename.c_str(), std::ios_base::binary | std::ios_base::trunc);
+    if (!file)
+    {
+        err() << "Failed to save seek table \"" << filename << "\" (couldn't open file)" << std::endl;
+        return false;
+    }
+
+    Uint32 header[2] = {seekTableMagic, seekTableVersion};
+    Uint64 count = table.size();
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    for (std::size_t i = 0; i < table.size(); ++i)
+    {
+        Uint64 point[2] = {table[i].sampleOffset, table[i].byteOffset};
+        file.write(reinterpret_cast<const char*>(point), sizeof(point));
+    }
+
+    return static_cast<bool>(file);
+}
+
+
+////////////////////////////////////////////////////////////
+bool InputSoundFile::loadSeekTable(const std::string& filename)
+{
+    if (!m_reader)
+        return false;
+
+    std::ifstream file(filename.c_str(), std::ios_base::binary);
+    if (!file)
+        return false;
+
+    Uint32 header[2] = {0, 0};
+    Uint64 count = 0;
+    file.read(reinterpret_cast<char*>(header), sizeof(header));
+    file.read(reinterpret_cast<char*>(&count), sizeof(count));
+    if (!file || (header[0] != seekTableMagic) || (header[1] != seekTableVersion))
+        return false;
+
+    std::vector<SoundFileReader::SeekPoint> table;
+    for (Uint64 i = 0; i < count; ++i)
+    {
+        Uint64 point[2];
+        if (!file.read(reinterpret_cast<char*>(point), sizeof(point)))
+            return false;
+
+        SoundFileReader::SeekPoint seekPoint = {point[0], point[1]};
+        table.push_back(seekPoint);
+    }
+
+    return m_reader->setSeekTable(table);
+}
+
+
 ////////////////////////////////////////////////////////////
 void InputSoundFile::close()
 {
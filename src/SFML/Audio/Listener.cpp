@@ -107,4 +107,18 @@ Vector3f Listener::getUpVector()
     return priv::AudioDevice::getUpVector();
 }
 
+
+////////////////////////////////////////////////////////////
+void Listener::beginUpdate()
+{
+    priv::AudioDevice::beginDeferredUpdates();
+}
+
+
+////////////////////////////////////////////////////////////
+void Listener::endUpdate()
+{
+    priv::AudioDevice::endDeferredUpdates();
+}
+
 } // namespace sf
@@ -0,0 +1,403 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2023 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/MixBus.hpp>
+#include <SFML/Audio/SoundBuffer.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    const float pi = 3.14159265358979f;
+
+    // Mix frames at the rate of the bus; the loops are written so that compilers can vectorize them
+    template <typename T>
+    void mixFrames(const T* input, unsigned int channelCount, float* output, std::size_t frameCount, float leftGain, float rightGain)
+    {
+        if (channelCount == 1)
+        {
+            for (std::size_t i = 0; i < frameCount; ++i)
+            {
+                float sample = static_cast<float>(input[i]);
+                output[2 * i]     += sample * leftGain;
+                output[2 * i + 1] += sample * rightGain;
+            }
+        }
+        else
+        {
+            for (std::size_t i = 0; i < frameCount; ++i)
+            {
+                output[2 * i]     += static_cast<float>(input[i * channelCount])     * leftGain;
+                output[2 * i + 1] += static_cast<float>(input[i * channelCount + 1]) * rightGain;
+            }
+        }
+    }
+
+    // Mix frames resampled by linear interpolation; all the interpolated frames must be inside the input
+    template <typename T>
+    void mixResampledFrames(const T* input, unsigned int channelCount, float* output, std::size_t frameCount,
+                            double start, double step, float leftGain, float rightGain)
+    {
+        for (std::size_t i = 0; i < frameCount; ++i)
+        {
+            double position = start + static_cast<double>(i) * step;
+            std::size_t index = static_cast<std::size_t>(position);
+            float fraction = static_cast<float>(position - static_cast<double>(index));
+
+            const T* current = input + index * channelCount;
+            const T* next = current + channelCount;
+
+            float left = static_cast<float>(current[0]) + (static_cast<float>(next[0]) - static_cast<float>(current[0])) * fraction;
+            float right = left;
+            if (channelCount > 1)
+                right = static_cast<float>(current[1]) + (static_cast<float>(next[1]) - static_cast<float>(current[1])) * fraction;
+
+            output[2 * i]     += left * leftGain;
+            output[2 * i + 1] += right * rightGain;
+        }
+    }
+
+    // Coefficient of a one-pole low-pass filter
+    float onePoleCoefficient(float cutoff, unsigned int sampleRate)
+    {
+        return 1.f - std::exp(-2.f * pi * cutoff / static_cast<float>(sampleRate));
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+MixBus::MixBus(unsigned int sampleRate) :
+m_nextId        (1),
+m_lowPassCutoff (0.f),
+m_highPassCutoff(0.f)
+{
+    m_lowPassState[0] = m_lowPassState[1] = 0.f;
+    m_highPassState[0] = m_highPassState[1] = 0.f;
+
+    setChunkDuration(milliseconds(50));
+    initialize(2, sampleRate, Float32Samples);
+}
+
+
+////////////////////////////////////////////////////////////
+MixBus::~MixBus()
+{
+    // We must stop before destroying the voices, as the streaming thread mixes them
+    stop();
+}
+
+
+////////////////////////////////////////////////////////////
+MixBus::VoiceId MixBus::playVoice(const SoundBuffer& buffer, float volume, float pan)
+{
+    Voice voice;
+    voice.buffer   = &buffer;
+    voice.volume   = volume;
+    voice.pitch    = 1.f;
+    voice.pan      = pan;
+    voice.loop     = false;
+    voice.position = 0.0;
+
+    Lock lock(m_mutex);
+
+    VoiceId id = m_nextId++;
+    m_voices.insert(std::make_pair(id, voice));
+
+    return id;
+}
+
+
+////////////////////////////////////////////////////////////
+void MixBus::stopVoice(VoiceId voice)
+{
+    Lock lock(m_mutex);
+    m_voices.erase(voice);
+}
+
+
+////////////////////////////////////////////////////////////
+void MixBus::stopAllVoices()
+{
+    Lock lock(m_mutex);
+    m_voices.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+bool MixBus::isVoicePlaying(VoiceId voice) const
+{
+    Lock lock(m_mutex);
+    return m_voices.find(voice) != m_voices.end();
+}
+
+
+////////////////////////////////////////////////////////////
+void MixBus::setVoiceVolume(VoiceId voice, float volume)
+{
+    Lock lock(m_mutex);
+
+    VoiceMap::iterator it = m_voices.find(voice);
+    if (it != m_voices.end())
+        it->second.volume = volume;
+}
+
+
+////////////////////////////////////////////////////////////
+void MixBus::setVoicePitch(VoiceId voice, float pitch)
+{
+    Lock lock(m_mutex);
+
+    VoiceMap::iterator it = m_voices.find(voice);
+    if (it != m_voices.end())
+        it->second.pitch = pitch;
+}
+
+
+////////////////////////////////////////////////////////////
+void MixBus::setVoicePan(VoiceId voice, float pan)
+{
+    Lock lock(m_mutex);
+
+    VoiceMap::iterator it = m_voices.find(voice);
+    if (it != m_voices.end())
+        it->second.pan = pan;
+}
+
+
+////////////////////////////////////////////////////////////
+void MixBus::setVoiceLoop(VoiceId voice, bool loop)
+{
+    Lock lock(m_mutex);
+
+    VoiceMap::iterator it = m_voices.find(voice);
+    if (it != m_voices.end())
+        it->second.loop = loop;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int MixBus::getVoiceCount() const
+{
+    Lock lock(m_mutex);
+    return static_cast<unsigned int>(m_voices.size());
+}
+
+
+////////////////////////////////////////////////////////////
+void MixBus::setLowPassCutoff(float frequency)
+{
+    Lock lock(m_mutex);
+    m_lowPassCutoff = frequency;
+}
+
+
+////////////////////////////////////////////////////////////
+void MixBus::setHighPassCutoff(float frequency)
+{
+    Lock lock(m_mutex);
+    m_highPassCutoff = frequency;
+}
+
+
+////////////////////////////////////////////////////////////
+bool MixBus::onGetData(Chunk& data)
+{
+    Lock lock(m_mutex);
+
+    std::size_t frameCount = static_cast<std::size_t>(getChunkDuration().asSeconds() * static_cast<float>(getSampleRate()));
+    frameCount = std::max(frameCount, static_cast<std::size_t>(1));
+    m_mix.assign(frameCount * 2, 0.f);
+
+    // Mix the voices, and forget the finished ones
+    for (VoiceMap::iterator it = m_voices.begin(); it != m_voices.end();)
+    {
+        if (mixVoice(it->second, frameCount))
+            ++it;
+        else
+            m_voices.erase(it++);
+    }
+
+    applyFilters(frameCount);
+
+    data.samples      = NULL;
+    data.floatSamples = &m_mix[0];
+    data.sampleCount  = m_mix.size();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void MixBus::onSeek(Time /*timeOffset*/)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool MixBus::mixVoice(Voice& voice, std::size_t frameCount)
+{
+    const SoundBuffer& buffer = *voice.buffer;
+
+    unsigned int channelCount = buffer.getChannelCount();
+    if (channelCount == 0)
+        return false;
+
+    std::size_t bufferFrames = static_cast<std::size_t>(buffer.getSampleCount() / channelCount);
+    if (bufferFrames == 0)
+        return false;
+
+    // A null or negative pitch freezes the voice
+    double step = static_cast<double>(voice.pitch) * buffer.getSampleRate() / getSampleRate();
+    if (step <= 0.0)
+        return true;
+
+    // Mono voices are panned with a constant power law, the other ones are balanced
+    float volume = voice.volume * 0.01f;
+    float pan = std::min(std::max(voice.pan, -1.f), 1.f);
+    float leftGain;
+    float rightGain;
+    if (channelCount == 1)
+    {
+        float angle = (pan + 1.f) * pi / 4.f;
+        leftGain  = volume * std::cos(angle);
+        rightGain = volume * std::sin(angle);
+    }
+    else
+    {
+        leftGain  = volume * std::min(1.f, 1.f - pan);
+        rightGain = volume * std::min(1.f, 1.f + pan);
+    }
+
+    // Fold the normalization of integer samples into the gains
+    bool isFloat = (buffer.getSampleFormat() == Float32Samples);
+    if (!isFloat)
+    {
+        leftGain  /= 32768.f;
+        rightGain /= 32768.f;
+    }
+
+    const Int16* samples = buffer.getSamples();
+    const float* floatSamples = buffer.getFloatSamples();
+
+    // Buffers which released their samples can't be mixed
+    if ((isFloat && !floatSamples) || (!isFloat && !samples))
+        return false;
+
+    std::size_t mixed = 0;
+    while (mixed < frameCount)
+    {
+        if (voice.position >= static_cast<double>(bufferFrames))
+        {
+            if (!voice.loop)
+                return false;
+
+            voice.position = std::fmod(voice.position, static_cast<double>(bufferFrames));
+        }
+
+        float* output = &m_mix[mixed * 2];
+        std::size_t remaining = frameCount - mixed;
+        std::size_t index = static_cast<std::size_t>(voice.position);
+        std::size_t count;
+
+        if ((step == 1.0) && (voice.position == static_cast<double>(index)))
+        {
+            // Same rate as the bus: mix the samples directly
+            count = std::min(remaining, bufferFrames - index);
+            if (isFloat)
+                mixFrames(floatSamples + index * channelCount, channelCount, output, count, leftGain, rightGain);
+            else
+                mixFrames(samples + index * channelCount, channelCount, output, count, leftGain, rightGain);
+
+            voice.position += static_cast<double>(count);
+        }
+        else if (index + 1 < bufferFrames)
+        {
+            // Resample the frames which can be interpolated with their successor
+            double last = static_cast<double>(bufferFrames - 1);
+            count = static_cast<std::size_t>(std::ceil((last - voice.position) / step));
+            if ((count > 1) && (voice.position + static_cast<double>(count - 1) * step >= last))
+                --count;
+            count = std::min(std::max(count, static_cast<std::size_t>(1)), remaining);
+
+            if (isFloat)
+                mixResampledFrames(floatSamples, channelCount, output, count, voice.position, step, leftGain, rightGain);
+            else
+                mixResampledFrames(samples, channelCount, output, count, voice.position, step, leftGain, rightGain);
+
+            voice.position += static_cast<double>(count) * step;
+        }
+        else
+        {
+            // The last frame has no successor to interpolate with
+            count = 1;
+            if (isFloat)
+                mixFrames(floatSamples + index * channelCount, channelCount, output, count, leftGain, rightGain);
+            else
+                mixFrames(samples + index * channelCount, channelCount, output, count, leftGain, rightGain);
+
+            voice.position += step;
+        }
+
+        mixed += count;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void MixBus::applyFilters(std::size_t frameCount)
+{
+    if (m_highPassCutoff > 0.f)
+    {
+        float coefficient = onePoleCoefficient(m_highPassCutoff, getSampleRate());
+        for (std::size_t i = 0; i < frameCount * 2; ++i)
+        {
+            float& state = m_highPassState[i % 2];
+            state += coefficient * (m_mix[i] - state);
+            m_mix[i] -= state;
+        }
+    }
+
+    if (m_lowPassCutoff > 0.f)
+    {
+        float coefficient = onePoleCoefficient(m_lowPassCutoff, getSampleRate());
+        for (std::size_t i = 0; i < frameCount * 2; ++i)
+        {
+            float& state = m_lowPassState[i % 2];
+            state += coefficient * (m_mix[i] - state);
+            m_mix[i] = state;
+        }
+    }
+}
+
+} // namespace sf
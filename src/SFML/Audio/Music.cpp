@@ -27,6 +27,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/Music.hpp>
 #include <SFML/Audio/ALCheck.hpp>
+#include <SFML/Audio/ReadAheadDecoder.hpp>
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
 #include <fstream>
@@ -44,10 +45,12 @@ namespace sf
 {
 ////////////////////////////////////////////////////////////
 Music::Music() :
-m_file      (),
-m_loopSpan  (0, 0)
+m_file        (),
+m_sampleFormat(Int16Samples),
+m_loopSpan    (0, 0),
+m_decoder     (NULL)
 {
-
+    m_decoder = new priv::ReadAheadDecoder(m_file, m_mutex);
 }
 
 
@@ -56,6 +59,8 @@ Music::~Music()
 {
     // We must stop before destroying the file
     stop();
+
+    delete m_decoder;
 }
 
 
@@ -65,6 +70,9 @@ bool Music::openFromFile(const std::string& filename)
     // First stop the music if it was already running
     stop();
 
+    // The read-ahead decoder must not access the file meanwhile
+    Lock lock(m_mutex);
+
     // Open the underlying sound file
     if (!m_file.openFromFile(filename))
         return false;
@@ -82,6 +90,9 @@ bool Music::openFromMemory(const void* data, std::size_t sizeInBytes)
     // First stop the music if it was already running
     stop();
 
+    // The read-ahead decoder must not access the file meanwhile
+    Lock lock(m_mutex);
+
     // Open the underlying sound file
     if (!m_file.openFromMemory(data, sizeInBytes))
         return false;
@@ -99,6 +110,9 @@ bool Music::openFromStream(InputStream& stream)
     // First stop the music if it was already running
     stop();
 
+    // The read-ahead decoder must not access the file meanwhile
+    Lock lock(m_mutex);
+
     // Open the underlying sound file
     if (!m_file.openFromStream(stream))
         return false;
@@ -110,6 +124,45 @@ bool Music::openFromStream(InputStream& stream)
 }
 
 
+////////////////////////////////////////////////////////////
+void Music::setSampleFormat(SampleFormat sampleFormat)
+{
+    // The stream can't change its format while playing
+    stop();
+
+    m_sampleFormat = sampleFormat;
+
+    // Apply the new format right away if a music is open
+    if (m_file.getChannelCount() != 0)
+    {
+        Lock lock(m_mutex);
+        SoundStream::initialize(m_file.getChannelCount(), m_file.getSampleRate(), m_sampleFormat);
+        m_decoder->reset(m_sampleFormat, 2 * getChunkSampleCount());
+
+        if (m_sampleFormat == Float32Samples)
+            m_floatSamples.resize(getChunkSampleCount());
+        else
+            m_samples.resize(getChunkSampleCount());
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool Music::saveSeekTable(const std::string& filename)
+{
+    Lock lock(m_mutex);
+    return m_file.saveSeekTable(filename);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Music::loadSeekTable(const std::string& filename)
+{
+    Lock lock(m_mutex);
+    return m_file.loadSeekTable(filename);
+}
+
+
 ////////////////////////////////////////////////////////////
 Time Music::getDuration() const
 {
@@ -186,33 +239,56 @@ void Music::setLoopPoints(TimeSpan timePoints)
 ////////////////////////////////////////////////////////////
 bool Music::onGetData(SoundStream::Chunk& data)
 {
-    Lock lock(m_mutex);
+    // Follow changes of the preferred chunk duration and of the loop settings
+    std::size_t toFill = getChunkSampleCount();
+    m_decoder->setCapacity(2 * toFill);
+    m_decoder->setLoop(getLoop(), m_loopSpan.offset, m_loopSpan.length);
+
+    // Copy the samples which were decoded ahead; the decoder stops at
+    // the loop end point, which will trip an "onLoop()" call from the
+    // underlying SoundStream, and we can then take action.
+    std::size_t count = 0;
+    bool continued = false;
+    if (getSampleFormat() == Float32Samples)
+    {
+        if (m_floatSamples.size() < toFill)
+            m_floatSamples.resize(toFill);
 
-    std::size_t toFill = m_samples.size();
-    Uint64 currentOffset = m_file.getSampleOffset();
-    Uint64 loopEnd = m_loopSpan.offset + m_loopSpan.length;
+        data.floatSamples = &m_floatSamples[0];
+        continued = m_decoder->read(&m_floatSamples[0], toFill, count);
+    }
+    else
+    {
+        if (m_samples.size() < toFill)
+            m_samples.resize(toFill);
 
-    // If the loop end is enabled and imminent, request less data.
-    // This will trip an "onLoop()" call from the underlying SoundStream,
-    // and we can then take action.
-    if (getLoop() && (m_loopSpan.length != 0) && (currentOffset <= loopEnd) && (currentOffset + toFill > loopEnd))
-        toFill = static_cast<std::size_t>(loopEnd - currentOffset);
+        data.samples = &m_samples[0];
+        continued = m_decoder->read(&m_samples[0], toFill, count);
+    }
+
+    // The decoding thread is late: play a short silence while it catches up, rather than stopping
+    if ((count == 0) && continued)
+    {
+        std::size_t frameCount = std::max(getSampleRate() / 50, 1u);
+        count = std::min<std::size_t>(toFill, frameCount * getChannelCount());
+        if (getSampleFormat() == Float32Samples)
+            std::fill(m_floatSamples.begin(), m_floatSamples.begin() + static_cast<std::ptrdiff_t>(count), 0.f);
+        else
+            std::fill(m_samples.begin(), m_samples.begin() + static_cast<std::ptrdiff_t>(count), Int16(0));
+    }
 
-    // Fill the chunk parameters
-    data.samples = &m_samples[0];
-    data.sampleCount = static_cast<std::size_t>(m_file.read(&m_samples[0], toFill));
-    currentOffset += data.sampleCount;
+    data.sampleCount = count;
 
     // Check if we have stopped obtaining samples or reached either the EOF or the loop end point
-    return (data.sampleCount != 0) && (currentOffset < m_file.getSampleCount()) && !(currentOffset == loopEnd && m_loopSpan.length != 0);
+    return (count != 0) && continued;
 }
 
 
 ////////////////////////////////////////////////////////////
 void Music::onSeek(Time timeOffset)
 {
-    Lock lock(m_mutex);
-    m_file.seek(timeOffset);
+    // Only flush the samples decoded ahead, the decoder seeks the file asynchronously
+    m_decoder->seek(static_cast<Uint64>(timeOffset.asSeconds() * static_cast<float>(m_file.getSampleRate())) * m_file.getChannelCount());
 }
 
 
@@ -220,19 +296,23 @@ void Music::onSeek(Time timeOffset)
 Int64 Music::onLoop()
 {
     // Called by underlying SoundStream so we can determine where to loop.
-    Lock lock(m_mutex);
-    Uint64 currentOffset = m_file.getSampleOffset();
+    // If looping was already enabled, the decoder is already there
+    Uint64 nextOffset = 0;
+    if (m_decoder->endSegment(nextOffset))
+        return static_cast<Int64>(nextOffset);
+
+    Uint64 currentOffset = m_decoder->getReadOffset();
     if (getLoop() && (m_loopSpan.length != 0) && (currentOffset == m_loopSpan.offset + m_loopSpan.length))
     {
         // Looping is enabled, and either we're at the loop end, or we're at the EOF
         // when it's equivalent to the loop end (loop end takes priority). Send us to loop begin
-        m_file.seek(m_loopSpan.offset);
-        return static_cast<Int64>(m_file.getSampleOffset());
+        m_decoder->seek(m_loopSpan.offset);
+        return static_cast<Int64>(m_decoder->getReadOffset());
     }
     else if (getLoop() && (currentOffset >= m_file.getSampleCount()))
     {
         // If we're at the EOF, reset to 0
-        m_file.seek(0);
+        m_decoder->seek(0);
         return 0;
     }
     return NoLoop;
@@ -246,11 +326,32 @@ void Music::initialize()
     m_loopSpan.offset = 0;
     m_loopSpan.length = m_file.getSampleCount();
 
-    // Resize the internal buffer so that it can contain 1 second of audio samples
-    m_samples.resize(m_file.getSampleRate() * m_file.getChannelCount());
-
     // Initialize the stream
-    SoundStream::initialize(m_file.getChannelCount(), m_file.getSampleRate());
+    SoundStream::initialize(m_file.getChannelCount(), m_file.getSampleRate(), m_sampleFormat);
+
+    // Decode up to two chunks ahead of the stream
+    m_decoder->reset(m_sampleFormat, 2 * getChunkSampleCount());
+
+    // Resize the internal buffer so that it can contain one chunk of audio samples
+    if (m_sampleFormat == Float32Samples)
+    {
+        std::vector<Int16>().swap(m_samples);
+        m_floatSamples.resize(getChunkSampleCount());
+    }
+    else
+    {
+        std::vector<float>().swap(m_floatSamples);
+        m_samples.resize(getChunkSampleCount());
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Music::getChunkSampleCount() const
+{
+    // Always provide at least one sample per channel
+    Uint64 frames = static_cast<Uint64>(getChunkDuration().asMicroseconds()) * m_file.getSampleRate() / 1000000;
+    return static_cast<std::size_t>(std::max<Uint64>(frames, 1)) * m_file.getChannelCount();
 }
 
 ////////////////////////////////////////////////////////////
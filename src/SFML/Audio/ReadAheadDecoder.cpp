@@ -0,0 +1,446 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2023 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/ReadAheadDecoder.hpp>
+#include <SFML/Audio/InputSoundFile.hpp>
+#include <SFML/System/Thread.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Sleep.hpp>
+#include <algorithm>
+#include <vector>
+
+
+namespace
+{
+    // The decoding thread, shared by all the decoders
+    sf::Thread* thread = NULL;
+
+    // Registered decoders, and the mutex protecting them
+    // (it is held during a whole decoding pass)
+    std::vector<sf::priv::ReadAheadDecoder*> decoders;
+    bool running = false;
+    sf::Mutex decodersMutex;
+
+    // Maximum number of samples decoded at once, so that
+    // a single file can't hold the other ones for too long
+    const std::size_t sliceSize = 16384;
+
+    // Period of the decoding passes when no decoder has work to do
+    const sf::Time idleInterval = sf::milliseconds(5);
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+ReadAheadDecoder::ReadAheadDecoder(InputSoundFile& file, Mutex& fileMutex) :
+m_file        (file),
+m_fileMutex   (fileMutex),
+m_sampleFormat(Int16Samples),
+m_ring        (),
+m_floatRing   (),
+m_segmentEnds (),
+m_readOffset  (0),
+m_seekOffset  (0),
+m_seekPending (false),
+m_ended       (true),
+m_loop        (false),
+m_loopOffset  (0),
+m_loopLength  (0)
+{
+    Lock lock(decodersMutex);
+
+    decoders.push_back(this);
+
+    // If this is the very first decoder, start the decoding thread
+    if (!thread)
+    {
+        running = true;
+        thread = new Thread(&ReadAheadDecoder::run);
+        thread->launch();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+ReadAheadDecoder::~ReadAheadDecoder()
+{
+    Thread* stoppedThread = NULL;
+
+    {
+        // Wait until the current decoding pass is over
+        Lock lock(decodersMutex);
+
+        decoders.erase(std::find(decoders.begin(), decoders.end(), this));
+
+        // If there's no more decoder, we can stop the decoding thread
+        if (decoders.empty())
+        {
+            running = false;
+            stoppedThread = thread;
+            thread = NULL;
+        }
+    }
+
+    if (stoppedThread)
+    {
+        stoppedThread->wait();
+        delete stoppedThread;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void ReadAheadDecoder::reset(SampleFormat sampleFormat, std::size_t capacity)
+{
+    Lock lock(m_mutex);
+
+    m_sampleFormat = sampleFormat;
+
+    // Only allocate the ring buffer of the current format
+    m_ring.resize((sampleFormat == Int16Samples) ? capacity : 0);
+    m_floatRing.resize((sampleFormat == Float32Samples) ? capacity : 0);
+
+    m_segmentEnds.clear();
+    m_readOffset  = 0;
+    m_seekOffset  = 0;
+    m_seekPending = true;
+    m_ended       = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void ReadAheadDecoder::setCapacity(std::size_t capacity)
+{
+    // Most of the time the capacity doesn't change: don't wait for the decoding thread then
+    {
+        Lock lock(m_mutex);
+
+        std::size_t current = (m_sampleFormat == Float32Samples) ? m_floatRing.getCapacity() : m_ring.getCapacity();
+        if (current == capacity)
+            return;
+    }
+
+    // The file mutex keeps the decoding thread away from the ring buffer while it is resized
+    Lock fileLock(m_fileMutex);
+    Lock lock(m_mutex);
+
+    if (m_sampleFormat == Float32Samples)
+    {
+        if (m_floatRing.getCapacity() == capacity)
+            return;
+
+        m_floatRing.resize(capacity);
+    }
+    else
+    {
+        if (m_ring.getCapacity() == capacity)
+            return;
+
+        m_ring.resize(capacity);
+    }
+
+    // The samples decoded ahead were lost
+    flush(m_readOffset);
+}
+
+
+////////////////////////////////////////////////////////////
+void ReadAheadDecoder::setLoop(bool loop, Uint64 loopOffset, Uint64 loopLength)
+{
+    Lock lock(m_mutex);
+
+    if ((loop == m_loop) && (loopOffset == m_loopOffset) && (loopLength == m_loopLength))
+        return;
+
+    m_loop       = loop;
+    m_loopOffset = loopOffset;
+    m_loopLength = loopLength;
+
+    // The segments decoded so far were computed with the previous settings
+    flush(m_readOffset);
+}
+
+
+////////////////////////////////////////////////////////////
+void ReadAheadDecoder::seek(Uint64 sampleOffset)
+{
+    // Apply the same adjustments as the file, to keep our known position consistent
+    unsigned int channelCount = m_file.getChannelCount();
+    if (channelCount != 0)
+        sampleOffset = std::min(sampleOffset / channelCount * channelCount, m_file.getSampleCount());
+
+    Lock lock(m_mutex);
+
+    // The decoded samples already start at the requested position
+    if (sampleOffset == m_readOffset)
+        return;
+
+    flush(sampleOffset);
+}
+
+
+////////////////////////////////////////////////////////////
+bool ReadAheadDecoder::read(Int16* samples, std::size_t maxCount, std::size_t& count)
+{
+    return read(m_ring, samples, maxCount, count);
+}
+
+
+////////////////////////////////////////////////////////////
+bool ReadAheadDecoder::read(float* samples, std::size_t maxCount, std::size_t& count)
+{
+    return read(m_floatRing, samples, maxCount, count);
+}
+
+
+////////////////////////////////////////////////////////////
+bool ReadAheadDecoder::endSegment(Uint64& nextOffset)
+{
+    Lock lock(m_mutex);
+
+    Uint64 readCount = (m_sampleFormat == Float32Samples) ? m_floatRing.getReadCount() : m_ring.getReadCount();
+    if (m_segmentEnds.empty() || (m_segmentEnds.front().position != readCount))
+        return false;
+
+    SegmentEnd end = m_segmentEnds.front();
+    m_segmentEnds.pop_front();
+
+    if (!end.continued)
+        return false;
+
+    m_readOffset = end.nextOffset;
+    nextOffset = end.nextOffset;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 ReadAheadDecoder::getReadOffset() const
+{
+    Lock lock(m_mutex);
+
+    return m_readOffset;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ReadAheadDecoder::decode()
+{
+    Lock lock(m_fileMutex);
+
+    // Nothing to decode if no file is open
+    if (m_file.getChannelCount() == 0)
+        return false;
+
+    return (m_sampleFormat == Float32Samples) ? decode(m_floatRing) : decode(m_ring);
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+bool ReadAheadDecoder::decode(RingBuffer<T>& ring)
+{
+    T*          region     = NULL;
+    std::size_t writable   = 0;
+    bool        seek       = false;
+    Uint64      seekOffset = 0;
+    bool        loop       = false;
+    Uint64      loopOffset = 0;
+    Uint64      loopEnd    = 0;
+
+    {
+        Lock lock(m_mutex);
+
+        seek = m_seekPending;
+        seekOffset = m_seekOffset;
+        m_seekPending = false;
+
+        if (m_ended && !seek)
+            return false;
+
+        // Starting the write now binds it to the current seek: if the
+        // consumer seeks again meanwhile, the samples will be discarded
+        writable = ring.beginWrite(region);
+
+        loop = m_loop;
+        loopOffset = m_loopOffset;
+        loopEnd = m_loopOffset + m_loopLength;
+        if (m_loopLength == 0)
+            loopEnd = m_file.getSampleCount();
+    }
+
+    if (seek)
+        m_file.seek(seekOffset);
+
+    if (writable == 0)
+        return seek;
+
+    // Stop at the loop end point if looping is enabled and it is ahead, or at the end of the file
+    Uint64 offset = m_file.getSampleOffset();
+    Uint64 end = (loop && (offset <= loopEnd)) ? loopEnd : m_file.getSampleCount();
+
+    std::size_t toRead = static_cast<std::size_t>(std::min<Uint64>(std::min(writable, sliceSize), end - offset));
+    std::size_t count = (toRead > 0) ? static_cast<std::size_t>(m_file.read(region, toRead)) : 0;
+    offset += count;
+
+    // A read error ends the file as well
+    bool segmentEnded = (count == 0) || (offset >= end);
+
+    SegmentEnd segmentEnd;
+    segmentEnd.continued = false;
+    segmentEnd.nextOffset = 0;
+    if (segmentEnded && loop && (offset == loopEnd))
+    {
+        segmentEnd.continued = true;
+        segmentEnd.nextOffset = loopOffset;
+    }
+    else if (segmentEnded && loop && (offset >= m_file.getSampleCount()))
+    {
+        segmentEnd.continued = true;
+        segmentEnd.nextOffset = 0;
+    }
+
+    {
+        Lock lock(m_mutex);
+
+        // Discard the samples if the consumer has seeked meanwhile
+        if (!ring.endWrite(count))
+            return true;
+
+        if (segmentEnded)
+        {
+            segmentEnd.position = ring.getWriteCount();
+            m_segmentEnds.push_back(segmentEnd);
+            m_ended = !segmentEnd.continued;
+        }
+    }
+
+    // Continue with the next segment right away
+    if (segmentEnded && segmentEnd.continued)
+        m_file.seek(segmentEnd.nextOffset);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+bool ReadAheadDecoder::read(RingBuffer<T>& ring, T* samples, std::size_t maxCount, std::size_t& count)
+{
+    count = 0;
+
+    std::size_t available = 0;
+    for (;;)
+    {
+        {
+            Lock lock(m_mutex);
+
+            available = ring.getReadableCount();
+
+            // Don't read past the end of the current segment
+            if (!m_segmentEnds.empty())
+            {
+                Uint64 untilEnd = m_segmentEnds.front().position - ring.getReadCount();
+                if (untilEnd == 0)
+                    return false;
+
+                available = static_cast<std::size_t>(std::min<Uint64>(available, untilEnd));
+            }
+        }
+
+        if (available > 0)
+            break;
+
+        // Right after a seek nothing was decoded yet: rather than waiting for the decoding thread,
+        // which may be busy with other files, decode the first samples right away (the file mutex
+        // makes sure that a single producer writes to the ring buffer); later on, let the decoding
+        // thread catch up and report the underrun
+        if (ring.getWriteCount() > 0)
+            return true;
+
+        if (!decode())
+            return false;
+    }
+
+    // Copy the samples out of the ring buffer
+    count = ring.read(samples, std::min(maxCount, available));
+
+    Lock lock(m_mutex);
+
+    m_readOffset += count;
+
+    return m_segmentEnds.empty() || (m_segmentEnds.front().position != ring.getReadCount());
+}
+
+
+////////////////////////////////////////////////////////////
+void ReadAheadDecoder::flush(Uint64 sampleOffset)
+{
+    m_ring.clear();
+    m_floatRing.clear();
+    m_segmentEnds.clear();
+    m_readOffset  = sampleOffset;
+    m_seekOffset  = sampleOffset;
+    m_seekPending = true;
+    m_ended       = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void ReadAheadDecoder::run()
+{
+    for (;;)
+    {
+        bool busy = false;
+
+        {
+            Lock lock(decodersMutex);
+
+            if (!running)
+                break;
+
+            for (std::vector<ReadAheadDecoder*>::iterator it = decoders.begin(); it != decoders.end(); ++it)
+            {
+                if ((*it)->decode())
+                    busy = true;
+            }
+        }
+
+        // Leave some time for the other threads when there's nothing to decode
+        if (!busy)
+            sleep(idleInterval);
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,272 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2023 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_READAHEADDECODER_HPP
+#define SFML_READAHEADDECODER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/RingBuffer.hpp>
+#include <SFML/Audio/SampleFormat.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <deque>
+
+
+namespace sf
+{
+class InputSoundFile;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Decoder of a sound file running ahead of its
+///        consumer, in a shared decoding thread
+///
+/// The decoding thread fills a ring buffer with the samples
+/// of the file; the consumer (the streaming side of sf::Music)
+/// only copies samples out of it, and never waits for the file
+/// except right after a seek.
+///
+/// The decoded samples are split into segments: a segment
+/// ends at the loop end point or at the end of the file. When
+/// looping is enabled, the decoder continues with the next
+/// segment right away, at the loop start point.
+///
+////////////////////////////////////////////////////////////
+class ReadAheadDecoder : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Constructor
+    ///
+    /// The decoder is registered into the decoding thread, which
+    /// is started with the first decoder.
+    ///
+    /// \param file      Sound file to decode
+    /// \param fileMutex Mutex protecting the file
+    ///
+    ////////////////////////////////////////////////////////////
+    ReadAheadDecoder(InputSoundFile& file, Mutex& fileMutex);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The decoding thread is stopped with the last decoder.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ReadAheadDecoder();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Restart decoding from the beginning of the file
+    ///
+    /// This function must be called with the file mutex locked,
+    /// while the consumer is inactive.
+    ///
+    /// \param sampleFormat Format of the decoded samples
+    /// \param capacity     Maximum number of samples decoded ahead
+    ///
+    ////////////////////////////////////////////////////////////
+    void reset(SampleFormat sampleFormat, std::size_t capacity);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the maximum number of samples decoded ahead
+    ///
+    /// This function is called by the consumer. It has no effect
+    /// if the capacity doesn't change; otherwise the samples
+    /// decoded ahead are discarded, and decoded again from the
+    /// current read position.
+    ///
+    /// \param capacity Maximum number of samples decoded ahead
+    ///
+    ////////////////////////////////////////////////////////////
+    void setCapacity(std::size_t capacity);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the loop settings
+    ///
+    /// The samples decoded ahead are discarded if the settings
+    /// changed. This function is called by the consumer.
+    ///
+    /// \param loop       Is looping enabled?
+    /// \param loopOffset Loop start point, in samples
+    /// \param loopLength Loop length, in samples (0 to loop the whole file)
+    ///
+    ////////////////////////////////////////////////////////////
+    void setLoop(bool loop, Uint64 loopOffset, Uint64 loopLength);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the read position
+    ///
+    /// This function is called by the consumer. It returns
+    /// immediately: the samples decoded ahead are discarded,
+    /// and the decoding thread seeks the file asynchronously.
+    ///
+    /// \param sampleOffset New read position, in samples
+    ///
+    ////////////////////////////////////////////////////////////
+    void seek(Uint64 sampleOffset);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read 16-bit samples
+    ///
+    /// This function is called by the consumer. When no sample
+    /// was decoded yet since the last seek, it decodes them
+    /// itself rather than waiting for the decoding thread.
+    /// Otherwise it never decodes: if the decoding thread is
+    /// late, \a count is 0 and the function returns true.
+    ///
+    /// \param samples  Array to fill
+    /// \param maxCount Maximum number of samples to read
+    /// \param count    Variable to fill with the number of samples read
+    ///
+    /// \return False if the end of the current segment was reached
+    ///
+    ////////////////////////////////////////////////////////////
+    bool read(Int16* samples, std::size_t maxCount, std::size_t& count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read float samples
+    ///
+    /// \param samples  Array to fill
+    /// \param maxCount Maximum number of samples to read
+    /// \param count    Variable to fill with the number of samples read
+    ///
+    /// \return False if the end of the current segment was reached
+    ///
+    ////////////////////////////////////////////////////////////
+    bool read(float* samples, std::size_t maxCount, std::size_t& count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move past the end of the current segment
+    ///
+    /// This function is called by the consumer once read()
+    /// returned false.
+    ///
+    /// \param nextOffset Variable to fill with the position of the next segment
+    ///
+    /// \return True if the decoder already continued with the
+    ///         next segment, false if it stopped
+    ///
+    ////////////////////////////////////////////////////////////
+    bool endSegment(Uint64& nextOffset);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the read position
+    ///
+    /// \return Position of the next sample to read, in samples
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getReadOffset() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief End of a segment of decoded samples
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SegmentEnd
+    {
+        Uint64 position;   //!< Position of the end in the ring buffer
+        bool   continued;  //!< Did the decoder continue with a next segment?
+        Uint64 nextOffset; //!< Position of the next segment in the file
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode the next slice of samples
+    ///
+    /// \return True if something was done, false if the decoder is idle
+    ///
+    ////////////////////////////////////////////////////////////
+    bool decode();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode the next slice of samples into a ring buffer
+    ///
+    /// \param ring Ring buffer to fill
+    ///
+    /// \return True if something was done, false if the decoder is idle
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename T>
+    bool decode(RingBuffer<T>& ring);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read samples from a ring buffer
+    ///
+    /// \param ring     Ring buffer to read from
+    /// \param samples  Array to fill
+    /// \param maxCount Maximum number of samples to read
+    /// \param count    Variable to fill with the number of samples read
+    ///
+    /// \return False if the end of the current segment was reached
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename T>
+    bool read(RingBuffer<T>& ring, T* samples, std::size_t maxCount, std::size_t& count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Discard the decoded samples and request a seek
+    ///
+    /// This function must be called with m_mutex locked.
+    ///
+    /// \param sampleOffset New read position, in samples
+    ///
+    ////////////////////////////////////////////////////////////
+    void flush(Uint64 sampleOffset);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called as the entry point of the decoding thread
+    ///
+    ////////////////////////////////////////////////////////////
+    static void run();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    InputSoundFile&        m_file;         //!< Sound file to decode
+    Mutex&                 m_fileMutex;    //!< Mutex protecting the file
+    SampleFormat           m_sampleFormat; //!< Format of the decoded samples
+    RingBuffer<Int16>      m_ring;         //!< Samples decoded ahead
+    RingBuffer<float>      m_floatRing;    //!< Samples decoded ahead, for the Float32Samples format
+    std::deque<SegmentEnd> m_segmentEnds;  //!< Ends of the segments in the ring buffer
+    Uint64                 m_readOffset;   //!< Position of the next sample to read
+    Uint64                 m_seekOffset;   //!< Position of the pending seek
+    bool                   m_seekPending;  //!< Must the decoder seek before decoding?
+    bool                   m_ended;        //!< Did the decoder reach the end of the file?
+    bool                   m_loop;         //!< Is looping enabled?
+    Uint64                 m_loopOffset;   //!< Loop start point
+    Uint64                 m_loopLength;   //!< Loop length
+    mutable Mutex          m_mutex;        //!< Mutex protecting the decoder state
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_READAHEADDECODER_HPP
@@ -0,0 +1,533 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2023 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Resampler.hpp>
+#include <SFML/Audio/SampleConversion.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Number of zero crossings of the sinc on each side of the filter, at full bandwidth
+    const std::size_t zeroCrossings = 16;
+
+    // Bounds of the filter table
+    const std::size_t maxPhaseCount  = 512;
+    const std::size_t maxHalfLength  = 1024;
+
+    // Part of the band below the Nyquist frequency which is kept
+    const double passband = 0.95;
+
+    const double pi = 3.141592653589793;
+
+    // Greatest common divisor
+    sf::Uint64 gcd(sf::Uint64 a, sf::Uint64 b)
+    {
+        while (b != 0)
+        {
+            sf::Uint64 r = a % b;
+            a = b;
+            b = r;
+        }
+        return a;
+    }
+
+    // Blackman-windowed sinc, for a distance t (in input frames) and a cutoff relative to the input Nyquist frequency
+    double windowedSinc(double t, double cutoff, double halfLength)
+    {
+        double x = t / halfLength;
+        if (std::fabs(x) >= 1.0)
+            return 0.0;
+
+        double window = 0.42 + 0.5 * std::cos(pi * x) + 0.08 * std::cos(2.0 * pi * x);
+        double sinc   = (std::fabs(t) < 1e-9) ? 1.0 : std::sin(pi * cutoff * t) / (pi * cutoff * t);
+
+        return cutoff * sinc * window;
+    }
+
+    // Dot product of the filter taps with the input; it uses four independent
+    // sums, which lets the compiler keep them in one vector register
+    // (the number of taps is always a multiple of 4)
+    inline float dot(const float* input, const float* taps, std::size_t count)
+    {
+        float sum0 = 0.f;
+        float sum1 = 0.f;
+        float sum2 = 0.f;
+        float sum3 = 0.f;
+        for (std::size_t i = 0; i < count; i += 4)
+        {
+            sum0 += input[i + 0] * taps[i + 0];
+            sum1 += input[i + 1] * taps[i + 1];
+            sum2 += input[i + 2] * taps[i + 2];
+            sum3 += input[i + 3] * taps[i + 3];
+        }
+
+        return (sum0 + sum1) + (sum2 + sum3);
+    }
+
+    // Gains of an input channel in a stereo mix, in the OpenAL channel order
+    void getStereoGains(unsigned int channelCount, unsigned int channel, float& left, float& right)
+    {
+        const float side   = 0.7071068f;
+        const float center = 0.5f;
+
+        // Mono is played on both sides
+        left  = 1.f;
+        right = 1.f;
+
+        if (channelCount == 2 || channelCount == 4)
+        {
+            // L, R (quad adds RL, RR)
+            left  = (channel % 2 == 0) ? ((channel < 2) ? 1.f : side) : 0.f;
+            right = (channel % 2 == 1) ? ((channel < 2) ? 1.f : side) : 0.f;
+        }
+        else if (channelCount == 6 || channelCount == 8)
+        {
+            // FL, FR, FC, LFE, RL, RR (7.1 adds SL, SR)
+            switch (channel)
+            {
+                case 0:  left = 1.f;  right = 0.f;  break;
+                case 1:  left = 0.f;  right = 1.f;  break;
+                case 2:  left = side; right = side; break;
+                case 3:  left = 0.f;  right = 0.f;  break;
+                default: left = (channel % 2 == 0) ? side : 0.f; right = (channel % 2 == 1) ? side : 0.f; break;
+            }
+        }
+        else if (channelCount == 7)
+        {
+            // FL, FR, FC, LFE, RC, SL, SR
+            switch (channel)
+            {
+                case 0:  left = 1.f;    right = 0.f;    break;
+                case 1:  left = 0.f;    right = 1.f;    break;
+                case 2:  left = side;   right = side;   break;
+                case 3:  left = 0.f;    right = 0.f;    break;
+                case 4:  left = center; right = center; break;
+                case 5:  left = side;   right = 0.f;    break;
+                default: left = 0.f;    right = side;   break;
+            }
+        }
+    }
+
+    // Scale the gains of an output channel so that it can't clip more than its loudest input
+    void normalize(float* gains, unsigned int count)
+    {
+        float sum = 0.f;
+        for (unsigned int i = 0; i < count; ++i)
+            sum += gains[i];
+
+        if (sum > 1.f)
+        {
+            for (unsigned int i = 0; i < count; ++i)
+                gains[i] /= sum;
+        }
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+Resampler::Resampler() :
+m_inputSampleRate   (0),
+m_inputChannelCount (0),
+m_outputSampleRate  (0),
+m_outputChannelCount(0),
+m_channelCount      (0),
+m_upFactor          (1),
+m_downFactor        (1),
+m_phaseCount        (0),
+m_halfLength        (0),
+m_position          (0),
+m_fraction          (0),
+m_inputFrameCount   (0),
+m_outputFrameCount  (0)
+{
+    setFormat(44100, 2, 44100, 2);
+}
+
+
+////////////////////////////////////////////////////////////
+Resampler::Resampler(unsigned int inputSampleRate, unsigned int inputChannelCount, unsigned int outputSampleRate, unsigned int outputChannelCount) :
+m_inputSampleRate   (0),
+m_inputChannelCount (0),
+m_outputSampleRate  (0),
+m_outputChannelCount(0),
+m_channelCount      (0),
+m_upFactor          (1),
+m_downFactor        (1),
+m_phaseCount        (0),
+m_halfLength        (0),
+m_position          (0),
+m_fraction          (0),
+m_inputFrameCount   (0),
+m_outputFrameCount  (0)
+{
+    setFormat(inputSampleRate, inputChannelCount, outputSampleRate, outputChannelCount);
+}
+
+
+////////////////////////////////////////////////////////////
+void Resampler::setFormat(unsigned int inputSampleRate, unsigned int inputChannelCount, unsigned int outputSampleRate, unsigned int outputChannelCount)
+{
+    m_inputSampleRate    = std::max(inputSampleRate, 1u);
+    m_inputChannelCount  = std::min(std::max(inputChannelCount, 1u), 8u);
+    m_outputSampleRate   = std::max(outputSampleRate, 1u);
+    m_outputChannelCount = std::min(std::max(outputChannelCount, 1u), 8u);
+
+    // Filter the smallest number of channels: mix before filtering when
+    // there are less output channels, and after it when there are more
+    m_channelCount = std::min(m_inputChannelCount, m_outputChannelCount);
+
+    // Build the channel mixing matrix
+    unsigned int inputCount  = m_inputChannelCount;
+    unsigned int outputCount = m_outputChannelCount;
+    m_matrix.assign(outputCount * inputCount, 0.f);
+    if (inputCount == outputCount)
+    {
+        for (unsigned int i = 0; i < inputCount; ++i)
+            m_matrix[i * inputCount + i] = 1.f;
+    }
+    else
+    {
+        // Mix down to stereo first
+        std::vector<float> stereo(2 * inputCount);
+        for (unsigned int i = 0; i < inputCount; ++i)
+            getStereoGains(inputCount, i, stereo[i], stereo[inputCount + i]);
+        normalize(&stereo[0], inputCount);
+        normalize(&stereo[inputCount], inputCount);
+
+        if (outputCount == 1)
+        {
+            // Average both sides of the stereo mix (mono input is only copied)
+            for (unsigned int i = 0; i < inputCount; ++i)
+                m_matrix[i] = 0.5f * (stereo[i] + stereo[inputCount + i]);
+        }
+        else
+        {
+            // Play the stereo mix on the front left and right channels
+            std::copy(stereo.begin(), stereo.end(), m_matrix.begin());
+        }
+    }
+
+    // Reduce the ratio of the sample rates
+    Uint64 divisor = gcd(m_inputSampleRate, m_outputSampleRate);
+    m_upFactor   = m_outputSampleRate / divisor;
+    m_downFactor = m_inputSampleRate / divisor;
+
+    if (m_upFactor == m_downFactor)
+    {
+        // No filter needed
+        m_phaseCount = 0;
+        m_halfLength = 0;
+        std::vector<float>().swap(m_filter);
+    }
+    else
+    {
+        // When decimating, the cutoff frequency is lowered to the output
+        // Nyquist frequency, and the filter is widened accordingly
+        double cutoff = passband * std::min(1.0, static_cast<double>(m_upFactor) / static_cast<double>(m_downFactor));
+        m_halfLength  = static_cast<std::size_t>(std::ceil(static_cast<double>(zeroCrossings) / cutoff));
+        m_halfLength  = std::min((m_halfLength + 1) / 2 * 2, maxHalfLength);
+
+        // Exact ratios have a phase per position; the others interpolate between phases
+        m_phaseCount = static_cast<std::size_t>(std::min<Uint64>(m_upFactor, maxPhaseCount));
+
+        // Compute the taps of each phase, plus a last one at one frame for the interpolation
+        std::size_t tapCount = 2 * m_halfLength;
+        m_filter.resize((m_phaseCount + 1) * tapCount);
+        for (std::size_t phase = 0; phase <= m_phaseCount; ++phase)
+        {
+            float* taps = &m_filter[phase * tapCount];
+            double offset = static_cast<double>(phase) / static_cast<double>(m_phaseCount);
+
+            double sum = 0.0;
+            for (std::size_t i = 0; i < tapCount; ++i)
+            {
+                double t = offset + static_cast<double>(m_halfLength) - 1.0 - static_cast<double>(i);
+                double tap = windowedSinc(t, cutoff, static_cast<double>(m_halfLength));
+                taps[i] = static_cast<float>(tap);
+                sum += tap;
+            }
+
+            // Unity gain at DC for every phase
+            for (std::size_t i = 0; i < tapCount; ++i)
+                taps[i] = static_cast<float>(taps[i] / sum);
+        }
+    }
+
+    reset();
+}
+
+
+////////////////////////////////////////////////////////////
+void Resampler::process(const Int16* input, Uint64 frameCount, std::vector<Int16>& output)
+{
+    if (!input || !frameCount)
+        return;
+
+    std::size_t sampleCount = static_cast<std::size_t>(frameCount * m_inputChannelCount);
+    m_input.resize(sampleCount);
+    priv::convertSamples(input, &m_input[0], sampleCount);
+
+    m_output.clear();
+    processFrames(&m_input[0], frameCount, m_output);
+
+    std::size_t size = output.size();
+    output.resize(size + m_output.size());
+    if (!m_output.empty())
+        priv::convertSamples(&m_output[0], &output[size], m_output.size());
+}
+
+
+////////////////////////////////////////////////////////////
+void Resampler::process(const float* input, Uint64 frameCount, std::vector<float>& output)
+{
+    if (!input || !frameCount)
+        return;
+
+    processFrames(input, frameCount, output);
+}
+
+
+////////////////////////////////////////////////////////////
+void Resampler::flush(std::vector<Int16>& output)
+{
+    m_output.clear();
+    flush(m_output);
+
+    std::size_t size = output.size();
+    output.resize(size + m_output.size());
+    if (!m_output.empty())
+        priv::convertSamples(&m_output[0], &output[size], m_output.size());
+}
+
+
+////////////////////////////////////////////////////////////
+void Resampler::flush(std::vector<float>& output)
+{
+    if (m_phaseCount > 0)
+    {
+        // Pad the input with silence, to filter the last input frames
+        for (unsigned int i = 0; i < m_channelCount; ++i)
+            m_history[i].resize(m_history[i].size() + m_halfLength, 0.f);
+
+        filter(getOutputFrameCount(m_inputFrameCount, m_inputSampleRate, m_outputSampleRate), output);
+    }
+
+    reset();
+}
+
+
+////////////////////////////////////////////////////////////
+void Resampler::reset()
+{
+    // The first output frame is aligned with the first input frame,
+    // which requires silence before it
+    std::size_t padding = (m_halfLength > 0) ? m_halfLength - 1 : 0;
+    m_history.resize(m_channelCount);
+    for (unsigned int i = 0; i < m_channelCount; ++i)
+        m_history[i].assign(padding, 0.f);
+
+    m_position         = padding;
+    m_fraction         = 0;
+    m_inputFrameCount  = 0;
+    m_outputFrameCount = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 Resampler::getOutputFrameCount(Uint64 inputFrameCount, unsigned int inputSampleRate, unsigned int outputSampleRate)
+{
+    if (!inputSampleRate || !outputSampleRate)
+        return 0;
+
+    Uint64 divisor = gcd(inputSampleRate, outputSampleRate);
+    Uint64 up      = outputSampleRate / divisor;
+    Uint64 down    = inputSampleRate / divisor;
+
+    // Rounded up, so that the output lasts at least as long as the input
+    return (inputFrameCount / down) * up + (inputFrameCount % down * up + down - 1) / down;
+}
+
+
+////////////////////////////////////////////////////////////
+void Resampler::processFrames(const float* input, Uint64 frameCount, std::vector<float>& output)
+{
+    std::size_t count = static_cast<std::size_t>(frameCount);
+    m_inputFrameCount += frameCount;
+
+    // Without rate conversion, only mix the channels
+    if (m_phaseCount == 0)
+    {
+        std::size_t size = output.size();
+        output.resize(size + count * m_outputChannelCount);
+        mix(input, count, &output[size]);
+        m_outputFrameCount += frameCount;
+        return;
+    }
+
+    // Mix down before filtering
+    const float* frames = input;
+    if (m_outputChannelCount < m_inputChannelCount)
+    {
+        m_frames.resize(count * m_outputChannelCount);
+        mix(input, count, &m_frames[0]);
+        frames = &m_frames[0];
+    }
+
+    // Append the input to the history of each channel
+    for (unsigned int i = 0; i < m_channelCount; ++i)
+    {
+        std::vector<float>& history = m_history[i];
+        std::size_t size = history.size();
+        history.resize(size + count);
+        for (std::size_t j = 0; j < count; ++j)
+            history[size + j] = frames[j * m_channelCount + i];
+    }
+
+    filter(static_cast<Uint64>(-1), output);
+}
+
+
+////////////////////////////////////////////////////////////
+void Resampler::filter(Uint64 frameLimit, std::vector<float>& output)
+{
+    std::size_t tapCount    = 2 * m_halfLength;
+    std::size_t historySize = m_history[0].size();
+
+    // Count the output frames which have all their input
+    Uint64 step     = m_downFactor / m_upFactor;
+    Uint64 stepRest = m_downFactor % m_upFactor;
+    Uint64 count    = 0;
+    std::size_t position = m_position;
+    Uint64      fraction = m_fraction;
+    while ((position + m_halfLength < historySize) && (m_outputFrameCount + count < frameLimit))
+    {
+        ++count;
+        position += static_cast<std::size_t>(step);
+        fraction += stepRest;
+        if (fraction >= m_upFactor)
+        {
+            fraction -= m_upFactor;
+            ++position;
+        }
+    }
+
+    if (count == 0)
+        return;
+
+    // Filter them; frames with more output channels are mixed up afterwards
+    bool mixUp = m_outputChannelCount > m_inputChannelCount;
+    std::vector<float>& frames = mixUp ? m_frames : output;
+    std::size_t size = mixUp ? 0 : output.size();
+    frames.resize(size + static_cast<std::size_t>(count) * m_channelCount);
+    float* out = &frames[size];
+
+    bool exact = (m_phaseCount == m_upFactor);
+    for (Uint64 n = 0; n < count; ++n)
+    {
+        std::size_t start = m_position + 1 - m_halfLength;
+
+        if (exact)
+        {
+            const float* taps = &m_filter[static_cast<std::size_t>(m_fraction) * tapCount];
+            for (unsigned int i = 0; i < m_channelCount; ++i)
+                *out++ = dot(&m_history[i][start], taps, tapCount);
+        }
+        else
+        {
+            // Interpolate between the two nearest phases
+            Uint64 scaled = m_fraction * m_phaseCount;
+            std::size_t phase = static_cast<std::size_t>(scaled / m_upFactor);
+            float weight = static_cast<float>(scaled % m_upFactor) / static_cast<float>(m_upFactor);
+            const float* taps0 = &m_filter[phase * tapCount];
+            const float* taps1 = taps0 + tapCount;
+            for (unsigned int i = 0; i < m_channelCount; ++i)
+            {
+                float sample0 = dot(&m_history[i][start], taps0, tapCount);
+                float sample1 = dot(&m_history[i][start], taps1, tapCount);
+                *out++ = sample0 + (sample1 - sample0) * weight;
+            }
+        }
+
+        m_position += static_cast<std::size_t>(step);
+        m_fraction += stepRest;
+        if (m_fraction >= m_upFactor)
+        {
+            m_fraction -= m_upFactor;
+            ++m_position;
+        }
+    }
+
+    m_outputFrameCount += count;
+
+    // Drop the input which is not needed anymore
+    std::size_t consumed = std::min(m_position + 1 - m_halfLength, historySize);
+    for (unsigned int i = 0; i < m_channelCount; ++i)
+        m_history[i].erase(m_history[i].begin(), m_history[i].begin() + static_cast<std::ptrdiff_t>(consumed));
+    m_position -= consumed;
+
+    if (mixUp)
+    {
+        std::size_t outputSize = output.size();
+        output.resize(outputSize + static_cast<std::size_t>(count) * m_outputChannelCount);
+        mix(&m_frames[0], static_cast<std::size_t>(count), &output[outputSize]);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Resampler::mix(const float* input, std::size_t frameCount, float* output) const
+{
+    unsigned int inputCount  = m_inputChannelCount;
+    unsigned int outputCount = m_outputChannelCount;
+
+    if (inputCount == outputCount)
+    {
+        std::copy(input, input + frameCount * inputCount, output);
+        return;
+    }
+
+    for (std::size_t frame = 0; frame < frameCount; ++frame)
+    {
+        const float* in = input + frame * inputCount;
+        float* out = output + frame * outputCount;
+        for (unsigned int i = 0; i < outputCount; ++i)
+        {
+            const float* gains = &m_matrix[i * inputCount];
+            float sample = 0.f;
+            for (unsigned int j = 0; j < inputCount; ++j)
+                sample += in[j] * gains[j];
+            out[i] = sample;
+        }
+    }
+}
+
+} // namespace sf
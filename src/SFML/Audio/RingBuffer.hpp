@@ -0,0 +1,198 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2023 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_RINGBUFFER_HPP
+#define SFML_RINGBUFFER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Fixed-capacity ring buffer shared by a single
+///        producer thread and a single consumer thread
+///
+/// Samples are copied in and out without holding any lock:
+/// each side only accesses its own region of the buffer, and
+/// the mutex only protects the update of the counters.
+///
+////////////////////////////////////////////////////////////
+template <typename T>
+class RingBuffer : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty ring buffer with no capacity.
+    ///
+    ////////////////////////////////////////////////////////////
+    RingBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the capacity of the ring buffer
+    ///
+    /// The contents are discarded. This function must not be
+    /// called while the producer or the consumer is active.
+    ///
+    /// \param capacity New capacity, in elements
+    ///
+    ////////////////////////////////////////////////////////////
+    void resize(std::size_t capacity);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the capacity of the ring buffer
+    ///
+    /// \return Capacity, in elements
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCapacity() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Discard the contents of the ring buffer
+    ///
+    /// This function is called by the consumer. A write that
+    /// the producer started before the call is discarded too.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the free region to write to
+    ///
+    /// This function is called by the producer. The returned
+    /// region is contiguous, so it may be smaller than the
+    /// total free space when the latter wraps around.
+    ///
+    /// \param region Variable to fill with the start of the region
+    ///
+    /// \return Number of elements that can be written to \a region
+    ///
+    /// \see endWrite
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t beginWrite(T*& region);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Publish the elements written to the free region
+    ///
+    /// This function is called by the producer.
+    ///
+    /// \param count Number of elements written
+    ///
+    /// \return False if the ring buffer was cleared since
+    ///         beginWrite, in which case nothing is published
+    ///
+    /// \see beginWrite
+    ///
+    ////////////////////////////////////////////////////////////
+    bool endWrite(std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write elements to the ring buffer
+    ///
+    /// This function is called by the producer.
+    ///
+    /// \param elements Elements to write
+    /// \param count    Number of elements to write
+    ///
+    /// \return Number of elements actually written, limited
+    ///         by the free space
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t write(const T* elements, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read elements from the ring buffer
+    ///
+    /// This function is called by the consumer.
+    ///
+    /// \param elements Array to fill
+    /// \param maxCount Maximum number of elements to read
+    ///
+    /// \return Number of elements actually read, 0 if the
+    ///         ring buffer was cleared during the read
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t read(T* elements, std::size_t maxCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of elements available for reading
+    ///
+    /// \return Number of readable elements
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getReadableCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the total number of elements read since the last clear
+    ///
+    /// \return Number of elements read
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getReadCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the total number of elements written since the last clear
+    ///
+    /// \return Number of elements written
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getWriteCount() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<T> m_elements;        //!< Storage of the elements
+    Uint64         m_readCount;       //!< Number of elements read since the last clear
+    Uint64         m_writeCount;      //!< Number of elements written since the last clear
+    Uint32         m_generation;      //!< Incremented each time the buffer is cleared
+    Uint32         m_writeGeneration; //!< Generation at the time of the last beginWrite
+    mutable Mutex  m_mutex;           //!< Mutex protecting the counters
+};
+
+#include <SFML/Audio/RingBuffer.inl>
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_RINGBUFFER_HPP
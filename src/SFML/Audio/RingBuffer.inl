@@ -0,0 +1,199 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2023 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+RingBuffer<T>::RingBuffer() :
+m_elements       (),
+m_readCount      (0),
+m_writeCount     (0),
+m_generation     (0),
+m_writeGeneration(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void RingBuffer<T>::resize(std::size_t capacity)
+{
+    Lock lock(m_mutex);
+
+    m_elements.resize(capacity);
+    m_readCount  = 0;
+    m_writeCount = 0;
+    ++m_generation;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t RingBuffer<T>::getCapacity() const
+{
+    return m_elements.size();
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void RingBuffer<T>::clear()
+{
+    Lock lock(m_mutex);
+
+    m_readCount  = 0;
+    m_writeCount = 0;
+    ++m_generation;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t RingBuffer<T>::beginWrite(T*& region)
+{
+    Lock lock(m_mutex);
+
+    m_writeGeneration = m_generation;
+    region = NULL;
+
+    std::size_t capacity = m_elements.size();
+    if (capacity == 0)
+        return 0;
+
+    std::size_t position = static_cast<std::size_t>(m_writeCount % capacity);
+    std::size_t free     = capacity - static_cast<std::size_t>(m_writeCount - m_readCount);
+
+    region = &m_elements[position];
+    return std::min(free, capacity - position);
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+bool RingBuffer<T>::endWrite(std::size_t count)
+{
+    Lock lock(m_mutex);
+
+    if (m_writeGeneration != m_generation)
+        return false;
+
+    m_writeCount += count;
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t RingBuffer<T>::write(const T* elements, std::size_t count)
+{
+    std::size_t written = 0;
+    while (written < count)
+    {
+        T* region = NULL;
+        std::size_t size = std::min(beginWrite(region), count - written);
+        if (size == 0)
+            break;
+
+        std::copy(elements + written, elements + written + size, region);
+        if (!endWrite(size))
+            break;
+
+        written += size;
+    }
+
+    return written;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t RingBuffer<T>::read(T* elements, std::size_t maxCount)
+{
+    std::size_t capacity = m_elements.size();
+    std::size_t count    = 0;
+    Uint64      readCount;
+    Uint32      generation;
+
+    {
+        Lock lock(m_mutex);
+
+        count      = std::min(maxCount, static_cast<std::size_t>(m_writeCount - m_readCount));
+        readCount  = m_readCount;
+        generation = m_generation;
+    }
+
+    if (count == 0)
+        return 0;
+
+    // The readable region can't be overwritten until the read counter is updated
+    std::size_t position = static_cast<std::size_t>(readCount % capacity);
+    std::size_t first    = std::min(count, capacity - position);
+    std::copy(m_elements.begin() + static_cast<std::ptrdiff_t>(position),
+              m_elements.begin() + static_cast<std::ptrdiff_t>(position + first),
+              elements);
+    std::copy(m_elements.begin(),
+              m_elements.begin() + static_cast<std::ptrdiff_t>(count - first),
+              elements + first);
+
+    Lock lock(m_mutex);
+
+    // The elements were discarded if the buffer was cleared meanwhile
+    if (m_generation != generation)
+        return 0;
+
+    m_readCount += count;
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t RingBuffer<T>::getReadableCount() const
+{
+    Lock lock(m_mutex);
+
+    return static_cast<std::size_t>(m_writeCount - m_readCount);
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+Uint64 RingBuffer<T>::getReadCount() const
+{
+    Lock lock(m_mutex);
+
+    return m_readCount;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+Uint64 RingBuffer<T>::getWriteCount() const
+{
+    Lock lock(m_mutex);
+
+    return m_writeCount;
+}
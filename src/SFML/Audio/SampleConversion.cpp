@@ -0,0 +1,159 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2023 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/SampleConversion.hpp>
+#include <cassert>
+
+
+namespace
+{
+    // The kernels below work on whole blocks with no branch in their
+    // inner loop, so that the compiler can vectorize them
+
+    // Assemble little endian signed samples (24-bit ones are scaled to the full 32-bit range)
+    inline sf::Int32 load24(const sf::Uint8* bytes)
+    {
+        return static_cast<sf::Int32>((static_cast<sf::Uint32>(bytes[0]) << 8) |
+                                      (static_cast<sf::Uint32>(bytes[1]) << 16) |
+                                      (static_cast<sf::Uint32>(bytes[2]) << 24));
+    }
+
+    inline sf::Int32 load32(const sf::Uint8* bytes)
+    {
+        return static_cast<sf::Int32>(static_cast<sf::Uint32>(bytes[0]) |
+                                      (static_cast<sf::Uint32>(bytes[1]) << 8) |
+                                      (static_cast<sf::Uint32>(bytes[2]) << 16) |
+                                      (static_cast<sf::Uint32>(bytes[3]) << 24));
+    }
+
+    inline sf::Int16 load16(const sf::Uint8* bytes)
+    {
+        return static_cast<sf::Int16>(bytes[0] | (bytes[1] << 8));
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void convertSamples(const Int16* input, float* output, std::size_t count)
+{
+    const float scale = 1.f / 32768.f;
+
+    for (std::size_t i = 0; i < count; ++i)
+        output[i] = static_cast<float>(input[i]) * scale;
+}
+
+
+////////////////////////////////////////////////////////////
+void convertSamples(const float* input, Int16* output, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        float sample = input[i] * 32768.f;
+
+        if (sample >= 32767.f)
+            output[i] = 32767;
+        else if (sample <= -32768.f)
+            output[i] = -32768;
+        else
+            output[i] = static_cast<Int16>(sample);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void convertPcmSamples(const Uint8* input, unsigned int bytesPerSample, Int16* output, std::size_t count)
+{
+    switch (bytesPerSample)
+    {
+        case 1:
+            for (std::size_t i = 0; i < count; ++i)
+                output[i] = static_cast<Int16>((input[i] - 128) << 8);
+            break;
+
+        case 2:
+            for (std::size_t i = 0; i < count; ++i)
+                output[i] = load16(input + i * 2);
+            break;
+
+        case 3:
+            // Keep the 2 most significant bytes
+            for (std::size_t i = 0; i < count; ++i)
+                output[i] = load16(input + i * 3 + 1);
+            break;
+
+        case 4:
+            // Keep the 2 most significant bytes
+            for (std::size_t i = 0; i < count; ++i)
+                output[i] = load16(input + i * 4 + 2);
+            break;
+
+        default:
+            assert(false);
+            break;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void convertPcmSamples(const Uint8* input, unsigned int bytesPerSample, float* output, std::size_t count)
+{
+    switch (bytesPerSample)
+    {
+        case 1:
+            for (std::size_t i = 0; i < count; ++i)
+                output[i] = static_cast<float>(input[i] - 128) * (1.f / 128.f);
+            break;
+
+        case 2:
+            for (std::size_t i = 0; i < count; ++i)
+                output[i] = static_cast<float>(load16(input + i * 2)) * (1.f / 32768.f);
+            break;
+
+        case 3:
+            for (std::size_t i = 0; i < count; ++i)
+                output[i] = static_cast<float>(load24(input + i * 3)) * (1.f / 2147483648.f);
+            break;
+
+        case 4:
+            for (std::size_t i = 0; i < count; ++i)
+                output[i] = static_cast<float>(load32(input + i * 4)) * (1.f / 2147483648.f);
+            break;
+
+        default:
+            assert(false);
+            break;
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
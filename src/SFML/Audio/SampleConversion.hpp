@@ -0,0 +1,94 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2023 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SAMPLECONVERSION_HPP
+#define SFML_SAMPLECONVERSION_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Convert 16-bit integer samples to normalized float samples
+///
+/// \param input  Samples to convert
+/// \param output Array to fill with the converted samples
+/// \param count  Number of samples to convert
+///
+////////////////////////////////////////////////////////////
+void convertSamples(const Int16* input, float* output, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// \brief Convert normalized float samples to 16-bit integer samples
+///
+/// Samples outside of the [-1, 1] range are clamped.
+///
+/// \param input  Samples to convert
+/// \param output Array to fill with the converted samples
+/// \param count  Number of samples to convert
+///
+////////////////////////////////////////////////////////////
+void convertSamples(const float* input, Int16* output, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// \brief Convert little endian PCM samples to 16-bit integer samples
+///
+/// 8-bit samples are unsigned, larger ones are signed; only
+/// the 16 most significant bits of larger samples are kept.
+///
+/// \param input          Raw PCM data to convert
+/// \param bytesPerSample Size of a PCM sample (1, 2, 3 or 4)
+/// \param output         Array to fill with the converted samples
+/// \param count          Number of samples to convert
+///
+////////////////////////////////////////////////////////////
+void convertPcmSamples(const Uint8* input, unsigned int bytesPerSample, Int16* output, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// \brief Convert little endian PCM samples to normalized float samples
+///
+/// 8-bit samples are unsigned, larger ones are signed.
+///
+/// \param input          Raw PCM data to convert
+/// \param bytesPerSample Size of a PCM sample (1, 2, 3 or 4)
+/// \param output         Array to fill with the converted samples
+/// \param count          Number of samples to convert
+///
+////////////////////////////////////////////////////////////
+void convertPcmSamples(const Uint8* input, unsigned int bytesPerSample, float* output, std::size_t count);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_SAMPLECONVERSION_HPP
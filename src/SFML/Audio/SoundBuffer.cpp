@@ -29,9 +29,17 @@
 #include <SFML/Audio/InputSoundFile.hpp>
 #include <SFML/Audio/OutputSoundFile.hpp>
 #include <SFML/Audio/Sound.hpp>
+#include <SFML/Audio/VoiceManager.hpp>
 #include <SFML/Audio/AudioDevice.hpp>
+#include <SFML/Audio/Resampler.hpp>
+#include <SFML/Audio/SampleConversion.hpp>
+#include <SFML/Audio/SoundBufferCache.hpp>
+#include <SFML/Audio/SoundDecoderPool.hpp>
 #include <SFML/Audio/ALCheck.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/FileInputStream.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
 #include <memory>
 
 #if defined(__APPLE__)
@@ -42,13 +50,65 @@
     #endif
 #endif
 
+namespace
+{
+    // Memory held by all the sound buffers
+    sf::Mutex  memoryMutex;
+    sf::Uint64 totalCpuBytes    = 0;
+    sf::Uint64 totalDeviceBytes = 0;
+
+    // Read the whole contents of a stream
+    bool readContents(sf::InputStream& stream, std::vector<char>& contents)
+    {
+        sf::Int64 size = stream.getSize();
+        if ((size <= 0) || (stream.seek(0) != 0))
+            return false;
+
+        contents.resize(static_cast<std::size_t>(size));
+        if (stream.read(&contents[0], size) == size)
+            return true;
+
+        std::vector<char>().swap(contents);
+        return false;
+    }
+
+    // Convert samples to another sample rate
+    template <typename T>
+    void resample(std::vector<T>& samples, unsigned int channelCount, unsigned int sampleRate, unsigned int newSampleRate)
+    {
+        if (samples.empty())
+            return;
+
+        sf::Uint64 frameCount = samples.size() / channelCount;
+
+        std::vector<T> converted;
+        converted.reserve(static_cast<std::size_t>(sf::Resampler::getOutputFrameCount(frameCount, sampleRate, newSampleRate) * channelCount));
+
+        sf::Resampler resampler(sampleRate, channelCount, newSampleRate, channelCount);
+        resampler.process(&samples[0], frameCount, converted);
+        resampler.flush(converted);
+
+        samples.swap(converted);
+    }
+}
+
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 SoundBuffer::SoundBuffer() :
-m_buffer  (0),
-m_duration()
+m_buffer      (0),
+m_sampleFormat(Int16Samples),
+m_sampleCount (0),
+m_duration    (),
+m_loadJob     (NULL),
+m_residency   (KeepSamples),
+m_cpuBytes    (0),
+m_deviceBytes (0),
+m_resampled   (false)
 {
+    priv::SoundDecoderPool::acquire();
+
     // Create the buffer
     alCheck(alGenBuffers(1, &m_buffer));
 }
@@ -56,16 +116,32 @@ m_duration()
 
 ////////////////////////////////////////////////////////////
 SoundBuffer::SoundBuffer(const SoundBuffer& copy) :
-m_buffer  (0),
-m_samples (copy.m_samples),
-m_duration(copy.m_duration),
-m_sounds  () // don't copy the attached sounds
+m_buffer      (0),
+m_samples     (copy.m_samples),
+m_floatSamples(copy.m_floatSamples),
+m_sampleFormat(copy.m_sampleFormat),
+m_sampleCount (copy.m_sampleCount),
+m_duration    (copy.m_duration),
+m_sounds      (), // don't copy the attached sounds
+m_loadJob     (NULL), // nor the pending load
+m_residency   (copy.m_residency),
+m_encoded     (copy.m_encoded),
+m_cpuBytes    (0),
+m_deviceBytes (0),
+m_resampled   (copy.m_resampled)
 {
+    priv::SoundDecoderPool::acquire();
+
     // Create the buffer
     alCheck(alGenBuffers(1, &m_buffer));
 
+    // Get the samples of the copy back if it released them
+    if (m_samples.empty() && m_floatSamples.empty() && (m_sampleCount > 0))
+        copy.restoreSamples(m_samples, m_floatSamples);
+
     // Update the internal buffer with the new samples
     update(copy.getChannelCount(), copy.getSampleRate());
+    applyResidency();
 }
 
 
@@ -82,42 +158,159 @@ SoundBuffer::~SoundBuffer()
     for (SoundList::const_iterator it = sounds.begin(); it != sounds.end(); ++it)
         (*it)->resetBuffer();
 
+    // Stop the voices playing the buffer as well
+    stopVoices();
+
     // Destroy the buffer
     if (m_buffer)
         alCheck(alDeleteBuffers(1, &m_buffer));
+
+    cancelLoading();
+    priv::SoundDecoderPool::release();
+
+    Lock lock(memoryMutex);
+    totalCpuBytes    -= m_cpuBytes;
+    totalDeviceBytes -= m_deviceBytes;
 }
 
 
 ////////////////////////////////////////////////////////////
 bool SoundBuffer::loadFromFile(const std::string& filename)
 {
+    if (priv::SoundBufferCache::isEnabled() || (m_residency == KeepEncoded))
+    {
+        FileInputStream stream;
+        if (stream.open(filename))
+            return loadFromStream(stream);
+    }
+
     InputSoundFile file;
-    if (file.openFromFile(filename))
-        return initialize(file);
+    if (file.openFromFile(filename) && initialize(file))
+    {
+        applyResidency();
+        return true;
+    }
     else
+    {
         return false;
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
 bool SoundBuffer::loadFromMemory(const void* data, std::size_t sizeInBytes)
 {
+    if (data && sizeInBytes && (priv::SoundBufferCache::isEnabled() || (m_residency == KeepEncoded)))
+        return loadFromEncoded(data, sizeInBytes);
+
     InputSoundFile file;
-    if (file.openFromMemory(data, sizeInBytes))
-        return initialize(file);
+    if (file.openFromMemory(data, sizeInBytes) && initialize(file))
+    {
+        applyResidency();
+        return true;
+    }
     else
+    {
         return false;
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
 bool SoundBuffer::loadFromStream(InputStream& stream)
 {
+    if (priv::SoundBufferCache::isEnabled() || (m_residency == KeepEncoded))
+    {
+        // The whole contents are needed to compute the cache key, or to be kept
+        std::vector<char> contents;
+        if (readContents(stream, contents))
+            return loadFromEncoded(&contents[0], contents.size());
+
+        // Fall back to direct decoding if the stream can't be read at once
+        stream.seek(0);
+    }
+
     InputSoundFile file;
-    if (file.openFromStream(stream))
-        return initialize(file);
+    if (file.openFromStream(stream) && initialize(file))
+    {
+        applyResidency();
+        return true;
+    }
     else
+    {
+        return false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBuffer::loadFromFileAsync(const std::string& filename)
+{
+    cancelLoading();
+
+    m_loadJob = priv::SoundDecoderPool::submit(filename, m_sampleFormat);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBuffer::loadFromFilesAsync(const std::vector<std::string>& filenames, std::vector<SoundBuffer>& buffers)
+{
+    buffers.resize(filenames.size());
+
+    for (std::size_t i = 0; i < filenames.size(); ++i)
+        buffers[i].loadFromFileAsync(filenames[i]);
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundBuffer::isLoadFinished() const
+{
+    return !m_loadJob || priv::SoundDecoderPool::isDone(*m_loadJob);
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundBuffer::finishLoading()
+{
+    if (!m_loadJob)
         return false;
+
+    priv::DecodeJob* job = m_loadJob;
+    m_loadJob = NULL;
+
+    priv::SoundDecoderPool::wait(*job);
+
+    bool success = false;
+    if (job->success)
+    {
+        // Take the decoded samples and upload them from this thread
+        m_samples.swap(job->samples);
+        m_floatSamples.swap(job->floatSamples);
+        m_sampleFormat = job->sampleFormat;
+        std::vector<char>().swap(m_encoded);
+        success = update(job->channelCount, job->sampleRate);
+
+        if (success)
+        {
+            // The file data is read again only if it must be kept
+            if (m_residency == KeepEncoded)
+            {
+                FileInputStream stream;
+                if (stream.open(job->filename))
+                    readContents(stream, m_encoded);
+            }
+
+            applyResidency();
+        }
+    }
+    else
+    {
+        err() << "Failed to load sound buffer from file \"" << job->filename << "\"" << std::endl;
+    }
+
+    delete job;
+
+    return success;
 }
 
 
@@ -128,9 +321,49 @@ bool SoundBuffer::loadFromSamples(const Int16* samples, Uint64 sampleCount, unsi
     {
         // Copy the new audio samples
         m_samples.assign(samples, samples + sampleCount);
+        std::vector<float>().swap(m_floatSamples);
+        std::vector<char>().swap(m_encoded);
+        m_sampleFormat = Int16Samples;
 
         // Update the internal buffer with the new samples
-        return update(channelCount, sampleRate);
+        if (!update(channelCount, sampleRate))
+            return false;
+
+        applyResidency();
+        return true;
+    }
+    else
+    {
+        // Error...
+        err() << "Failed to load sound buffer from samples ("
+              << "array: "      << samples      << ", "
+              << "count: "      << sampleCount  << ", "
+              << "channels: "   << channelCount << ", "
+              << "samplerate: " << sampleRate   << ")"
+              << std::endl;
+
+        return false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundBuffer::loadFromSamples(const float* samples, Uint64 sampleCount, unsigned int channelCount, unsigned int sampleRate)
+{
+    if (samples && sampleCount && channelCount && sampleRate)
+    {
+        // Copy the new audio samples
+        m_floatSamples.assign(samples, samples + sampleCount);
+        std::vector<Int16>().swap(m_samples);
+        std::vector<char>().swap(m_encoded);
+        m_sampleFormat = Float32Samples;
+
+        // Update the internal buffer with the new samples
+        if (!update(channelCount, sampleRate))
+            return false;
+
+        applyResidency();
+        return true;
     }
     else
     {
@@ -150,12 +383,40 @@ bool SoundBuffer::loadFromSamples(const Int16* samples, Uint64 sampleCount, unsi
 ////////////////////////////////////////////////////////////
 bool SoundBuffer::saveToFile(const std::string& filename) const
 {
+    // Get the samples back if they were released
+    std::vector<Int16>        restoredSamples;
+    std::vector<float>        restoredFloatSamples;
+    const std::vector<Int16>* samples      = &m_samples;
+    const std::vector<float>* floatSamples = &m_floatSamples;
+    if (m_samples.empty() && m_floatSamples.empty() && (m_sampleCount > 0))
+    {
+        if (!restoreSamples(restoredSamples, restoredFloatSamples))
+        {
+            err() << "Failed to save sound buffer to \"" << filename << "\" (its samples were released and can't be restored)" << std::endl;
+            return false;
+        }
+
+        samples      = &restoredSamples;
+        floatSamples = &restoredFloatSamples;
+    }
+
     // Create the sound file in write mode
     OutputSoundFile file;
     if (file.openFromFile(filename, getSampleRate(), getChannelCount()))
     {
         // Write the samples to the opened file
-        file.write(&m_samples[0], m_samples.size());
+        if (m_sampleFormat == Float32Samples)
+        {
+            // Sound files are written from 16-bit samples
+            std::vector<Int16> converted(floatSamples->size());
+            if (!converted.empty())
+                priv::convertSamples(&(*floatSamples)[0], &converted[0], converted.size());
+            file.write(converted.empty() ? NULL : &converted[0], converted.size());
+        }
+        else
+        {
+            file.write(samples->empty() ? NULL : &(*samples)[0], samples->size());
+        }
 
         return true;
     }
@@ -173,10 +434,68 @@ const Int16* SoundBuffer::getSamples() const
 }
 
 
+////////////////////////////////////////////////////////////
+const float* SoundBuffer::getFloatSamples() const
+{
+    return m_floatSamples.empty() ? NULL : &m_floatSamples[0];
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBuffer::setSampleFormat(SampleFormat sampleFormat)
+{
+    if (sampleFormat == m_sampleFormat)
+        return;
+
+    // Get the samples back if they were released
+    if (m_samples.empty() && m_floatSamples.empty() && (m_sampleCount > 0))
+    {
+        if (!restoreSamples(m_samples, m_floatSamples))
+        {
+            err() << "Failed to change the sample format of the sound buffer (its samples were released and can't be restored)" << std::endl;
+            return;
+        }
+    }
+
+    m_sampleFormat = sampleFormat;
+
+    // Nothing to convert if the buffer is empty
+    if (m_samples.empty() && m_floatSamples.empty())
+        return;
+
+    unsigned int channelCount = getChannelCount();
+    unsigned int sampleRate   = getSampleRate();
+
+    // Convert the current samples and upload them again
+    if (sampleFormat == Float32Samples)
+    {
+        m_floatSamples.resize(m_samples.size());
+        priv::convertSamples(&m_samples[0], &m_floatSamples[0], m_samples.size());
+        std::vector<Int16>().swap(m_samples);
+    }
+    else
+    {
+        m_samples.resize(m_floatSamples.size());
+        priv::convertSamples(&m_floatSamples[0], &m_samples[0], m_floatSamples.size());
+        std::vector<float>().swap(m_floatSamples);
+    }
+
+    update(channelCount, sampleRate);
+    applyResidency();
+}
+
+
+////////////////////////////////////////////////////////////
+SampleFormat SoundBuffer::getSampleFormat() const
+{
+    return m_sampleFormat;
+}
+
+
 ////////////////////////////////////////////////////////////
 Uint64 SoundBuffer::getSampleCount() const
 {
-    return m_samples.size();
+    return m_sampleCount;
 }
 
 
@@ -207,15 +526,90 @@ Time SoundBuffer::getDuration() const
 }
 
 
+////////////////////////////////////////////////////////////
+void SoundBuffer::setCacheDirectory(const std::string& directory)
+{
+    priv::SoundBufferCache::setDirectory(directory);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBuffer::setResidency(Residency residency)
+{
+    m_residency = residency;
+
+    // Get the samples back if they must be kept again
+    if ((residency == KeepSamples) && m_samples.empty() && m_floatSamples.empty() && (m_sampleCount > 0))
+    {
+        if (!restoreSamples(m_samples, m_floatSamples))
+            err() << "Failed to restore the samples of the sound buffer" << std::endl;
+    }
+
+    applyResidency();
+}
+
+
+////////////////////////////////////////////////////////////
+SoundBuffer::Residency SoundBuffer::getResidency() const
+{
+    return m_residency;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBuffer::getMemoryUsage(Uint64& cpuBytes, Uint64& deviceBytes) const
+{
+    cpuBytes    = m_cpuBytes;
+    deviceBytes = m_deviceBytes;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBuffer::getTotalMemoryUsage(Uint64& cpuBytes, Uint64& deviceBytes)
+{
+    Lock lock(memoryMutex);
+
+    cpuBytes    = totalCpuBytes;
+    deviceBytes = totalDeviceBytes;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBuffer::setResampled(bool resampled)
+{
+    m_resampled = resampled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundBuffer::isResampled() const
+{
+    return m_resampled;
+}
+
+
 ////////////////////////////////////////////////////////////
 SoundBuffer& SoundBuffer::operator =(const SoundBuffer& right)
 {
+    cancelLoading();
+
+    // The voices playing the current buffer can't be reattached to the new one
+    stopVoices();
+
     SoundBuffer temp(right);
 
-    std::swap(m_samples,  temp.m_samples);
-    std::swap(m_buffer,   temp.m_buffer);
-    std::swap(m_duration, temp.m_duration);
-    std::swap(m_sounds,   temp.m_sounds); // swap sounds too, so that they are detached when temp is destroyed
+    std::swap(m_samples,      temp.m_samples);
+    std::swap(m_floatSamples, temp.m_floatSamples);
+    std::swap(m_sampleFormat, temp.m_sampleFormat);
+    std::swap(m_sampleCount,  temp.m_sampleCount);
+    std::swap(m_buffer,       temp.m_buffer);
+    std::swap(m_duration,     temp.m_duration);
+    std::swap(m_residency,    temp.m_residency);
+    std::swap(m_encoded,      temp.m_encoded);
+    std::swap(m_cpuBytes,     temp.m_cpuBytes);    // the memory is accounted to the instance holding it
+    std::swap(m_deviceBytes,  temp.m_deviceBytes);
+    std::swap(m_resampled,    temp.m_resampled);
+    std::swap(m_sounds,       temp.m_sounds); // swap sounds too, so that they are detached when temp is destroyed
 
     return *this;
 }
@@ -224,21 +618,209 @@ SoundBuffer& SoundBuffer::operator =(const SoundBuffer& right)
 ////////////////////////////////////////////////////////////
 bool SoundBuffer::initialize(InputSoundFile& file)
 {
-    // Retrieve the sound parameters
-    Uint64       sampleCount  = file.getSampleCount();
-    unsigned int channelCount = file.getChannelCount();
-    unsigned int sampleRate   = file.getSampleRate();
+    // Update the internal buffer with the new samples
+    return readSamples(file) && update(file.getChannelCount(), file.getSampleRate());
+}
+
 
-    // Read the samples from the provided file
-    m_samples.resize(static_cast<std::size_t>(sampleCount));
-    if (file.read(&m_samples[0], sampleCount) == sampleCount)
+////////////////////////////////////////////////////////////
+bool SoundBuffer::readSamples(InputSoundFile& file)
+{
+    Uint64 sampleCount = file.getSampleCount();
+
+    // The file data is only kept by the callers which need it
+    std::vector<char>().swap(m_encoded);
+
+    // Read the samples from the provided file, in the format of the buffer
+    Uint64 readCount = 0;
+    if (m_sampleFormat == Float32Samples)
     {
-        // Update the internal buffer with the new samples
+        std::vector<Int16>().swap(m_samples);
+        m_floatSamples.resize(static_cast<std::size_t>(sampleCount));
+        readCount = file.read(&m_floatSamples[0], sampleCount);
+    }
+    else
+    {
+        std::vector<float>().swap(m_floatSamples);
+        m_samples.resize(static_cast<std::size_t>(sampleCount));
+        readCount = file.read(&m_samples[0], sampleCount);
+    }
+
+    return readCount == sampleCount;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundBuffer::loadFromCache(const void* data, std::size_t sizeInBytes)
+{
+    Uint64 key = priv::SoundBufferCache::computeKey(data, sizeInBytes);
+
+    // Cache hit: no decoding at all
+    unsigned int channelCount = 0;
+    unsigned int sampleRate   = 0;
+    if (priv::SoundBufferCache::load(key, m_sampleFormat, m_samples, m_floatSamples, channelCount, sampleRate))
+    {
+        if (m_sampleFormat == Float32Samples)
+            std::vector<Int16>().swap(m_samples);
+        else
+            std::vector<float>().swap(m_floatSamples);
+
         return update(channelCount, sampleRate);
     }
+
+    // Cache miss: decode the file, then store its samples for the next time; they are
+    // stored at the rate of the file, before update() converts them to the rate of the device
+    InputSoundFile file;
+    if (!file.openFromMemory(data, sizeInBytes) || !readSamples(file))
+        return false;
+
+    std::size_t sampleCount = (m_sampleFormat == Float32Samples) ? m_floatSamples.size() : m_samples.size();
+    if (sampleCount > 0)
+    {
+        const void* samples = (m_sampleFormat == Float32Samples) ? static_cast<const void*>(&m_floatSamples[0])
+                                                                 : static_cast<const void*>(&m_samples[0]);
+        priv::SoundBufferCache::store(key, m_sampleFormat, samples, sampleCount, file.getChannelCount(), file.getSampleRate());
+    }
+
+    return update(file.getChannelCount(), file.getSampleRate());
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundBuffer::loadFromEncoded(const void* data, std::size_t sizeInBytes)
+{
+    bool loaded = false;
+    if (priv::SoundBufferCache::isEnabled())
+    {
+        loaded = loadFromCache(data, sizeInBytes);
+    }
     else
     {
+        InputSoundFile file;
+        loaded = file.openFromMemory(data, sizeInBytes) && initialize(file);
+    }
+
+    if (!loaded)
         return false;
+
+    if (m_residency == KeepEncoded)
+        m_encoded.assign(static_cast<const char*>(data), static_cast<const char*>(data) + sizeInBytes);
+    else
+        std::vector<char>().swap(m_encoded);
+
+    applyResidency();
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBuffer::applyResidency()
+{
+    bool release = false;
+    switch (m_residency)
+    {
+        case KeepSamples:    release = false;              break;
+        case KeepEncoded:    release = !m_encoded.empty(); break;
+        case ReleaseSamples: release = true;               break;
+    }
+
+    if (m_residency != KeepEncoded)
+        std::vector<char>().swap(m_encoded);
+
+    if (release)
+    {
+        std::vector<Int16>().swap(m_samples);
+        std::vector<float>().swap(m_floatSamples);
+    }
+
+    updateMemoryUsage(m_deviceBytes);
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundBuffer::restoreSamples(std::vector<Int16>& samples, std::vector<float>& floatSamples) const
+{
+    std::size_t sampleCount = static_cast<std::size_t>(m_sampleCount);
+    if (sampleCount == 0)
+        return true;
+
+    // Decode the file data again if it was kept...
+    if (!m_encoded.empty())
+    {
+        InputSoundFile file;
+        if (!file.openFromMemory(&m_encoded[0], m_encoded.size()))
+            return false;
+
+        // The samples may have been converted to the rate of the device
+        Uint64       fileSampleCount = file.getSampleCount();
+        unsigned int channelCount    = file.getChannelCount();
+        unsigned int sampleRate      = getSampleRate();
+        if (m_sampleFormat == Float32Samples)
+        {
+            floatSamples.resize(static_cast<std::size_t>(fileSampleCount));
+            if (file.read(&floatSamples[0], fileSampleCount) != fileSampleCount)
+                return false;
+
+            if (file.getSampleRate() != sampleRate)
+                resample(floatSamples, channelCount, file.getSampleRate(), sampleRate);
+
+            return floatSamples.size() == sampleCount;
+        }
+        else
+        {
+            samples.resize(static_cast<std::size_t>(fileSampleCount));
+            if (file.read(&samples[0], fileSampleCount) != fileSampleCount)
+                return false;
+
+            if (file.getSampleRate() != sampleRate)
+                resample(samples, channelCount, file.getSampleRate(), sampleRate);
+
+            return samples.size() == sampleCount;
+        }
+    }
+
+    // ... or read the samples back from the audio device
+    unsigned int channelCount = getChannelCount();
+    if ((channelCount == 0) || !priv::AudioDevice::canReadBufferSamples())
+        return false;
+
+    Uint64 frameCount = m_sampleCount / channelCount;
+    if (m_sampleFormat == Float32Samples)
+    {
+        floatSamples.resize(sampleCount);
+        return priv::AudioDevice::readBufferSamples(m_buffer, channelCount, Float32Samples, &floatSamples[0], frameCount);
+    }
+    else
+    {
+        samples.resize(sampleCount);
+        return priv::AudioDevice::readBufferSamples(m_buffer, channelCount, Int16Samples, &samples[0], frameCount);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBuffer::updateMemoryUsage(Uint64 deviceBytes)
+{
+    Uint64 cpuBytes = m_samples.capacity() * sizeof(Int16) +
+                      m_floatSamples.capacity() * sizeof(float) +
+                      m_encoded.capacity();
+
+    Lock lock(memoryMutex);
+
+    totalCpuBytes    = totalCpuBytes - m_cpuBytes + cpuBytes;
+    totalDeviceBytes = totalDeviceBytes - m_deviceBytes + deviceBytes;
+    m_cpuBytes       = cpuBytes;
+    m_deviceBytes    = deviceBytes;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBuffer::cancelLoading()
+{
+    if (m_loadJob)
+    {
+        priv::SoundDecoderPool::cancel(m_loadJob);
+        m_loadJob = NULL;
     }
 }
 
@@ -246,8 +828,14 @@ bool SoundBuffer::initialize(InputSoundFile& file)
 ////////////////////////////////////////////////////////////
 bool SoundBuffer::update(unsigned int channelCount, unsigned int sampleRate)
 {
+    // The new contents replace any pending background load
+    cancelLoading();
+
+    std::size_t sampleCount = (m_sampleFormat == Float32Samples) ? m_floatSamples.size() : m_samples.size();
+    m_sampleCount = sampleCount;
+
     // Check parameters
-    if (!channelCount || !sampleRate || m_samples.empty())
+    if (!channelCount || !sampleRate || !sampleCount)
         return false;
 
     // Find the good format according to the number of channels
@@ -260,6 +848,45 @@ bool SoundBuffer::update(unsigned int channelCount, unsigned int sampleRate)
         return false;
     }
 
+    // Convert the samples to the rate of the device once, rather than at every playback
+    unsigned int deviceSampleRate = priv::AudioDevice::getSampleRate();
+    if (m_resampled && (deviceSampleRate != 0) && (deviceSampleRate != sampleRate))
+    {
+        if (m_sampleFormat == Float32Samples)
+            resample(m_floatSamples, channelCount, sampleRate, deviceSampleRate);
+        else
+            resample(m_samples, channelCount, sampleRate, deviceSampleRate);
+
+        sampleRate  = deviceSampleRate;
+        sampleCount = (m_sampleFormat == Float32Samples) ? m_floatSamples.size() : m_samples.size();
+        m_sampleCount = sampleCount;
+    }
+
+    // Float samples are uploaded as is if the device supports them, and converted otherwise
+    const void*        data = NULL;
+    ALsizei            size = static_cast<ALsizei>(sampleCount * sizeof(Int16));
+    std::vector<Int16> converted;
+    if (m_sampleFormat == Float32Samples)
+    {
+        ALenum floatFormat = priv::AudioDevice::getFormatFromChannelCount(channelCount, Float32Samples);
+        if (floatFormat != 0)
+        {
+            format = floatFormat;
+            data = &m_floatSamples[0];
+            size = static_cast<ALsizei>(sampleCount * sizeof(float));
+        }
+        else
+        {
+            converted.resize(sampleCount);
+            priv::convertSamples(&m_floatSamples[0], &converted[0], sampleCount);
+            data = &converted[0];
+        }
+    }
+    else
+    {
+        data = &m_samples[0];
+    }
+
     // First make a copy of the list of sounds so we can reattach later
     SoundList sounds(m_sounds);
 
@@ -267,12 +894,15 @@ bool SoundBuffer::update(unsigned int channelCount, unsigned int sampleRate)
     for (SoundList::const_iterator it = sounds.begin(); it != sounds.end(); ++it)
         (*it)->resetBuffer();
 
+    // Stop the voices playing the buffer; unlike sounds, they are not resumed with the new samples
+    stopVoices();
+
     // Fill the buffer
-    ALsizei size = static_cast<ALsizei>(m_samples.size() * sizeof(Int16));
-    alCheck(alBufferData(m_buffer, format, &m_samples[0], size, static_cast<ALsizei>(sampleRate)));
+    alCheck(alBufferData(m_buffer, format, data, size, static_cast<ALsizei>(sampleRate)));
+    updateMemoryUsage(static_cast<Uint64>(size));
 
     // Compute the duration
-    m_duration = seconds(static_cast<float>(m_samples.size()) / static_cast<float>(sampleRate) / static_cast<float>(channelCount));
+    m_duration = seconds(static_cast<float>(sampleCount) / static_cast<float>(sampleRate) / static_cast<float>(channelCount));
 
     // Now reattach the buffer to the sounds that use it
     for (SoundList::const_iterator it = sounds.begin(); it != sounds.end(); ++it)
@@ -295,4 +925,30 @@ void SoundBuffer::detachSound(Sound* sound) const
     m_sounds.erase(sound);
 }
 
+
+////////////////////////////////////////////////////////////
+void SoundBuffer::attachVoiceManager(VoiceManager* voiceManager) const
+{
+    m_voiceManagers.insert(voiceManager);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBuffer::detachVoiceManager(VoiceManager* voiceManager) const
+{
+    m_voiceManagers.erase(voiceManager);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBuffer::stopVoices()
+{
+    // Stopping the voices detaches their managers, so iterate over a copy of the list
+    VoiceManagerList voiceManagers;
+    voiceManagers.swap(m_voiceManagers);
+
+    for (VoiceManagerList::const_iterator it = voiceManagers.begin(); it != voiceManagers.end(); ++it)
+        (*it)->stopVoices(*this);
+}
+
 } // namespace sf
@@ -0,0 +1,253 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2023 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/SoundBufferCache.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#if defined(SFML_SYSTEM_WINDOWS)
+    #include <windows.h>
+#else
+    #include <unistd.h>
+#endif
+
+
+namespace
+{
+    sf::Mutex   directoryMutex;
+    std::string directory;
+
+    // Number of temporary files created by this process
+    sf::Uint64 temporaryCount = 0;
+
+    // Must be incremented whenever a change in the decoders alters their output,
+    // so that the entries decoded by the previous version are not used anymore
+    const sf::Uint32 decoderVersion = 1;
+
+    // Magic number of the cache entries, also used to detect a different endianness
+    const sf::Uint32 entryMagic = 0x43504653; // "SFPC"
+
+    // Header of the cache entries, directly followed by the raw samples;
+    // its size keeps the samples aligned so that entries can be mapped in memory
+    struct EntryHeader
+    {
+        sf::Uint32 magic;
+        sf::Uint32 version;
+        sf::Uint32 sampleFormat;
+        sf::Uint32 channelCount;
+        sf::Uint32 sampleRate;
+        sf::Uint32 padding;
+        sf::Uint64 sampleCount;
+    };
+
+    std::size_t getSampleSize(sf::SampleFormat sampleFormat)
+    {
+        return (sampleFormat == sf::Float32Samples) ? sizeof(float) : sizeof(sf::Int16);
+    }
+
+    std::string getEntryPath(sf::Uint64 key, sf::SampleFormat sampleFormat)
+    {
+        sf::Lock lock(directoryMutex);
+
+        std::ostringstream path;
+        path << directory << '/' << std::hex << std::setfill('0') << std::setw(16) << key
+             << ((sampleFormat == sf::Float32Samples) ? ".f32" : ".s16");
+
+        return path.str();
+    }
+
+    // Get a name for a new temporary file, unique to the thread and process which writes it
+    std::string getTemporaryPath(const std::string& path)
+    {
+    #if defined(SFML_SYSTEM_WINDOWS)
+        unsigned long processId = static_cast<unsigned long>(GetCurrentProcessId());
+    #else
+        unsigned long processId = static_cast<unsigned long>(getpid());
+    #endif
+
+        sf::Uint64 index = 0;
+        {
+            sf::Lock lock(directoryMutex);
+            index = temporaryCount++;
+        }
+
+        std::ostringstream temporaryPath;
+        temporaryPath << path << '.' << processId << '.' << index << ".tmp";
+
+        return temporaryPath.str();
+    }
+
+    template <typename T>
+    bool readSamples(std::ifstream& file, std::vector<T>& samples, sf::Uint64 sampleCount)
+    {
+        samples.resize(static_cast<std::size_t>(sampleCount));
+        file.read(reinterpret_cast<char*>(&samples[0]), static_cast<std::streamsize>(sampleCount * sizeof(T)));
+
+        return file.gcount() == static_cast<std::streamsize>(sampleCount * sizeof(T));
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void SoundBufferCache::setDirectory(const std::string& newDirectory)
+{
+    Lock lock(directoryMutex);
+
+    directory = newDirectory;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundBufferCache::isEnabled()
+{
+    Lock lock(directoryMutex);
+
+    return !directory.empty();
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 SoundBufferCache::computeKey(const void* data, std::size_t sizeInBytes)
+{
+    // 64-bit FNV-1a hash, seeded with the decoder version
+    const Uint8* bytes = static_cast<const Uint8*>(data);
+    Uint64 hash = 14695981039346656037ULL ^ decoderVersion;
+    for (std::size_t i = 0; i < sizeInBytes; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundBufferCache::load(Uint64 key, SampleFormat sampleFormat, std::vector<Int16>& samples, std::vector<float>& floatSamples,
+                            unsigned int& channelCount, unsigned int& sampleRate)
+{
+    std::string path = getEntryPath(key, sampleFormat);
+
+    std::ifstream file(path.c_str(), std::ios_base::binary);
+    if (!file)
+        return false;
+
+    // Get the size of the samples stored in the entry, to check the header against it
+    file.seekg(0, std::ios_base::end);
+    Uint64 fileSize = static_cast<Uint64>(file.tellg());
+    file.seekg(0, std::ios_base::beg);
+    Uint64 dataSize = (fileSize > sizeof(EntryHeader)) ? fileSize - sizeof(EntryHeader) : 0;
+
+    // Check that the entry was written by this version, on a machine with the same endianness,
+    // and that it holds exactly its samples, before allocating them
+    EntryHeader header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if ((file.gcount() != static_cast<std::streamsize>(sizeof(header))) ||
+        (header.magic != entryMagic) ||
+        (header.version != decoderVersion) ||
+        (header.sampleFormat != static_cast<Uint32>(sampleFormat)) ||
+        !header.channelCount || !header.sampleRate || !header.sampleCount ||
+        (header.sampleCount != dataSize / getSampleSize(sampleFormat)) ||
+        (dataSize % getSampleSize(sampleFormat) != 0))
+    {
+        file.close();
+        std::remove(path.c_str());
+        return false;
+    }
+
+    bool ok = (sampleFormat == Float32Samples) ? readSamples(file, floatSamples, header.sampleCount)
+                                               : readSamples(file, samples, header.sampleCount);
+
+    if (!ok)
+    {
+        // Truncated entry
+        file.close();
+        std::remove(path.c_str());
+        return false;
+    }
+
+    channelCount = header.channelCount;
+    sampleRate   = header.sampleRate;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBufferCache::store(Uint64 key, SampleFormat sampleFormat, const void* samples, Uint64 sampleCount,
+                             unsigned int channelCount, unsigned int sampleRate)
+{
+    if (!samples || !sampleCount)
+        return;
+
+    std::string path = getEntryPath(key, sampleFormat);
+    std::string temporaryPath = getTemporaryPath(path);
+
+    EntryHeader header;
+    header.magic        = entryMagic;
+    header.version      = decoderVersion;
+    header.sampleFormat = static_cast<Uint32>(sampleFormat);
+    header.channelCount = channelCount;
+    header.sampleRate   = sampleRate;
+    header.padding      = 0;
+    header.sampleCount  = sampleCount;
+
+    // Write to a temporary file first, so that a partially written entry is never loaded;
+    // each writer has its own, as the same entry may be stored by several threads or processes
+    {
+        std::ofstream file(temporaryPath.c_str(), std::ios_base::binary | std::ios_base::trunc);
+        if (!file)
+            return;
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(static_cast<const char*>(samples), static_cast<std::streamsize>(sampleCount * getSampleSize(sampleFormat)));
+
+        if (!file)
+        {
+            file.close();
+            std::remove(temporaryPath.c_str());
+            return;
+        }
+    }
+
+    std::remove(path.c_str());
+    if (std::rename(temporaryPath.c_str(), path.c_str()) != 0)
+        std::remove(temporaryPath.c_str());
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,124 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2023 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SOUNDBUFFERCACHE_HPP
+#define SFML_SOUNDBUFFERCACHE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/SampleFormat.hpp>
+#include <SFML/Config.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief On-disk cache of decoded audio samples
+///
+/// Entries are keyed by a hash of the encoded file contents
+/// and of the decoder version, so that a modified file or an
+/// updated decoder never hits a stale entry.
+///
+////////////////////////////////////////////////////////////
+class SoundBufferCache
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the directory where the cache entries are stored
+    ///
+    /// \param directory Path of the cache directory, or an empty
+    ///                  string to disable the cache
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setDirectory(const std::string& directory);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the cache is enabled
+    ///
+    /// \return True if a cache directory is set
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isEnabled();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the cache key of an encoded sound file
+    ///
+    /// \param data        Pointer to the file data in memory
+    /// \param sizeInBytes Size of the data, in bytes
+    ///
+    /// \return Key identifying the decoded samples of the file
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 computeKey(const void* data, std::size_t sizeInBytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the decoded samples of a file from the cache
+    ///
+    /// Only the vector matching \a sampleFormat is filled.
+    ///
+    /// \param key          Key of the file, see computeKey
+    /// \param sampleFormat Format of the samples to load
+    /// \param samples      Vector to fill with 16-bit samples
+    /// \param floatSamples Vector to fill with float samples
+    /// \param channelCount Variable to fill with the number of channels
+    /// \param sampleRate   Variable to fill with the sample rate
+    ///
+    /// \return True if the entry was found, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool load(Uint64 key, SampleFormat sampleFormat, std::vector<Int16>& samples, std::vector<float>& floatSamples,
+                     unsigned int& channelCount, unsigned int& sampleRate);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Store the decoded samples of a file in the cache
+    ///
+    /// Failures are silently ignored, the cache is only an
+    /// optimization.
+    ///
+    /// \param key          Key of the file, see computeKey
+    /// \param sampleFormat Format of the samples
+    /// \param samples      Pointer to the samples (sf::Int16 or float, according to \a sampleFormat)
+    /// \param sampleCount  Number of samples
+    /// \param channelCount Number of channels
+    /// \param sampleRate   Sample rate
+    ///
+    ////////////////////////////////////////////////////////////
+    static void store(Uint64 key, SampleFormat sampleFormat, const void* samples, Uint64 sampleCount,
+                      unsigned int channelCount, unsigned int sampleRate);
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_SOUNDBUFFERCACHE_HPP
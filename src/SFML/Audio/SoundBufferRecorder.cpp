@@ -27,11 +27,24 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/SoundBufferRecorder.hpp>
 #include <algorithm>
-#include <iterator>
+
+
+namespace
+{
+    // Number of samples in each block of recorded data
+    const std::size_t blockSize = 65536;
+}
 
 
 namespace sf
 {
+////////////////////////////////////////////////////////////
+SoundBufferRecorder::SoundBufferRecorder() :
+m_blockCount(0)
+{
+}
+
+
 ////////////////////////////////////////////////////////////
 SoundBufferRecorder::~SoundBufferRecorder()
 {
@@ -43,7 +56,11 @@ SoundBufferRecorder::~SoundBufferRecorder()
 ////////////////////////////////////////////////////////////
 bool SoundBufferRecorder::onStart()
 {
-    m_samples.clear();
+    // Keep the blocks of the previous capture, so that their memory is reused
+    for (std::size_t i = 0; i < m_blockCount; ++i)
+        m_blocks[i].clear();
+    m_blockCount = 0;
+
     m_buffer = SoundBuffer();
 
     return true;
@@ -53,7 +70,27 @@ bool SoundBufferRecorder::onStart()
 ////////////////////////////////////////////////////////////
 bool SoundBufferRecorder::onProcessSamples(const Int16* samples, std::size_t sampleCount)
 {
-    std::copy(samples, samples + sampleCount, std::back_inserter(m_samples));
+    // Append the samples to fixed-size blocks, so that the recorded data is never moved as it grows
+    while (sampleCount > 0)
+    {
+        if ((m_blockCount == 0) || (m_blocks[m_blockCount - 1].size() == blockSize))
+        {
+            if (m_blockCount == m_blocks.size())
+            {
+                m_blocks.push_back(std::vector<Int16>());
+                m_blocks.back().reserve(blockSize);
+            }
+
+            ++m_blockCount;
+        }
+
+        std::vector<Int16>& block = m_blocks[m_blockCount - 1];
+        std::size_t count = std::min(sampleCount, blockSize - block.size());
+        block.insert(block.end(), samples, samples + count);
+
+        samples     += count;
+        sampleCount -= count;
+    }
 
     return true;
 }
@@ -62,8 +99,20 @@ bool SoundBufferRecorder::onProcessSamples(const Int16* samples, std::size_t sam
 ////////////////////////////////////////////////////////////
 void SoundBufferRecorder::onStop()
 {
-    if (!m_samples.empty())
-        m_buffer.loadFromSamples(&m_samples[0], m_samples.size(), getChannelCount(), getSampleRate());
+    std::size_t sampleCount = 0;
+    for (std::size_t i = 0; i < m_blockCount; ++i)
+        sampleCount += m_blocks[i].size();
+
+    if (sampleCount == 0)
+        return;
+
+    // Assemble the blocks into a single array, allocated once and released as soon as the buffer has its own copy
+    std::vector<Int16> samples(sampleCount);
+    std::vector<Int16>::iterator output = samples.begin();
+    for (std::size_t i = 0; i < m_blockCount; ++i)
+        output = std::copy(m_blocks[i].begin(), m_blocks[i].end(), output);
+
+    m_buffer.loadFromSamples(&samples[0], samples.size(), getChannelCount(), getSampleRate());
 }
 
 
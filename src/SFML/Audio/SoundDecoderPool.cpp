@@ -0,0 +1,334 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2023 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/SoundDecoderPool.hpp>
+#include <SFML/Audio/SoundBufferCache.hpp>
+#include <SFML/Audio/InputSoundFile.hpp>
+#include <SFML/System/FileInputStream.hpp>
+#include <SFML/System/Thread.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+#include <deque>
+
+#if defined(SFML_SYSTEM_WINDOWS)
+    #include <windows.h>
+#else
+    #include <unistd.h>
+#endif
+
+
+namespace
+{
+    // Number of sound buffer instances alive, and its mutex
+    unsigned int count = 0;
+    sf::Mutex countMutex;
+
+    // A worker thread, which holds its mutex while it decodes a job
+    struct Worker
+    {
+        sf::Thread* thread; //!< Thread of the worker
+        sf::Mutex   mutex;  //!< Mutex held while a job is decoded, so that waiting threads can block on it
+        bool        active; //!< Is the thread running? (protected by queueMutex)
+    };
+
+    // The workers, one per processor: each one runs only while there are jobs in the
+    // queue, and is started again by the next job submitted when it is needed
+    std::vector<Worker*> workers;
+
+    // Jobs waiting for a worker, and the mutex protecting them as well as
+    // the state of the workers and of all the jobs
+    std::deque<sf::priv::DecodeJob*> queue;
+    std::size_t idleCount = 0; // Number of running workers which are not decoding a job
+    sf::Mutex queueMutex;
+
+    unsigned int getProcessorCount()
+    {
+    #if defined(SFML_SYSTEM_WINDOWS)
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        long processorCount = static_cast<long>(info.dwNumberOfProcessors);
+    #else
+        long processorCount = sysconf(_SC_NPROCESSORS_ONLN);
+    #endif
+
+        return (processorCount > 0) ? static_cast<unsigned int>(processorCount) : 1;
+    }
+
+    // Read all the samples of a sound file, in the format of the job
+    bool readSamples(sf::InputSoundFile& file, sf::priv::DecodeJob& job)
+    {
+        sf::Uint64 sampleCount = file.getSampleCount();
+        if (!sampleCount)
+            return false;
+
+        job.channelCount = file.getChannelCount();
+        job.sampleRate   = file.getSampleRate();
+
+        if (job.sampleFormat == sf::Float32Samples)
+        {
+            job.floatSamples.resize(static_cast<std::size_t>(sampleCount));
+            return file.read(&job.floatSamples[0], sampleCount) == sampleCount;
+        }
+        else
+        {
+            job.samples.resize(static_cast<std::size_t>(sampleCount));
+            return file.read(&job.samples[0], sampleCount) == sampleCount;
+        }
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void SoundDecoderPool::acquire()
+{
+    Lock lock(countMutex);
+
+    count++;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundDecoderPool::release()
+{
+    Lock lock(countMutex);
+
+    count--;
+
+    // If there's no more buffer alive, their jobs were cancelled and the workers are over
+    if (count == 0)
+    {
+        for (std::vector<Worker*>::iterator it = workers.begin(); it != workers.end(); ++it)
+        {
+            (*it)->thread->wait();
+            delete (*it)->thread;
+            delete *it;
+        }
+
+        workers.clear();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+DecodeJob* SoundDecoderPool::submit(const std::string& filename, SampleFormat sampleFormat)
+{
+    DecodeJob* job = new DecodeJob;
+    job->filename     = filename;
+    job->sampleFormat = sampleFormat;
+    job->channelCount = 0;
+    job->sampleRate   = 0;
+    job->success      = false;
+    job->done         = false;
+    job->worker       = 0;
+
+    // Protect the workers from concurrent starts
+    Lock lock(countMutex);
+
+    if (workers.empty())
+    {
+        unsigned int workerCount = getProcessorCount();
+        for (unsigned int i = 0; i < workerCount; ++i)
+        {
+            Worker* worker = new Worker;
+            worker->thread = new Thread(&SoundDecoderPool::run, static_cast<std::size_t>(i));
+            worker->active = false;
+            workers.push_back(worker);
+        }
+    }
+
+    // Start a worker if the running ones are all busy, and a processor is left
+    Thread* worker = NULL;
+    {
+        Lock queueLock(queueMutex);
+
+        queue.push_back(job);
+
+        for (std::vector<Worker*>::iterator it = workers.begin(); (it != workers.end()) && (idleCount < queue.size()); ++it)
+        {
+            if (!(*it)->active)
+            {
+                (*it)->active = true;
+                ++idleCount;
+                worker = (*it)->thread;
+                break;
+            }
+        }
+    }
+
+    // This joins the previous run of the worker, which is over or about to be
+    if (worker)
+        worker->launch();
+
+    return job;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundDecoderPool::isDone(const DecodeJob& job)
+{
+    Lock lock(queueMutex);
+
+    return job.done;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundDecoderPool::wait(DecodeJob& job)
+{
+    Worker* worker = NULL;
+    {
+        Lock lock(queueMutex);
+
+        if (job.done)
+            return;
+
+        // A job which didn't start yet is decoded right away by the waiting thread
+        std::deque<DecodeJob*>::iterator it = std::find(queue.begin(), queue.end(), &job);
+        if (it != queue.end())
+            queue.erase(it);
+        else
+            worker = workers[job.worker];
+    }
+
+    if (worker)
+    {
+        // The worker holds its mutex until it is done with the job
+        Lock lock(worker->mutex);
+        return;
+    }
+
+    decode(job);
+
+    Lock lock(queueMutex);
+    job.done = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundDecoderPool::cancel(DecodeJob* job)
+{
+    {
+        Lock lock(queueMutex);
+
+        // Jobs which didn't start yet can be removed right away
+        std::deque<DecodeJob*>::iterator it = std::find(queue.begin(), queue.end(), job);
+        if (it != queue.end())
+        {
+            queue.erase(it);
+            job->done = true;
+        }
+    }
+
+    // Otherwise wait until the worker is done with it
+    wait(*job);
+    delete job;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundDecoderPool::run(std::size_t index)
+{
+    Worker& worker = *workers[index];
+
+    for (;;)
+    {
+        // Hold the mutex of the worker from before a job is taken until it is done
+        Lock workerLock(worker.mutex);
+
+        DecodeJob* job = NULL;
+        {
+            Lock lock(queueMutex);
+
+            // Stop when there's nothing left to decode, the next job will start the worker again
+            if (queue.empty())
+            {
+                worker.active = false;
+                --idleCount;
+                return;
+            }
+
+            job = queue.front();
+            queue.pop_front();
+            job->worker = index;
+            --idleCount;
+        }
+
+        decode(*job);
+
+        Lock lock(queueMutex);
+        job->done = true;
+        ++idleCount;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundDecoderPool::decode(DecodeJob& job)
+{
+    if (SoundBufferCache::isEnabled())
+    {
+        // Read the whole file to compute its cache key
+        FileInputStream stream;
+        Int64 size = stream.open(job.filename) ? stream.getSize() : -1;
+        if (size > 0)
+        {
+            std::vector<char> contents(static_cast<std::size_t>(size));
+            if (stream.read(&contents[0], size) == size)
+            {
+                Uint64 key = SoundBufferCache::computeKey(&contents[0], contents.size());
+                job.success = SoundBufferCache::load(key, job.sampleFormat, job.samples, job.floatSamples, job.channelCount, job.sampleRate);
+                if (job.success)
+                    return;
+
+                InputSoundFile file;
+                job.success = file.openFromMemory(&contents[0], contents.size()) && readSamples(file, job);
+                if (job.success)
+                {
+                    const void* samples = (job.sampleFormat == Float32Samples) ? static_cast<const void*>(&job.floatSamples[0])
+                                                                               : static_cast<const void*>(&job.samples[0]);
+                    Uint64 sampleCount = (job.sampleFormat == Float32Samples) ? job.floatSamples.size() : job.samples.size();
+                    SoundBufferCache::store(key, job.sampleFormat, samples, sampleCount, job.channelCount, job.sampleRate);
+                }
+
+                return;
+            }
+        }
+    }
+
+    InputSoundFile file;
+    job.success = file.openFromFile(job.filename) && readSamples(file, job);
+}
+
+} // namespace priv
+
+} // namespace sf
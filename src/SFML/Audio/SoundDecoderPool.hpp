@@ -0,0 +1,164 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2023 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SOUNDDECODERPOOL_HPP
+#define SFML_SOUNDDECODERPOOL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/SampleFormat.hpp>
+#include <SFML/Config.hpp>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Asynchronous decoding of a sound file
+///
+////////////////////////////////////////////////////////////
+struct DecodeJob
+{
+    std::string        filename;     //!< Path of the sound file to decode
+    SampleFormat       sampleFormat; //!< Format of the decoded samples
+    std::vector<Int16> samples;      //!< Decoded samples, for the Int16Samples format
+    std::vector<float> floatSamples; //!< Decoded samples, for the Float32Samples format
+    unsigned int       channelCount; //!< Number of channels of the sound
+    unsigned int       sampleRate;   //!< Sample rate of the sound
+    bool               success;      //!< Did the decoding succeed?
+    bool               done;         //!< Is the job over? (protected by the pool)
+    std::size_t        worker;       //!< Index of the worker decoding the job (protected by the pool)
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Pool of worker threads decoding sound files
+///        in parallel
+///
+/// Each job is decoded entirely by one worker, with its own
+/// decoder; the workers never touch OpenAL, uploading the
+/// samples is left to the thread which owns the job.
+///
+////////////////////////////////////////////////////////////
+class SoundDecoderPool
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Register a new sound buffer instance
+    ///
+    ////////////////////////////////////////////////////////////
+    static void acquire();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Unregister a sound buffer instance
+    ///
+    /// The worker threads are stopped and joined when the
+    /// last sound buffer instance is destroyed.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void release();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue a sound file for decoding
+    ///
+    /// A worker thread is started if the running ones are all
+    /// busy, up to one per processor; the workers stop as soon
+    /// as the queue is empty.
+    ///
+    /// \param filename     Path of the sound file to decode
+    /// \param sampleFormat Format of the decoded samples
+    ///
+    /// \return New job, owned by the caller
+    ///
+    ////////////////////////////////////////////////////////////
+    static DecodeJob* submit(const std::string& filename, SampleFormat sampleFormat);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a job is over
+    ///
+    /// \param job Job to check
+    ///
+    /// \return True if the job is over and no longer accessed by the pool
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isDone(const DecodeJob& job);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until a job is over
+    ///
+    /// A job which is still queued is decoded by the calling
+    /// thread, otherwise this function blocks until the worker
+    /// decoding it is done. Once it returns, the job is no
+    /// longer accessed by the pool. A job must only be waited
+    /// for by a single thread.
+    ///
+    /// \param job Job to wait for
+    ///
+    ////////////////////////////////////////////////////////////
+    static void wait(DecodeJob& job);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Cancel and destroy a job
+    ///
+    /// If the job is still queued it is removed immediately,
+    /// otherwise this function waits until it is over.
+    ///
+    /// \param job Job to cancel
+    ///
+    ////////////////////////////////////////////////////////////
+    static void cancel(DecodeJob* job);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called as the entry point of the workers
+    ///
+    /// The worker decodes the queued jobs, and returns when
+    /// the queue is empty.
+    ///
+    /// \param index Index of the worker
+    ///
+    ////////////////////////////////////////////////////////////
+    static void run(std::size_t index);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode the sound file of a job
+    ///
+    /// \param job Job to process
+    ///
+    ////////////////////////////////////////////////////////////
+    static void decode(DecodeJob& job);
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_SOUNDDECODERPOOL_HPP
@@ -28,6 +28,7 @@
 #include <SFML/Audio/SoundFileReaderFlac.hpp>
 #include <SFML/System/InputStream.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
 #include <cassert>
 
 
@@ -112,36 +113,26 @@ namespace
         if (data->remaining < frameSamples)
             data->leftovers.reserve(static_cast<std::size_t>(frameSamples - data->remaining));
 
+        // Samples are scaled to the full 32-bit range, whatever their original size
+        unsigned int shift = 32 - frame->header.bits_per_sample;
+
         // Decode the samples
         for (unsigned i = 0; i < frame->header.blocksize; ++i)
         {
             for (unsigned int j = 0; j < frame->header.channels; ++j)
             {
                 // Decode the current sample
-                sf::Int16 sample = 0;
-                switch (frame->header.bits_per_sample)
-                {
-                    case 8:
-                        sample = static_cast<sf::Int16>(buffer[j][i] << 8);
-                        break;
-                    case 16:
-                        sample = static_cast<sf::Int16>(buffer[j][i]);
-                        break;
-                    case 24:
-                        sample = static_cast<sf::Int16>(buffer[j][i] >> 8);
-                        break;
-                    case 32:
-                        sample = static_cast<sf::Int16>(buffer[j][i] >> 16);
-                        break;
-                    default:
-                        assert(false);
-                        break;
-                }
+                sf::Int32 sample = static_cast<sf::Int32>(static_cast<sf::Uint32>(buffer[j][i]) << shift);
 
                 if (data->buffer && data->remaining > 0)
                 {
                     // If there's room in the output buffer, copy the sample there
-                    *data->buffer++ = sample;
+                    *data->buffer++ = static_cast<sf::Int16>(sample >> 16);
+                    data->remaining--;
+                }
+                else if (data->floatBuffer && data->remaining > 0)
+                {
+                    *data->floatBuffer++ = static_cast<float>(sample) / 2147483648.f;
                     data->remaining--;
                 }
                 else
@@ -256,6 +247,7 @@ void SoundFileReaderFlac::seek(Uint64 sampleOffset)
 
     // Reset the callback data (the "write" callback will be called)
     m_clientData.buffer = NULL;
+    m_clientData.floatBuffer = NULL;
     m_clientData.remaining = 0;
     m_clientData.leftovers.clear();
 
@@ -280,30 +272,56 @@ void SoundFileReaderFlac::seek(Uint64 sampleOffset)
 
 ////////////////////////////////////////////////////////////
 Uint64 SoundFileReaderFlac::read(Int16* samples, Uint64 maxCount)
+{
+    return decode(samples, NULL, maxCount);
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 SoundFileReaderFlac::readFloat(float* samples, Uint64 maxCount)
+{
+    return decode(NULL, samples, maxCount);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundFileReaderFlac::close()
+{
+    if (m_decoder)
+    {
+        FLAC__stream_decoder_finish(m_decoder);
+        FLAC__stream_decoder_delete(m_decoder);
+        m_decoder = NULL;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 SoundFileReaderFlac::decode(Int16* samples, float* floatSamples, Uint64 maxCount)
 {
     assert(m_decoder);
 
-    // If there are leftovers from previous call, use it first
+    // If there are leftovers from previous call, use them first
     std::size_t left = m_clientData.leftovers.size();
-    if (left > 0)
+    std::size_t used = static_cast<std::size_t>(std::min<Uint64>(left, maxCount));
+    for (std::size_t i = 0; i < used; ++i)
     {
-        if (left > maxCount)
-        {
-            // There are more leftovers than needed
-            std::copy(m_clientData.leftovers.begin(), m_clientData.leftovers.begin() + static_cast<std::vector<Int16>::difference_type>(maxCount), samples);
-            std::vector<Int16> leftovers(m_clientData.leftovers.begin() + static_cast<std::vector<Int16>::difference_type>(maxCount), m_clientData.leftovers.end());
-            m_clientData.leftovers.swap(leftovers);
-            return maxCount;
-        }
+        if (samples)
+            samples[i] = static_cast<Int16>(m_clientData.leftovers[i] >> 16);
         else
-        {
-            // We can use all the leftovers and decode new frames
-            std::copy(m_clientData.leftovers.begin(), m_clientData.leftovers.end(), samples);
-        }
+            floatSamples[i] = static_cast<float>(m_clientData.leftovers[i]) / 2147483648.f;
+    }
+
+    if (left > maxCount)
+    {
+        // There are more leftovers than needed
+        m_clientData.leftovers.erase(m_clientData.leftovers.begin(), m_clientData.leftovers.begin() + static_cast<std::vector<Int32>::difference_type>(used));
+        return maxCount;
     }
 
     // Reset the data that will be used in the callback
-    m_clientData.buffer = samples + left;
+    m_clientData.buffer = samples ? samples + left : NULL;
+    m_clientData.floatBuffer = floatSamples ? floatSamples + left : NULL;
     m_clientData.remaining = maxCount - left;
     m_clientData.leftovers.clear();
 
@@ -320,19 +338,13 @@ Uint64 SoundFileReaderFlac::read(Int16* samples, Uint64 maxCount)
             break;
     }
 
-    return maxCount - m_clientData.remaining;
-}
-
+    // Don't keep pointers to the caller's array
+    Uint64 remaining = m_clientData.remaining;
+    m_clientData.buffer = NULL;
+    m_clientData.floatBuffer = NULL;
+    m_clientData.remaining = 0;
 
-////////////////////////////////////////////////////////////
-void SoundFileReaderFlac::close()
-{
-    if (m_decoder)
-    {
-        FLAC__stream_decoder_finish(m_decoder);
-        FLAC__stream_decoder_delete(m_decoder);
-        m_decoder = NULL;
-    }
+    return maxCount - remaining;
 }
 
 } // namespace priv
@@ -105,6 +105,17 @@ public:
     ////////////////////////////////////////////////////////////
     virtual Uint64 read(Int16* samples, Uint64 maxCount);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Read audio samples from the open file, as normalized floats
+    ///
+    /// \param samples  Pointer to the sample array to fill
+    /// \param maxCount Maximum number of samples to read
+    ///
+    /// \return Number of samples actually read (may be less than \a maxCount)
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Uint64 readFloat(float* samples, Uint64 maxCount);
+
 public:
 
     ////////////////////////////////////////////////////////////
@@ -116,8 +127,9 @@ public:
         InputStream*          stream;
         SoundFileReader::Info info;
         Int16*                buffer;
+        float*                floatBuffer;
         Uint64                remaining;
-        std::vector<Int16>    leftovers;
+        std::vector<Int32>    leftovers; // scaled to the full 32-bit range
         bool                  error;
     };
 
@@ -129,6 +141,18 @@ private:
     ////////////////////////////////////////////////////////////
     void close();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode samples into either a 16-bit or a float array
+    ///
+    /// \param samples      Pointer to the 16-bit sample array to fill, or NULL
+    /// \param floatSamples Pointer to the float sample array to fill, or NULL
+    /// \param maxCount     Maximum number of samples to read
+    ///
+    /// \return Number of samples actually read (may be less than \a maxCount)
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 decode(Int16* samples, float* floatSamples, Uint64 maxCount);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
@@ -30,6 +30,7 @@
 #define NOMINMAX               // To avoid windows.h and std::min issue
 #endif
 #define MINIMP3_NO_STDIO       // Minimp3 control define, eliminate file manipulation code which is useless here
+#define MINIMP3_FLOAT_OUTPUT   // Minimp3 control define, decode to float samples (converted on demand for 16-bit reads)
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -49,11 +50,13 @@
 
 #undef NOMINMAX
 #undef MINIMP3_NO_STDIO
+#undef MINIMP3_FLOAT_OUTPUT
 
 #include <SFML/Audio/SoundFileReaderMp3.hpp>
 #include <SFML/System/InputStream.hpp>
 #include <SFML/System/Err.hpp>
 #include <algorithm>
+#include <cstdlib>
 #include <cstring>
 #include <stdint.h>
 
@@ -152,6 +155,30 @@ void SoundFileReaderMp3::seek(Uint64 sampleOffset)
 
 ////////////////////////////////////////////////////////////
 Uint64 SoundFileReaderMp3::read(Int16* samples, Uint64 maxCount)
+{
+    Uint64 toRead = std::min(maxCount, m_numSamples - m_position);
+    Uint64 count = 0;
+
+    // Convert the decoded frames straight from the decoder's internal buffer
+    mp3dec_frame_info_t frameInfo;
+    while (count < toRead)
+    {
+        float* frame = NULL;
+        std::size_t frameSamples = mp3dec_ex_read_frame(&m_decoder, &frame, &frameInfo, static_cast<std::size_t>(toRead - count));
+        if (frameSamples == 0)
+            break;
+
+        mp3dec_f32_to_s16(frame, samples + count, static_cast<int>(frameSamples));
+        count += frameSamples;
+    }
+
+    m_position += count;
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 SoundFileReaderMp3::readFloat(float* samples, Uint64 maxCount)
 {
     Uint64 toRead = std::min(maxCount, m_numSamples - m_position);
     toRead = static_cast<Uint64>(mp3dec_ex_read(&m_decoder, samples, static_cast<std::size_t>(toRead)));
@@ -159,6 +186,70 @@ Uint64 SoundFileReaderMp3::read(Int16* samples, Uint64 maxCount)
     return toRead;
 }
 
+
+////////////////////////////////////////////////////////////
+bool SoundFileReaderMp3::getSeekTable(std::vector<SeekPoint>& table)
+{
+    // Seeking to the current position builds the index if needed
+    if (!m_decoder.indexes_built)
+        mp3dec_ex_seek(&m_decoder, m_position);
+
+    if (!m_decoder.indexes_built || !m_decoder.index.frames)
+        return false;
+
+    table.resize(m_decoder.index.num_frames);
+    for (std::size_t i = 0; i < table.size(); ++i)
+    {
+        table[i].sampleOffset = m_decoder.index.frames[i].sample;
+        table[i].byteOffset   = m_decoder.index.frames[i].offset;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundFileReaderMp3::setSeekTable(const std::vector<SeekPoint>& table)
+{
+    // The index built by the decoder is exact already, the table is ignored
+    if (m_decoder.indexes_built)
+        return false;
+
+    // The first frame must be the one found when opening the file, and the frames must be ordered
+    InputStream* stream = static_cast<InputStream*>(m_io.read_data);
+    if (table.empty() || (table[0].byteOffset != m_decoder.start_offset) || (table.back().sampleOffset > m_numSamples + static_cast<Uint64>(m_decoder.start_delay)))
+        return false;
+
+    Int64 streamSize = stream->getSize();
+    if ((streamSize >= 0) && (table.back().byteOffset >= static_cast<Uint64>(streamSize)))
+        return false;
+
+    for (std::size_t i = 1; i < table.size(); ++i)
+    {
+        if ((table[i].byteOffset <= table[i - 1].byteOffset) || (table[i].sampleOffset < table[i - 1].sampleOffset))
+            return false;
+    }
+
+    // The decoder owns its index and releases it with free()
+    mp3dec_frame_t* frames = static_cast<mp3dec_frame_t*>(std::malloc(table.size() * sizeof(mp3dec_frame_t)));
+    if (!frames)
+        return false;
+
+    for (std::size_t i = 0; i < table.size(); ++i)
+    {
+        frames[i].sample = table[i].sampleOffset;
+        frames[i].offset = table[i].byteOffset;
+    }
+
+    std::free(m_decoder.index.frames);
+    m_decoder.index.frames     = frames;
+    m_decoder.index.num_frames = table.size();
+    m_decoder.index.capacity   = table.size();
+    m_decoder.indexes_built    = 1;
+
+    return true;
+}
+
 } // namespace priv
 
 } // namespace sf
@@ -32,6 +32,7 @@
 #define NOMINMAX               // To avoid windows.h and std::min issue
 #endif
 #define MINIMP3_NO_STDIO  // Minimp3 control define, eliminate file manipulation code which is useless here
+#define MINIMP3_FLOAT_OUTPUT // Minimp3 control define, decode to float samples (converted on demand for 16-bit reads)
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -46,6 +47,7 @@
 
 #undef NOMINMAX
 #undef MINIMP3_NO_STDIO
+#undef MINIMP3_FLOAT_OUTPUT
 
 #include <SFML/Audio/SoundFileReader.hpp>
 #include <vector>
@@ -124,6 +126,46 @@ public:
     ////////////////////////////////////////////////////////////
     virtual Uint64 read(Int16* samples, Uint64 maxCount);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Read audio samples from the open file, as normalized floats
+    ///
+    /// \param samples  Pointer to the sample array to fill
+    /// \param maxCount Maximum number of samples to read
+    ///
+    /// \return Number of samples actually read (may be less than \a maxCount)
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Uint64 readFloat(float* samples, Uint64 maxCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the seek table of the open file
+    ///
+    /// The table holds the position of every frame. If the
+    /// file has a VBR tag, the table is only built by the first
+    /// seek, which scans the whole file; this function builds
+    /// it if needed.
+    ///
+    /// \param table Vector to fill with the seek table
+    ///
+    /// \return True if the table could be built
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool getSeekTable(std::vector<SeekPoint>& table);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Provide the seek table of the open file
+    ///
+    /// This avoids scanning the whole file on the first seek.
+    /// The table is ignored if the file was already scanned.
+    ///
+    /// \param table Seek table of the file
+    ///
+    /// \return True if the table is used by the reader, false if
+    ///         it doesn't match the file or the file was already scanned
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool setSeekTable(const std::vector<SeekPoint>& table);
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -163,6 +163,38 @@ Uint64 SoundFileReaderOgg::read(Int16* samples, Uint64 maxCount)
 }
 
 
+////////////////////////////////////////////////////////////
+Uint64 SoundFileReaderOgg::readFloat(float* samples, Uint64 maxCount)
+{
+    assert(m_vorbis.datasource);
+
+    // Try to read the requested number of frames, stop only on error or end of file
+    Uint64 count = 0;
+    while (maxCount - count >= m_channelCount)
+    {
+        float** channels = NULL;
+        int framesToRead = static_cast<int>(std::min<Uint64>((maxCount - count) / m_channelCount, 4096));
+        long framesRead = ov_read_float(&m_vorbis, &channels, framesToRead, NULL);
+        if (framesRead > 0)
+        {
+            // Vorbis decodes planar channels, interleave them
+            for (long i = 0; i < framesRead; ++i)
+                for (unsigned int j = 0; j < m_channelCount; ++j)
+                    *samples++ = channels[j][i];
+
+            count += static_cast<Uint64>(framesRead) * m_channelCount;
+        }
+        else
+        {
+            // error or end of file
+            break;
+        }
+    }
+
+    return count;
+}
+
+
 ////////////////////////////////////////////////////////////
 void SoundFileReaderOgg::close()
 {
@@ -26,6 +26,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/SoundFileReaderWav.hpp>
+#include <SFML/Audio/SampleConversion.hpp>
 #include <SFML/System/InputStream.hpp>
 #include <SFML/System/Err.hpp>
 #include <algorithm>
@@ -39,22 +40,6 @@ namespace
     // The following functions read integers as little endian and
     // return them in the host byte order
 
-    bool decode(sf::InputStream& stream, sf::Uint8& value)
-    {
-         return static_cast<std::size_t>(stream.read(&value, sizeof(value))) == sizeof(value);
-    }
-
-    bool decode(sf::InputStream& stream, sf::Int16& value)
-    {
-        unsigned char bytes[sizeof(value)];
-        if (static_cast<std::size_t>(stream.read(bytes, static_cast<sf::Int64>(sizeof(bytes)))) != sizeof(bytes))
-            return false;
-
-        value = static_cast<sf::Int16>(bytes[0] | (bytes[1] << 8));
-
-        return true;
-    }
-
     bool decode(sf::InputStream& stream, sf::Uint16& value)
     {
         unsigned char bytes[sizeof(value)];
@@ -66,17 +51,6 @@ namespace
         return true;
     }
 
-    bool decode24bit(sf::InputStream& stream, sf::Uint32& value)
-    {
-        unsigned char bytes[3];
-        if (static_cast<std::size_t>(stream.read(bytes, static_cast<sf::Int64>(sizeof(bytes)))) != sizeof(bytes))
-            return false;
-
-        value = static_cast<sf::Uint32>(bytes[0] | (bytes[1] << 8) | (bytes[2] << 16));
-
-        return true;
-    }
-
     bool decode(sf::InputStream& stream, sf::Uint32& value)
     {
         unsigned char bytes[sizeof(value)];
@@ -90,6 +64,14 @@ namespace
 
     const sf::Uint64 mainChunkSize = 12;
 
+    const std::size_t blockSize = 65536;
+
+    bool isLittleEndian()
+    {
+        const sf::Uint16 value = 1;
+        return *reinterpret_cast<const sf::Uint8*>(&value) == 1;
+    }
+
     const sf::Uint16 waveFormatPcm = 1;
 
     const sf::Uint16 waveFormatExtensible= 65534;
@@ -120,7 +102,8 @@ SoundFileReaderWav::SoundFileReaderWav() :
 m_stream        (NULL),
 m_bytesPerSample(0),
 m_dataStart     (0),
-m_dataEnd       (0)
+m_dataEnd       (0),
+m_block         ()
 {
 }
 
@@ -152,68 +135,14 @@ void SoundFileReaderWav::seek(Uint64 sampleOffset)
 ////////////////////////////////////////////////////////////
 Uint64 SoundFileReaderWav::read(Int16* samples, Uint64 maxCount)
 {
-    assert(m_stream);
-
-    Uint64 count = 0;
-    Uint64 startPos = static_cast<Uint64>(m_stream->tell());
-
-    // Tracking of m_dataEnd is important to prevent sf::Music from reading
-    // data until EOF, as WAV files may have metadata at the end.
-    while ((count < maxCount) && (startPos + count * m_bytesPerSample < m_dataEnd))
-    {
-        switch (m_bytesPerSample)
-        {
-            case 1:
-            {
-                Uint8 sample = 0;
-                if (decode(*m_stream, sample))
-                    *samples++ = static_cast<Int16>((static_cast<Int16>(sample) - 128) << 8);
-                else
-                    return count;
-                break;
-            }
-
-            case 2:
-            {
-                Int16 sample = 0;
-                if (decode(*m_stream, sample))
-                    *samples++ = sample;
-                else
-                    return count;
-                break;
-            }
-
-            case 3:
-            {
-                Uint32 sample = 0;
-                if (decode24bit(*m_stream, sample))
-                    *samples++ = static_cast<Int16>(sample >> 8);
-                else
-                    return count;
-                break;
-            }
-
-            case 4:
-            {
-                Uint32 sample = 0;
-                if (decode(*m_stream, sample))
-                    *samples++ = static_cast<Int16>(sample >> 16);
-                else
-                    return count;
-                break;
-            }
-
-            default:
-            {
-                assert(false);
-                return 0;
-            }
-        }
+    return readSamples(samples, NULL, maxCount);
+}
 
-        ++count;
-    }
 
-    return count;
+////////////////////////////////////////////////////////////
+Uint64 SoundFileReaderWav::readFloat(float* samples, Uint64 maxCount)
+{
+    return readSamples(NULL, samples, maxCount);
 }
 
 
@@ -352,6 +281,68 @@ bool SoundFileReaderWav::parseHeader(Info& info)
     return true;
 }
 
+
+////////////////////////////////////////////////////////////
+Uint64 SoundFileReaderWav::readSamples(Int16* samples, float* floatSamples, Uint64 maxCount)
+{
+    assert(m_stream);
+
+    // Tracking of m_dataEnd is important to prevent sf::Music from reading
+    // data until EOF, as WAV files may have metadata at the end.
+    Int64 position = m_stream->tell();
+    if ((position < 0) || (static_cast<Uint64>(position) >= m_dataEnd))
+        return 0;
+
+    Uint64 toRead = std::min(maxCount, (m_dataEnd - static_cast<Uint64>(position)) / m_bytesPerSample);
+
+    // 16-bit little endian samples are already in the requested format
+    if (samples && (m_bytesPerSample == 2) && isLittleEndian())
+    {
+        Int64 bytesRead = m_stream->read(samples, static_cast<Int64>(toRead * 2));
+        if (bytesRead <= 0)
+            return 0;
+
+        // A short read may end in the middle of a sample: go back to its start, so that the next read gets it whole
+        Uint64 count = static_cast<Uint64>(bytesRead) / 2;
+        if (static_cast<Uint64>(bytesRead) % 2 != 0)
+            m_stream->seek(position + static_cast<Int64>(count * 2));
+
+        return count;
+    }
+
+    // Read the raw data by large blocks and convert them at once
+    m_block.resize(blockSize);
+    std::size_t blockSamples = blockSize / m_bytesPerSample;
+
+    Uint64 count = 0;
+    while (count < toRead)
+    {
+        std::size_t toConvert = static_cast<std::size_t>(std::min<Uint64>(toRead - count, blockSamples));
+        Int64 bytesRead = m_stream->read(&m_block[0], static_cast<Int64>(toConvert * m_bytesPerSample));
+        if (bytesRead <= 0)
+            break;
+
+        std::size_t converted = static_cast<std::size_t>(bytesRead) / m_bytesPerSample;
+        if (samples)
+            convertPcmSamples(&m_block[0], m_bytesPerSample, samples + count, converted);
+        else
+            convertPcmSamples(&m_block[0], m_bytesPerSample, floatSamples + count, converted);
+        count += converted;
+
+        // Stop on error or end of file
+        if (converted < toConvert)
+        {
+            // The read may have ended in the middle of a sample: go back to its start
+            if (static_cast<std::size_t>(bytesRead) % m_bytesPerSample != 0)
+                m_stream->seek(position + static_cast<Int64>(count * m_bytesPerSample));
+
+            break;
+        }
+    }
+
+    return count;
+}
+
 } // namespace priv
 
 } // namespace sf
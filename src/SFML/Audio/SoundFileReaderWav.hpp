@@ -29,6 +29,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/SoundFileReader.hpp>
+#include <vector>
 #include <string>
 
 
@@ -97,6 +98,17 @@ public:
     ////////////////////////////////////////////////////////////
     virtual Uint64 read(Int16* samples, Uint64 maxCount);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Read audio samples from the open file, as normalized floats
+    ///
+    /// \param samples  Pointer to the sample array to fill
+    /// \param maxCount Maximum number of samples to read
+    ///
+    /// \return Number of samples actually read (may be less than \a maxCount)
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Uint64 readFloat(float* samples, Uint64 maxCount);
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -109,13 +121,30 @@ private:
     ////////////////////////////////////////////////////////////
     bool parseHeader(Info& info);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Read samples into either a 16-bit or a float array
+    ///
+    /// The raw data is read by large blocks and converted
+    /// at once, except for 16-bit samples on little endian
+    /// hosts which are read directly into the 16-bit array.
+    ///
+    /// \param samples      Pointer to the 16-bit sample array to fill, or NULL
+    /// \param floatSamples Pointer to the float sample array to fill, or NULL
+    /// \param maxCount     Maximum number of samples to read
+    ///
+    /// \return Number of samples actually read (may be less than \a maxCount)
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 readSamples(Int16* samples, float* floatSamples, Uint64 maxCount);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    InputStream* m_stream;         //!< Source stream to read from
-    unsigned int m_bytesPerSample; //!< Size of a sample, in bytes
-    Uint64       m_dataStart;      //!< Starting position of the audio data in the open file
-    Uint64       m_dataEnd;        //!< Position one byte past the end of the audio data in the open file
+    InputStream*       m_stream;         //!< Source stream to read from
+    unsigned int       m_bytesPerSample; //!< Size of a sample, in bytes
+    Uint64             m_dataStart;      //!< Starting position of the audio data in the open file
+    Uint64             m_dataEnd;        //!< Position one byte past the end of the audio data in the open file
+    std::vector<Uint8> m_block;          //!< Raw data read from the file, before conversion
 };
 
 } // namespace priv
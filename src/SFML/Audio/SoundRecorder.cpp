@@ -28,8 +28,11 @@
 #include <SFML/Audio/SoundRecorder.hpp>
 #include <SFML/Audio/AudioDevice.hpp>
 #include <SFML/Audio/ALCheck.hpp>
+#include <SFML/Audio/RingBuffer.hpp>
 #include <SFML/System/Sleep.hpp>
+#include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
 #include <cstring>
 #include <cassert>
 
@@ -59,7 +62,11 @@ m_sampleRate        (0),
 m_processingInterval(milliseconds(100)),
 m_isCapturing       (false),
 m_deviceName        (getDefaultDevice()),
-m_channelCount      (1)
+m_channelCount      (1),
+m_ring              (new priv::RingBuffer<Int16>),
+m_ringDuration      (Time::Zero),
+m_overrunCount      (0),
+m_droppedSampleCount(0)
 {
 
 }
@@ -74,6 +81,8 @@ SoundRecorder::~SoundRecorder()
     // thread finishes before the derived object is destroyed. Otherwise a
     // "pure virtual method called" exception is triggered.
     assert(!m_isCapturing && "You must call stop() in the destructor of your derived class, so that the recording thread finishes before your object is destroyed.");
+
+    delete m_ring;
 }
 
 
@@ -105,8 +114,21 @@ bool SoundRecorder::start(unsigned int sampleRate)
         return false;
     }
 
-    // Clear the array of samples
+    // Clear the array of samples, and make room for the whole capture buffer of the device so that it never grows
     m_samples.clear();
+    m_samples.reserve(static_cast<std::size_t>(sampleRate) * m_channelCount);
+
+    // Allocate the ring buffer once for the whole capture, in buffered mode
+    std::size_t ringFrames = 0;
+    if (m_ringDuration > Time::Zero)
+        ringFrames = std::max(static_cast<std::size_t>(m_ringDuration.asSeconds() * static_cast<float>(sampleRate)), static_cast<std::size_t>(1));
+    m_ring->resize(ringFrames * m_channelCount);
+
+    {
+        Lock lock(m_overrunMutex);
+        m_overrunCount       = 0;
+        m_droppedSampleCount = 0;
+    }
 
     // Store the sample rate
     m_sampleRate = sampleRate;
@@ -265,6 +287,73 @@ void SoundRecorder::setProcessingInterval(Time interval)
 }
 
 
+////////////////////////////////////////////////////////////
+void SoundRecorder::setRingBufferDuration(Time duration)
+{
+    if (m_isCapturing)
+    {
+        err() << "It's not possible to change the ring buffer while recording." << std::endl;
+        return;
+    }
+
+    m_ringDuration = std::max(duration, Time::Zero);
+}
+
+
+////////////////////////////////////////////////////////////
+Time SoundRecorder::getRingBufferDuration() const
+{
+    return m_ringDuration;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SoundRecorder::readSamples(Int16* samples, std::size_t maxCount)
+{
+    // Only read whole frames
+    return m_ring->read(samples, maxCount - maxCount % m_channelCount);
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundRecorder::readFrame(Int16* samples, std::size_t sampleCount)
+{
+    // Only read whole frames, so that the ring buffer stays aligned on frames
+    if (sampleCount % m_channelCount != 0)
+        return false;
+
+    // The capture thread can only make more samples available, so the check stays valid
+    if (m_ring->getReadableCount() < sampleCount)
+        return false;
+
+    m_ring->read(samples, sampleCount);
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SoundRecorder::getAvailableSampleCount() const
+{
+    return m_ring->getReadableCount();
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 SoundRecorder::getOverrunCount() const
+{
+    Lock lock(m_overrunMutex);
+    return m_overrunCount;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 SoundRecorder::getDroppedSampleCount() const
+{
+    Lock lock(m_overrunMutex);
+    return m_droppedSampleCount;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool SoundRecorder::onStart()
 {
@@ -304,10 +393,15 @@ void SoundRecorder::processCapturedSamples()
     ALCint samplesAvailable;
     alcGetIntegerv(captureDevice, ALC_CAPTURE_SAMPLES, 1, &samplesAvailable);
 
-    if (samplesAvailable > 0)
+    if (samplesAvailable <= 0)
+        return;
+
+    std::size_t frameCount = static_cast<std::size_t>(samplesAvailable);
+
+    if (m_ring->getCapacity() == 0)
     {
-        // Get the recorded samples
-        m_samples.resize(static_cast<unsigned int>(samplesAvailable) * getChannelCount());
+        // Get the recorded samples (the array was reserved for the whole capture buffer, it doesn't reallocate)
+        m_samples.resize(frameCount * m_channelCount);
         alcCaptureSamples(captureDevice, &m_samples[0], samplesAvailable);
 
         // Forward them to the derived class
@@ -316,6 +410,32 @@ void SoundRecorder::processCapturedSamples()
             // The user wants to stop the capture
             m_isCapturing = false;
         }
+
+        return;
+    }
+
+    // Capture the samples directly into the ring buffer
+    while (frameCount > 0)
+    {
+        Int16* region = NULL;
+        std::size_t frames = std::min(frameCount, m_ring->beginWrite(region) / m_channelCount);
+        if (frames == 0)
+            break;
+
+        alcCaptureSamples(captureDevice, region, static_cast<ALCsizei>(frames));
+        m_ring->endWrite(frames * m_channelCount);
+        frameCount -= frames;
+    }
+
+    if (frameCount > 0)
+    {
+        // The ring buffer is full: drain the device anyway so that the capture keeps running, and drop the samples
+        m_samples.resize(frameCount * m_channelCount);
+        alcCaptureSamples(captureDevice, &m_samples[0], static_cast<ALCsizei>(frameCount));
+
+        Lock lock(m_overrunMutex);
+        ++m_overrunCount;
+        m_droppedSampleCount += m_samples.size();
     }
 }
 
@@ -27,6 +27,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/SoundSource.hpp>
 #include <SFML/Audio/ALCheck.hpp>
+#include <SFML/Audio/AudioDevice.hpp>
 
 #if defined(__APPLE__)
     #if defined(__clang__)
@@ -97,6 +98,18 @@ void SoundSource::setPosition(const Vector3f& position)
 }
 
 
+////////////////////////////////////////////////////////////
+void SoundSource::setPositions(SoundSource* const* sources, const Vector3f* positions, std::size_t count)
+{
+    priv::AudioDevice::beginDeferredUpdates();
+
+    for (std::size_t i = 0; i < count; ++i)
+        alCheck(alSource3f(sources[i]->m_source, AL_POSITION, positions[i].x, positions[i].y, positions[i].z));
+
+    priv::AudioDevice::endDeferredUpdates();
+}
+
+
 ////////////////////////////////////////////////////////////
 void SoundSource::setRelativeToListener(bool relative)
 {
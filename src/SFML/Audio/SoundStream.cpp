@@ -26,15 +26,13 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/SoundStream.hpp>
+#include <SFML/Audio/SoundStreamScheduler.hpp>
 #include <SFML/Audio/AudioDevice.hpp>
+#include <SFML/Audio/SampleConversion.hpp>
 #include <SFML/Audio/ALCheck.hpp>
-#include <SFML/System/Sleep.hpp>
 #include <SFML/System/Err.hpp>
 #include <SFML/System/Lock.hpp>
-
-#ifdef _MSC_VER
-    #pragma warning(disable: 4355) // 'this' used in base member initializer list
-#endif
+#include <algorithm>
 
 #if defined(__APPLE__)
     #if defined(__clang__)
@@ -44,24 +42,45 @@
     #endif
 #endif
 
+namespace
+{
+    // Check whether a chunk returned by onGetData contains samples, in the format of the stream
+    bool hasSamples(const sf::SoundStream::Chunk& chunk, sf::SampleFormat sampleFormat)
+    {
+        const void* samples = (sampleFormat == sf::Float32Samples) ? static_cast<const void*>(chunk.floatSamples)
+                                                                   : static_cast<const void*>(chunk.samples);
+        return (samples != NULL) && (chunk.sampleCount != 0);
+    }
+}
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 SoundStream::SoundStream() :
-m_thread          (&SoundStream::streamData, this),
 m_threadMutex     (),
+m_streamingMutex  (),
 m_threadStartState(Stopped),
 m_isStreaming     (false),
+m_hasStarted      (false),
+m_requestStop     (false),
+m_schedulerSlot   (static_cast<std::size_t>(-1)),
 m_buffers         (),
+m_bufferCount     (3),
+m_activeBufferCount(0),
+m_chunkDuration   (seconds(1)),
+m_underrunCount   (0),
 m_channelCount    (0),
 m_sampleRate      (0),
 m_format          (0),
+m_sampleFormat    (Int16Samples),
+m_convertSamples  (false),
+m_convertedSamples(),
 m_loop            (false),
 m_samplesProcessed(0),
 m_bufferSeeks     (),
 m_processingInterval(milliseconds(10))
 {
-
+    priv::SoundStreamScheduler::acquire();
 }
 
 
@@ -70,27 +89,34 @@ SoundStream::~SoundStream()
 {
     // Stop the sound if it was playing
 
-    // Request the thread to terminate
+    // Request the streaming to terminate
     {
         Lock lock(m_threadMutex);
         m_isStreaming = false;
     }
 
-    // Wait for the thread to terminate
-    m_thread.wait();
+    // Wait for the streaming thread to leave this stream
+    priv::SoundStreamScheduler::remove(*this);
+
+    priv::SoundStreamScheduler::release();
 }
 
 
 ////////////////////////////////////////////////////////////
-void SoundStream::initialize(unsigned int channelCount, unsigned int sampleRate)
+void SoundStream::initialize(unsigned int channelCount, unsigned int sampleRate, SampleFormat sampleFormat)
 {
     m_channelCount = channelCount;
     m_sampleRate = sampleRate;
+    m_sampleFormat = sampleFormat;
     m_samplesProcessed = 0;
     m_isStreaming = false;
 
-    // Deduce the format from the number of channels
-    m_format = priv::AudioDevice::getFormatFromChannelCount(channelCount);
+    // Deduce the format from the number of channels and the sample format
+    // (float samples fall back to a 16-bit format, they are converted before being queued)
+    m_format = priv::AudioDevice::getFormatFromChannelCount(channelCount, sampleFormat);
+    m_convertSamples = (m_format == 0) && (sampleFormat == Float32Samples);
+    if (m_convertSamples)
+        m_format = priv::AudioDevice::getFormatFromChannelCount(channelCount);
 
     // Check if the format is valid
     if (m_format == 0)
@@ -146,10 +172,13 @@ void SoundStream::play()
         onSeek(Time::Zero);
     }
 
-    // Start updating the stream in a separate thread to avoid blocking the application
-    m_isStreaming = true;
-    m_threadStartState = Playing;
-    m_thread.launch();
+    // Start updating the stream in the streaming thread to avoid blocking the application
+    {
+        Lock lock(m_threadMutex);
+        m_isStreaming = true;
+        m_threadStartState = Playing;
+    }
+    priv::SoundStreamScheduler::add(*this);
 }
 
 
@@ -173,14 +202,14 @@ void SoundStream::pause()
 ////////////////////////////////////////////////////////////
 void SoundStream::stop()
 {
-    // Request the thread to terminate
+    // Request the streaming to terminate
     {
         Lock lock(m_threadMutex);
         m_isStreaming = false;
     }
 
-    // Wait for the thread to terminate
-    m_thread.wait();
+    // Wait for the streaming thread to leave this stream
+    priv::SoundStreamScheduler::remove(*this);
 
     // Move to the beginning
     onSeek(Time::Zero);
@@ -201,6 +230,13 @@ unsigned int SoundStream::getSampleRate() const
 }
 
 
+////////////////////////////////////////////////////////////
+SampleFormat SoundStream::getSampleFormat() const
+{
+    return m_sampleFormat;
+}
+
+
 ////////////////////////////////////////////////////////////
 SoundStream::Status SoundStream::getStatus() const
 {
@@ -237,9 +273,12 @@ void SoundStream::setPlayingOffset(Time timeOffset)
     if (oldStatus == Stopped)
         return;
 
-    m_isStreaming = true;
-    m_threadStartState = oldStatus;
-    m_thread.launch();
+    {
+        Lock lock(m_threadMutex);
+        m_isStreaming = true;
+        m_threadStartState = oldStatus;
+    }
+    priv::SoundStreamScheduler::add(*this);
 }
 
 
@@ -274,6 +313,63 @@ bool SoundStream::getLoop() const
 }
 
 
+////////////////////////////////////////////////////////////
+void SoundStream::setBufferCount(unsigned int count)
+{
+    m_bufferCount = std::max(2u, std::min(count, static_cast<unsigned int>(MaxBufferCount)));
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int SoundStream::getBufferCount() const
+{
+    return m_bufferCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStream::setChunkDuration(Time duration)
+{
+    // The duration is read by the streaming thread
+    Lock lock(m_threadMutex);
+    m_chunkDuration = std::max(duration, milliseconds(1));
+}
+
+
+////////////////////////////////////////////////////////////
+Time SoundStream::getChunkDuration() const
+{
+    Lock lock(m_threadMutex);
+    return m_chunkDuration;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStream::setLowLatency(bool lowLatency)
+{
+    if (lowLatency)
+    {
+        setBufferCount(4);
+        setChunkDuration(milliseconds(10));
+        setProcessingInterval(milliseconds(5));
+    }
+    else
+    {
+        setBufferCount(3);
+        setChunkDuration(seconds(1));
+        setProcessingInterval(milliseconds(10));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 SoundStream::getUnderrunCount() const
+{
+    Lock lock(m_threadMutex);
+    return m_underrunCount;
+}
+
+
 ////////////////////////////////////////////////////////////
 Int64 SoundStream::onLoop()
 {
@@ -288,136 +384,149 @@ void SoundStream::setProcessingInterval(Time interval)
 }
 
 ////////////////////////////////////////////////////////////
-void SoundStream::streamData()
+bool SoundStream::updateStream()
 {
-    bool requestStop = false;
-
+    if (!m_hasStarted)
     {
-        Lock lock(m_threadMutex);
-
-        // Check if the thread was launched Stopped
-        if (m_threadStartState == Stopped)
         {
-            m_isStreaming = false;
-            return;
+            Lock lock(m_threadMutex);
+
+            // Check if the stream was launched Stopped
+            if (m_threadStartState == Stopped)
+            {
+                m_isStreaming = false;
+                return false;
+            }
         }
-    }
 
-    // Create the buffers
-    alCheck(alGenBuffers(BufferCount, m_buffers));
-    for (int i = 0; i < BufferCount; ++i)
-        m_bufferSeeks[i] = NoLoop;
+        // Create the buffers
+        m_activeBufferCount = m_bufferCount;
+        alCheck(alGenBuffers(static_cast<ALsizei>(m_activeBufferCount), m_buffers));
+        for (unsigned int i = 0; i < m_activeBufferCount; ++i)
+            m_bufferSeeks[i] = NoLoop;
+        m_hasStarted = true;
 
-    // Fill the queue
-    requestStop = fillQueue();
+        // Fill the queue
+        m_requestStop = fillQueue();
 
-    // Play the sound
-    alCheck(alSourcePlay(m_source));
+        // Play the sound
+        alCheck(alSourcePlay(m_source));
 
-    {
-        Lock lock(m_threadMutex);
+        {
+            Lock lock(m_threadMutex);
 
-        // Check if the thread was launched Paused
-        if (m_threadStartState == Paused)
-            alCheck(alSourcePause(m_source));
+            // Check if the stream was launched Paused
+            if (m_threadStartState == Paused)
+                alCheck(alSourcePause(m_source));
+        }
     }
 
-    for (;;)
     {
-        {
-            Lock lock(m_threadMutex);
-            if (!m_isStreaming)
-                break;
-        }
+        Lock lock(m_threadMutex);
+        if (!m_isStreaming)
+            return false;
+    }
 
-        // The stream has been interrupted!
-        if (SoundSource::getStatus() == Stopped)
+    // The stream has been interrupted!
+    if (SoundSource::getStatus() == Stopped)
+    {
+        if (!m_requestStop)
         {
-            if (!requestStop)
-            {
-                // Just continue
-                alCheck(alSourcePlay(m_source));
-            }
-            else
+            // All the buffers have been played before we could refill them
             {
-                // End streaming
                 Lock lock(m_threadMutex);
-                m_isStreaming = false;
+                ++m_underrunCount;
             }
+
+            // Just continue
+            alCheck(alSourcePlay(m_source));
         }
+        else
+        {
+            // End streaming
+            Lock lock(m_threadMutex);
+            m_isStreaming = false;
+        }
+    }
 
-        // Get the number of buffers that have been processed (i.e. ready for reuse)
-        ALint nbProcessed = 0;
-        alCheck(alGetSourcei(m_source, AL_BUFFERS_PROCESSED, &nbProcessed));
+    // Get the number of buffers that have been processed (i.e. ready for reuse)
+    ALint nbProcessed = 0;
+    alCheck(alGetSourcei(m_source, AL_BUFFERS_PROCESSED, &nbProcessed));
 
-        while (nbProcessed--)
-        {
-            // Pop the first unused buffer from the queue
-            ALuint buffer;
-            alCheck(alSourceUnqueueBuffers(m_source, 1, &buffer));
-
-            // Find its number
-            unsigned int bufferNum = 0;
-            for (unsigned int i = 0; i < BufferCount; ++i)
-                if (m_buffers[i] == buffer)
-                {
-                    bufferNum = i;
-                    break;
-                }
-
-            // Retrieve its size and add it to the samples count
-            if (m_bufferSeeks[bufferNum] != NoLoop)
+    while (nbProcessed--)
+    {
+        // Pop the first unused buffer from the queue
+        ALuint buffer;
+        alCheck(alSourceUnqueueBuffers(m_source, 1, &buffer));
+
+        // Find its number
+        unsigned int bufferNum = 0;
+        for (unsigned int i = 0; i < m_activeBufferCount; ++i)
+            if (m_buffers[i] == buffer)
             {
-                // This was the last buffer before EOF or Loop End: reset the sample count
-                m_samplesProcessed = static_cast<Uint64>(m_bufferSeeks[bufferNum]);
-                m_bufferSeeks[bufferNum] = NoLoop;
+                bufferNum = i;
+                break;
             }
-            else
+
+        // Retrieve its size and add it to the samples count
+        if (m_bufferSeeks[bufferNum] != NoLoop)
+        {
+            // This was the last buffer before EOF or Loop End: reset the sample count
+            m_samplesProcessed = static_cast<Uint64>(m_bufferSeeks[bufferNum]);
+            m_bufferSeeks[bufferNum] = NoLoop;
+        }
+        else
+        {
+            ALint size, bits;
+            alCheck(alGetBufferi(buffer, AL_SIZE, &size));
+            alCheck(alGetBufferi(buffer, AL_BITS, &bits));
+
+            // Bits can be 0 if the format or parameters are corrupt, avoid division by zero
+            if (bits == 0)
             {
-                ALint size, bits;
-                alCheck(alGetBufferi(buffer, AL_SIZE, &size));
-                alCheck(alGetBufferi(buffer, AL_BITS, &bits));
-
-                // Bits can be 0 if the format or parameters are corrupt, avoid division by zero
-                if (bits == 0)
-                {
-                    err() << "Bits in sound stream are 0: make sure that the audio format is not corrupt "
-                          << "and initialize() has been called correctly" << std::endl;
-
-                    // Abort streaming (exit main loop)
-                    Lock lock(m_threadMutex);
-                    m_isStreaming = false;
-                    requestStop = true;
-                    break;
-                }
-                else
-                {
-                    m_samplesProcessed += static_cast<Uint64>(size / (bits / 8));
-                }
-            }
+                err() << "Bits in sound stream are 0: make sure that the audio format is not corrupt "
+                      << "and initialize() has been called correctly" << std::endl;
 
-            // Fill it and push it back into the playing queue
-            if (!requestStop)
+                // Abort streaming (exit main loop)
+                Lock lock(m_threadMutex);
+                m_isStreaming = false;
+                m_requestStop = true;
+                break;
+            }
+            else
             {
-                if (fillAndPushBuffer(bufferNum))
-                    requestStop = true;
+                m_samplesProcessed += static_cast<Uint64>(size / (bits / 8));
             }
         }
 
-        // Check if any error has occurred
-        if (alGetLastError() != AL_NO_ERROR)
+        // Fill it and push it back into the playing queue
+        if (!m_requestStop)
         {
-            // Abort streaming (exit main loop)
-            Lock lock(m_threadMutex);
-            m_isStreaming = false;
-            break;
+            if (fillAndPushBuffer(bufferNum))
+                m_requestStop = true;
         }
+    }
 
-        // Leave some time for the other threads if the stream is still playing
-        if (SoundSource::getStatus() != Stopped)
-            sleep(m_processingInterval);
+    // Check if any error has occurred
+    if (alGetLastError() != AL_NO_ERROR)
+    {
+        // Abort streaming (exit main loop)
+        Lock lock(m_threadMutex);
+        m_isStreaming = false;
+        return false;
     }
 
+    Lock lock(m_threadMutex);
+    return m_isStreaming;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStream::endStreaming()
+{
+    if (!m_hasStarted)
+        return;
+
     // Stop the playback
     alCheck(alSourceStop(m_source));
 
@@ -429,7 +538,10 @@ void SoundStream::streamData()
 
     // Delete the buffers
     alCheck(alSourcei(m_source, AL_BUFFER, 0));
-    alCheck(alDeleteBuffers(BufferCount, m_buffers));
+    alCheck(alDeleteBuffers(static_cast<ALsizei>(m_activeBufferCount), m_buffers));
+
+    m_requestStop = false;
+    m_hasStarted = false;
 }
 
 
@@ -439,14 +551,14 @@ bool SoundStream::fillAndPushBuffer(unsigned int bufferNum, bool immediateLoop)
     bool requestStop = false;
 
     // Acquire audio data, also address EOF and error cases if they occur
-    Chunk data = {NULL, 0};
+    Chunk data = {NULL, 0, NULL};
     for (Uint32 retryCount = 0; !onGetData(data) && (retryCount < BufferRetries); ++retryCount)
     {
         // Check if the stream must loop or stop
         if (!m_loop)
         {
             // Not looping: Mark this buffer as ending with 0 and request stop
-            if (data.samples != NULL && data.sampleCount != 0)
+            if (hasSamples(data, m_sampleFormat))
                 m_bufferSeeks[bufferNum] = 0;
             requestStop = true;
             break;
@@ -457,7 +569,7 @@ bool SoundStream::fillAndPushBuffer(unsigned int bufferNum, bool immediateLoop)
         m_bufferSeeks[bufferNum] = onLoop();
 
         // If we got data, break and process it, else try to fill the buffer once again
-        if (data.samples != NULL && data.sampleCount != 0)
+        if (hasSamples(data, m_sampleFormat))
             break;
 
         // If immediateLoop is specified, we have to immediately adjust the sample count
@@ -472,13 +584,30 @@ bool SoundStream::fillAndPushBuffer(unsigned int bufferNum, bool immediateLoop)
     }
 
     // Fill the buffer if some data was returned
-    if (data.samples && data.sampleCount)
+    if (hasSamples(data, m_sampleFormat))
     {
         unsigned int buffer = m_buffers[bufferNum];
 
-        // Fill the buffer
+        // Select the samples matching the format of the buffers
+        const void* samples = data.samples;
         ALsizei size = static_cast<ALsizei>(data.sampleCount * sizeof(Int16));
-        alCheck(alBufferData(buffer, m_format, data.samples, size, static_cast<ALsizei>(m_sampleRate)));
+        if (m_sampleFormat == Float32Samples)
+        {
+            if (m_convertSamples)
+            {
+                m_convertedSamples.resize(data.sampleCount);
+                priv::convertSamples(data.floatSamples, &m_convertedSamples[0], data.sampleCount);
+                samples = &m_convertedSamples[0];
+            }
+            else
+            {
+                samples = data.floatSamples;
+                size = static_cast<ALsizei>(data.sampleCount * sizeof(float));
+            }
+        }
+
+        // Fill the buffer
+        alCheck(alBufferData(buffer, m_format, samples, size, static_cast<ALsizei>(m_sampleRate)));
 
         // Push it into the sound queue
         alCheck(alSourceQueueBuffers(m_source, 1, &buffer));
@@ -498,7 +627,7 @@ bool SoundStream::fillQueue()
 {
     // Fill and enqueue all the available buffers
     bool requestStop = false;
-    for (unsigned int i = 0; (i < BufferCount) && !requestStop; ++i)
+    for (unsigned int i = 0; (i < m_activeBufferCount) && !requestStop; ++i)
     {
         // Since no sound has been loaded yet, we can't schedule loop seeks preemptively,
         // So if we start on EOF or Loop End, we let fillAndPushBuffer() adjust the sample count
@@ -0,0 +1,242 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2023 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/SoundStreamScheduler.hpp>
+#include <SFML/Audio/AudioDevice.hpp>
+#include <SFML/Audio/SoundStream.hpp>
+#include <SFML/System/Thread.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Sleep.hpp>
+#include <vector>
+
+
+namespace
+{
+    // Number of sound stream instances alive, and its mutex
+    unsigned int count = 0;
+    sf::Mutex countMutex;
+
+    // The streaming thread, shared by all the sound streams
+    sf::Thread* thread = NULL;
+
+    // Streams currently serviced, and the mutex protecting them
+    // (it is only held to pick the next stream, each stream is serviced under its own mutex)
+    std::vector<sf::SoundStream*> streams;
+    bool running = false;
+    sf::Mutex streamsMutex;
+
+    // Mutex making sure that a single servicing pass runs at a time
+    sf::Mutex updateMutex;
+
+    // Slot value of streams which are not serviced
+    const std::size_t noSlot = static_cast<std::size_t>(-1);
+
+    // Default period of the servicing passes
+    const sf::Time defaultInterval = sf::milliseconds(10);
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void SoundStreamScheduler::acquire()
+{
+    // Protect from concurrent access
+    Lock lock(countMutex);
+
+    // If this is the very first stream, start the streaming thread
+    if (count == 0)
+    {
+        {
+            Lock streamsLock(streamsMutex);
+            running = true;
+        }
+
+        thread = new Thread(&SoundStreamScheduler::run);
+        thread->launch();
+    }
+
+    // Increment the streams counter
+    count++;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStreamScheduler::release()
+{
+    // Protect from concurrent access
+    Lock lock(countMutex);
+
+    // Decrement the streams counter
+    count--;
+
+    // If there's no more stream alive, we can stop the streaming thread
+    if (count == 0)
+    {
+        {
+            Lock streamsLock(streamsMutex);
+            running = false;
+        }
+
+        thread->wait();
+        delete thread;
+        thread = NULL;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStreamScheduler::add(SoundStream& stream)
+{
+    Lock lock(streamsMutex);
+
+    if (stream.m_schedulerSlot != noSlot)
+        return;
+
+    stream.m_schedulerSlot = streams.size();
+    streams.push_back(&stream);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStreamScheduler::remove(SoundStream& stream)
+{
+    bool registered = false;
+
+    {
+        Lock lock(streamsMutex);
+
+        std::size_t slot = stream.m_schedulerSlot;
+        if (slot != noSlot)
+        {
+            // Move the last stream into the freed slot
+            streams[slot] = streams.back();
+            streams[slot]->m_schedulerSlot = slot;
+            streams.pop_back();
+            stream.m_schedulerSlot = noSlot;
+            registered = true;
+        }
+    }
+
+    // Wait until the streaming thread is done with this stream, if it is servicing it:
+    // it can no longer pick it, so the stream won't be accessed anymore afterwards
+    Lock lock(stream.m_streamingMutex);
+
+    // Release the resources of the stream, unless the streaming thread did it when the stream ended
+    if (registered)
+        stream.endStreaming();
+}
+
+
+////////////////////////////////////////////////////////////
+Time SoundStreamScheduler::update()
+{
+    Time interval = defaultInterval;
+
+    Lock updateLock(updateMutex);
+
+    for (std::size_t slot = 0; ; ++slot)
+    {
+        // Pick the next stream, and lock it while it is known to be alive
+        SoundStream* stream = NULL;
+        {
+            Lock lock(streamsMutex);
+
+            if (slot >= streams.size())
+                break;
+
+            stream = streams[slot];
+            stream->m_streamingMutex.lock();
+        }
+
+        // Service the stream without blocking the other ones, nor the calls to add and remove
+        // (streams added or removed meanwhile are simply serviced in the next pass)
+        if (stream->m_processingInterval < interval)
+            interval = stream->m_processingInterval;
+
+        if (!stream->updateStream())
+        {
+            // The stream is over: unregister it and release its resources, unless it was removed meanwhile
+            bool registered = false;
+            {
+                Lock lock(streamsMutex);
+
+                std::size_t index = stream->m_schedulerSlot;
+                if (index != noSlot)
+                {
+                    streams[index] = streams.back();
+                    streams[index]->m_schedulerSlot = index;
+                    streams.pop_back();
+                    stream->m_schedulerSlot = noSlot;
+                    registered = true;
+
+                    // The last stream was moved into this slot
+                    if (index == slot)
+                        --slot;
+                }
+            }
+
+            if (registered)
+                stream->endStreaming();
+        }
+
+        stream->m_streamingMutex.unlock();
+    }
+
+    return interval;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStreamScheduler::run()
+{
+    for (;;)
+    {
+        {
+            Lock lock(streamsMutex);
+
+            if (!running)
+                break;
+        }
+
+        // A loopback output feeds the streams itself, while it renders
+        Time interval = defaultInterval;
+        if (AudioDevice::getOutputMode() != AudioOutput::Loopback)
+            interval = update();
+
+        // Leave some time for the other threads
+        sleep(interval);
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,133 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2023 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SOUNDSTREAMSCHEDULER_HPP
+#define SFML_SOUNDSTREAMSCHEDULER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Time.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+class SoundStream;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Shared streaming service which feeds all the
+///        active sound streams from a single thread
+///
+////////////////////////////////////////////////////////////
+class SoundStreamScheduler
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Register a new sound stream instance
+    ///
+    /// Every sound stream acquires the scheduler in its
+    /// constructor; the streaming thread is started when
+    /// the first instance is created.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void acquire();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Unregister a sound stream instance
+    ///
+    /// The streaming thread is stopped and joined when the
+    /// last sound stream instance is destroyed.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void release();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start servicing a sound stream
+    ///
+    /// This function is O(1). It has no effect if the stream
+    /// is already serviced.
+    ///
+    /// \param stream Stream to service
+    ///
+    ////////////////////////////////////////////////////////////
+    static void add(SoundStream& stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop servicing a sound stream
+    ///
+    /// This function is O(1). If the stream is being serviced,
+    /// it waits until the streaming thread is done with it, so
+    /// that the stream is guaranteed not to be accessed by the
+    /// streaming thread anymore once it returns; the other
+    /// streams don't delay it. The OpenAL buffers of the stream
+    /// are released.
+    ///
+    /// \param stream Stream to stop servicing
+    ///
+    ////////////////////////////////////////////////////////////
+    static void remove(SoundStream& stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Service all the registered streams once
+    ///
+    /// This is what the streaming thread does periodically.
+    /// Each stream is serviced under its own mutex, so a
+    /// stream which is slow to provide its data only delays
+    /// the servicing of the others, not the functions which
+    /// control them.
+    /// With a loopback output, the streaming thread is idle
+    /// and this function is called by the renderer instead,
+    /// so that the streams are fed at the pace of the rendered
+    /// samples rather than of the wall clock.
+    ///
+    /// \return Time until the next servicing pass is due
+    ///
+    ////////////////////////////////////////////////////////////
+    static Time update();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called as the entry point of the thread
+    ///
+    /// This function services all the registered streams
+    /// periodically, unless the output is rendered by a
+    /// loopback device, and returns only when the last sound
+    /// stream instance is released.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void run();
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_SOUNDSTREAMSCHEDULER_HPP
@@ -0,0 +1,494 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2023 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/VoiceManager.hpp>
+#include <SFML/Audio/SoundBuffer.hpp>
+#include <SFML/Audio/Listener.hpp>
+#include <SFML/Audio/ALCheck.hpp>
+#include <SFML/Audio/AudioDevice.hpp>
+#include <algorithm>
+#include <cmath>
+
+#if defined(__APPLE__)
+    #if defined(__clang__)
+        #pragma clang diagnostic ignored "-Wdeprecated-declarations"
+    #elif defined(__GNUC__)
+        #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+    #endif
+#endif
+
+
+namespace
+{
+    // Rank of an audible voice
+    struct Rank
+    {
+        int        priority;
+        float      audibility;
+        sf::Uint64 id;
+    };
+
+    // Orders ranks from the most to the least important
+    bool isMoreImportant(const Rank& left, const Rank& right)
+    {
+        if (left.priority != right.priority)
+            return left.priority > right.priority;
+
+        return left.audibility > right.audibility;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+VoiceManager::VoiceManager(unsigned int sourceCount) :
+m_sources    (sourceCount, 0),
+m_nextId     (1),
+m_minDistance(1.f),
+m_attenuation(1.f),
+m_threshold  (0.001f)
+{
+    if (sourceCount > 0)
+        alCheck(alGenSources(static_cast<ALsizei>(sourceCount), &m_sources[0]));
+
+    for (std::vector<unsigned int>::const_iterator it = m_sources.begin(); it != m_sources.end(); ++it)
+    {
+        // Sources which could not be created are left out of the pool
+        if (*it != 0)
+            m_freeSources.push_back(*it);
+    }
+
+    m_sources = m_freeSources;
+}
+
+
+////////////////////////////////////////////////////////////
+VoiceManager::~VoiceManager()
+{
+    stopAll();
+
+    if (!m_sources.empty())
+        alCheck(alDeleteSources(static_cast<ALsizei>(m_sources.size()), &m_sources[0]));
+}
+
+
+////////////////////////////////////////////////////////////
+VoiceManager::VoiceId VoiceManager::play(const SoundBuffer& buffer, int priority, float volume)
+{
+    Voice voice;
+    voice.buffer   = &buffer;
+    voice.priority = priority;
+    voice.volume   = volume;
+    voice.pitch    = 1.f;
+    voice.position = Vector3f(0.f, 0.f, 0.f);
+    voice.relative = false;
+    voice.loop     = false;
+    voice.source   = 0;
+    voice.offset   = Time::Zero;
+
+    VoiceId id = m_nextId++;
+    Voice& inserted = m_voices.insert(std::make_pair(id, voice)).first->second;
+
+    // Be notified when the buffer is about to change, to stop its voices
+    if (m_bufferUses[&buffer]++ == 0)
+        buffer.attachVoiceManager(this);
+
+    if (getAudibility(inserted) < m_threshold)
+        return id;
+
+    if (m_freeSources.empty())
+    {
+        // Steal the source of the least important voice, if the new one is more important
+        Voice* victim = NULL;
+        for (VoiceMap::iterator it = m_voices.begin(); it != m_voices.end(); ++it)
+        {
+            if ((it->second.source != 0) && (!victim || isLessImportant(it->second, *victim)))
+                victim = &it->second;
+        }
+
+        if (victim && isLessImportant(*victim, inserted))
+            virtualize(*victim);
+    }
+
+    if (!m_freeSources.empty())
+        realize(inserted);
+
+    return id;
+}
+
+
+////////////////////////////////////////////////////////////
+void VoiceManager::stop(VoiceId voice)
+{
+    VoiceMap::iterator it = m_voices.find(voice);
+    if (it != m_voices.end())
+        remove(it);
+}
+
+
+////////////////////////////////////////////////////////////
+void VoiceManager::stopAll()
+{
+    while (!m_voices.empty())
+        remove(m_voices.begin());
+}
+
+
+////////////////////////////////////////////////////////////
+bool VoiceManager::isPlaying(VoiceId voice) const
+{
+    return m_voices.find(voice) != m_voices.end();
+}
+
+
+////////////////////////////////////////////////////////////
+bool VoiceManager::isVirtual(VoiceId voice) const
+{
+    VoiceMap::const_iterator it = m_voices.find(voice);
+    return (it != m_voices.end()) && (it->second.source == 0);
+}
+
+
+////////////////////////////////////////////////////////////
+void VoiceManager::setVolume(VoiceId voice, float volume)
+{
+    VoiceMap::iterator it = m_voices.find(voice);
+    if (it != m_voices.end())
+    {
+        it->second.volume = volume;
+        if (it->second.source)
+            alCheck(alSourcef(it->second.source, AL_GAIN, volume * 0.01f));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void VoiceManager::setPitch(VoiceId voice, float pitch)
+{
+    VoiceMap::iterator it = m_voices.find(voice);
+    if (it != m_voices.end())
+    {
+        it->second.pitch = pitch;
+        if (it->second.source)
+            alCheck(alSourcef(it->second.source, AL_PITCH, pitch));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void VoiceManager::setPosition(VoiceId voice, const Vector3f& position)
+{
+    VoiceMap::iterator it = m_voices.find(voice);
+    if (it != m_voices.end())
+    {
+        it->second.position = position;
+        if (it->second.source)
+            alCheck(alSource3f(it->second.source, AL_POSITION, position.x, position.y, position.z));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void VoiceManager::setRelativeToListener(VoiceId voice, bool relative)
+{
+    VoiceMap::iterator it = m_voices.find(voice);
+    if (it != m_voices.end())
+    {
+        it->second.relative = relative;
+        if (it->second.source)
+            alCheck(alSourcei(it->second.source, AL_SOURCE_RELATIVE, relative));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void VoiceManager::setLoop(VoiceId voice, bool loop)
+{
+    VoiceMap::iterator it = m_voices.find(voice);
+    if (it != m_voices.end())
+    {
+        it->second.loop = loop;
+        if (it->second.source)
+            alCheck(alSourcei(it->second.source, AL_LOOPING, loop));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void VoiceManager::setMinDistance(float distance)
+{
+    m_minDistance = distance;
+
+    for (VoiceMap::const_iterator it = m_voices.begin(); it != m_voices.end(); ++it)
+    {
+        if (it->second.source)
+            alCheck(alSourcef(it->second.source, AL_REFERENCE_DISTANCE, distance));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void VoiceManager::setAttenuation(float attenuation)
+{
+    m_attenuation = attenuation;
+
+    for (VoiceMap::const_iterator it = m_voices.begin(); it != m_voices.end(); ++it)
+    {
+        if (it->second.source)
+            alCheck(alSourcef(it->second.source, AL_ROLLOFF_FACTOR, attenuation));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void VoiceManager::setAudibilityThreshold(float threshold)
+{
+    m_threshold = threshold;
+}
+
+
+////////////////////////////////////////////////////////////
+void VoiceManager::update(Time elapsed)
+{
+    // Swap the sources between voices in a single batch of updates
+    priv::AudioDevice::beginDeferredUpdates();
+
+    // Release the finished voices and advance the virtual ones
+    for (VoiceMap::iterator it = m_voices.begin(); it != m_voices.end();)
+    {
+        Voice& voice = it->second;
+        bool finished = false;
+
+        if (voice.source)
+        {
+            ALint state;
+            alCheck(alGetSourcei(voice.source, AL_SOURCE_STATE, &state));
+            finished = (state == AL_STOPPED);
+        }
+        else
+        {
+            Time duration = voice.buffer->getDuration();
+            voice.offset += elapsed * voice.pitch;
+
+            if (voice.offset >= duration)
+            {
+                if (voice.loop && (duration > Time::Zero))
+                    voice.offset = voice.offset % duration;
+                else
+                    finished = true;
+            }
+        }
+
+        if (finished)
+        {
+            remove(it++);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    // Rank the audible voices by importance
+    std::vector<Rank> ranking;
+    ranking.reserve(m_voices.size());
+    for (VoiceMap::const_iterator it = m_voices.begin(); it != m_voices.end(); ++it)
+    {
+        Rank rank;
+        rank.priority   = it->second.priority;
+        rank.audibility = getAudibility(it->second);
+        rank.id         = it->first;
+
+        if (rank.audibility >= m_threshold)
+            ranking.push_back(rank);
+    }
+    std::stable_sort(ranking.begin(), ranking.end(), isMoreImportant);
+
+    std::size_t realCount = std::min(ranking.size(), m_sources.size());
+    std::vector<VoiceId> realIds(realCount);
+    for (std::size_t i = 0; i < realCount; ++i)
+        realIds[i] = ranking[i].id;
+    std::sort(realIds.begin(), realIds.end());
+
+    // Virtualize the voices which lost their rank first, so that their sources are free...
+    for (VoiceMap::iterator it = m_voices.begin(); it != m_voices.end(); ++it)
+    {
+        if ((it->second.source != 0) && !std::binary_search(realIds.begin(), realIds.end(), it->first))
+            virtualize(it->second);
+    }
+
+    // ... then give them to the most important virtual voices
+    for (std::size_t i = 0; i < realCount; ++i)
+    {
+        Voice& voice = m_voices[ranking[i].id];
+        if (voice.source == 0)
+            realize(voice);
+    }
+
+    priv::AudioDevice::endDeferredUpdates();
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int VoiceManager::getSourceCount() const
+{
+    return static_cast<unsigned int>(m_sources.size());
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int VoiceManager::getVoiceCount() const
+{
+    return static_cast<unsigned int>(m_voices.size());
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int VoiceManager::getVirtualVoiceCount() const
+{
+    unsigned int count = 0;
+    for (VoiceMap::const_iterator it = m_voices.begin(); it != m_voices.end(); ++it)
+    {
+        if (it->second.source == 0)
+            ++count;
+    }
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+float VoiceManager::getAudibility(const Voice& voice) const
+{
+    // Same model as OpenAL's default AL_INVERSE_DISTANCE_CLAMPED
+    Vector3f delta = voice.position;
+    if (!voice.relative)
+        delta -= Listener::getPosition();
+
+    float distance = std::sqrt(delta.x * delta.x + delta.y * delta.y + delta.z * delta.z);
+    distance = std::max(distance, m_minDistance);
+
+    float gain = 1.f;
+    if (m_minDistance > 0.f)
+        gain = m_minDistance / (m_minDistance + m_attenuation * (distance - m_minDistance));
+
+    return voice.volume * 0.01f * gain;
+}
+
+
+////////////////////////////////////////////////////////////
+bool VoiceManager::isLessImportant(const Voice& left, const Voice& right) const
+{
+    if (left.priority != right.priority)
+        return left.priority < right.priority;
+
+    return getAudibility(left) < getAudibility(right);
+}
+
+
+////////////////////////////////////////////////////////////
+void VoiceManager::realize(Voice& voice)
+{
+    voice.source = m_freeSources.back();
+    m_freeSources.pop_back();
+
+    alCheck(alSourcei(voice.source, AL_BUFFER, static_cast<ALint>(voice.buffer->m_buffer)));
+    applyParameters(voice);
+    alCheck(alSourcef(voice.source, AL_SEC_OFFSET, voice.offset.asSeconds()));
+    alCheck(alSourcePlay(voice.source));
+}
+
+
+////////////////////////////////////////////////////////////
+void VoiceManager::virtualize(Voice& voice)
+{
+    ALfloat seconds = 0.f;
+    alCheck(alGetSourcef(voice.source, AL_SEC_OFFSET, &seconds));
+    voice.offset = sf::seconds(seconds);
+
+    release(voice);
+}
+
+
+////////////////////////////////////////////////////////////
+void VoiceManager::release(Voice& voice)
+{
+    if (voice.source)
+    {
+        alCheck(alSourceStop(voice.source));
+        alCheck(alSourcei(voice.source, AL_BUFFER, 0));
+
+        m_freeSources.push_back(voice.source);
+        voice.source = 0;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void VoiceManager::remove(VoiceMap::iterator voice)
+{
+    release(voice->second);
+
+    BufferUseMap::iterator uses = m_bufferUses.find(voice->second.buffer);
+    if (--uses->second == 0)
+    {
+        voice->second.buffer->detachVoiceManager(this);
+        m_bufferUses.erase(uses);
+    }
+
+    m_voices.erase(voice);
+}
+
+
+////////////////////////////////////////////////////////////
+void VoiceManager::stopVoices(const SoundBuffer& buffer)
+{
+    for (VoiceMap::iterator it = m_voices.begin(); it != m_voices.end();)
+    {
+        if (it->second.buffer == &buffer)
+            remove(it++);
+        else
+            ++it;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void VoiceManager::applyParameters(const Voice& voice)
+{
+    alCheck(alSourcef(voice.source, AL_GAIN, voice.volume * 0.01f));
+    alCheck(alSourcef(voice.source, AL_PITCH, voice.pitch));
+    alCheck(alSource3f(voice.source, AL_POSITION, voice.position.x, voice.position.y, voice.position.z));
+    alCheck(alSourcei(voice.source, AL_SOURCE_RELATIVE, voice.relative));
+    alCheck(alSourcei(voice.source, AL_LOOPING, voice.loop));
+    alCheck(alSourcef(voice.source, AL_REFERENCE_DISTANCE, m_minDistance));
+    alCheck(alSourcef(voice.source, AL_ROLLOFF_FACTOR, m_attenuation));
+}
+
+} // namespace sf
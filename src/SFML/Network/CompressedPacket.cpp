@@ -0,0 +1,442 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2023 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/CompressedPacket.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <cstring>
+#include <vector>
+
+
+namespace
+{
+    // Methods of compression, stored in the first byte of the data
+    enum Method
+    {
+        Stored = 0, // Data follows uncompressed
+        Lz4    = 1  // Original size (32 bits, big-endian) follows, then an LZ4 block
+    };
+
+    // Size of the header of compressed data
+    const std::size_t headerSize = 1 + 4;
+
+    // Parameters of the LZ4 block format
+    const std::size_t minMatch     = 4;     // Shortest match
+    const std::size_t lastLiterals = 5;     // The last bytes are always literals
+    const std::size_t matchLimit   = 12;    // The last match must start this far from the end
+    const std::size_t maxOffset    = 65535; // Farthest match
+    const unsigned int hashLog     = 12;    // Size of the hash table, as a power of 2
+
+    // Hash table of the compressor, mapping hashes of 4-byte sequences to their last position
+    struct Context
+    {
+        sf::Uint32 table[1 << hashLog];
+    };
+
+    // Contexts which are not in use: there are as many as threads compressing at the same time
+    class ContextPool
+    {
+    public:
+
+        ~ContextPool()
+        {
+            for (std::vector<Context*>::iterator it = m_contexts.begin(); it != m_contexts.end(); ++it)
+                delete *it;
+        }
+
+        Context* acquire()
+        {
+            {
+                sf::Lock lock(m_mutex);
+                if (!m_contexts.empty())
+                {
+                    Context* context = m_contexts.back();
+                    m_contexts.pop_back();
+                    return context;
+                }
+            }
+
+            // The table of a new context is cleared; a reused one isn't: positions
+            // are validated against the data, so stale entries can only miss a match
+            return new Context();
+        }
+
+        void release(Context* context)
+        {
+            sf::Lock lock(m_mutex);
+            m_contexts.push_back(context);
+        }
+
+    private:
+
+        sf::Mutex             m_mutex;
+        std::vector<Context*> m_contexts;
+    };
+
+    ContextPool contextPool;
+
+    sf::Uint32 read32(const unsigned char* data)
+    {
+        sf::Uint32 value;
+        std::memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    sf::Uint32 hash(sf::Uint32 sequence)
+    {
+        return (sequence * 2654435761u) >> (32 - hashLog);
+    }
+
+    // Write a length which doesn't fit in its 4 bits of token, 255 at a time
+    unsigned char* writeLength(unsigned char* output, std::size_t length)
+    {
+        for (; length >= 255; length -= 255)
+            *output++ = 255;
+        *output++ = static_cast<unsigned char>(length);
+
+        return output;
+    }
+
+    // Read a length which didn't fit in its 4 bits of token
+    bool readLength(const unsigned char*& input, const unsigned char* end, std::size_t& length)
+    {
+        unsigned char byte;
+        do
+        {
+            if (input == end)
+                return false;
+
+            byte = *input++;
+            length += byte;
+        }
+        while (byte == 255);
+
+        return true;
+    }
+
+    // Write a sequence: literals, then a match unless it is the last sequence
+    unsigned char* writeSequence(unsigned char* output, const unsigned char* outputEnd, const unsigned char* literals, std::size_t literalLength, std::size_t offset, std::size_t matchLength)
+    {
+        // Worst case: token, literal length, literals, offset, match length
+        if (static_cast<std::size_t>(outputEnd - output) < 1 + literalLength / 255 + 1 + literalLength + 2 + matchLength / 255 + 1)
+            return NULL;
+
+        unsigned char* token = output++;
+        *token = static_cast<unsigned char>((literalLength < 15 ? literalLength : 15) << 4);
+        if (literalLength >= 15)
+            output = writeLength(output, literalLength - 15);
+
+        std::memcpy(output, literals, literalLength);
+        output += literalLength;
+
+        if (offset > 0)
+        {
+            *output++ = static_cast<unsigned char>(offset);
+            *output++ = static_cast<unsigned char>(offset >> 8);
+
+            std::size_t length = matchLength - minMatch;
+            *token = static_cast<unsigned char>(*token | (length < 15 ? length : 15));
+            if (length >= 15)
+                output = writeLength(output, length - 15);
+        }
+
+        return output;
+    }
+
+    // Compress data into an LZ4 block; return the size of the block,
+    // or 0 if it doesn't fit in the output
+    std::size_t compress(const unsigned char* input, std::size_t size, unsigned char* output, std::size_t capacity, Context& context)
+    {
+        const unsigned char* const end = input + size;
+        const unsigned char* anchor = input;
+        unsigned char* const outputEnd = output + capacity;
+        unsigned char* current = output;
+
+        if (size > matchLimit)
+        {
+            const unsigned char* const searchEnd = end - matchLimit;
+            const unsigned char* const extendEnd = end - lastLiterals;
+
+            const unsigned char* position = input;
+            while (position < searchEnd)
+            {
+                sf::Uint32 sequence = read32(position);
+                sf::Uint32& entry = context.table[hash(sequence)];
+                std::size_t candidate = entry;
+                std::size_t offset = static_cast<std::size_t>(position - input);
+                entry = static_cast<sf::Uint32>(offset);
+
+                if ((candidate >= offset) || (offset - candidate > maxOffset) || (read32(input + candidate) != sequence))
+                {
+                    // Skip faster and faster through incompressible data
+                    position += 1 + (static_cast<std::size_t>(position - anchor) >> 6);
+                    continue;
+                }
+
+                // Extend the match forward
+                const unsigned char* match = input + candidate;
+                const unsigned char* matchEnd = position + minMatch;
+                while ((matchEnd < extendEnd) && (*matchEnd == match[matchEnd - position]))
+                    ++matchEnd;
+
+                current = writeSequence(current, outputEnd, anchor, static_cast<std::size_t>(position - anchor), offset - candidate, static_cast<std::size_t>(matchEnd - position));
+                if (!current)
+                    return 0;
+
+                position = matchEnd;
+                anchor = position;
+            }
+        }
+
+        // The remaining bytes are literals
+        current = writeSequence(current, outputEnd, anchor, static_cast<std::size_t>(end - anchor), 0, 0);
+        if (!current)
+            return 0;
+
+        return static_cast<std::size_t>(current - output);
+    }
+
+    // Decompress an LZ4 block which must fill the output exactly
+    bool decompress(const unsigned char* input, std::size_t size, unsigned char* output, std::size_t outputSize)
+    {
+        const unsigned char* const end = input + size;
+        unsigned char* const outputEnd = output + outputSize;
+        unsigned char* current = output;
+
+        while (input < end)
+        {
+            unsigned char token = *input++;
+
+            // Literals
+            std::size_t literalLength = token >> 4;
+            if ((literalLength == 15) && !readLength(input, end, literalLength))
+                return false;
+            if ((literalLength > static_cast<std::size_t>(end - input)) || (literalLength > static_cast<std::size_t>(outputEnd - current)))
+                return false;
+
+            std::memcpy(current, input, literalLength);
+            current += literalLength;
+            input += literalLength;
+
+            // The last sequence has no match
+            if (input == end)
+                break;
+
+            // Match
+            if (end - input < 2)
+                return false;
+            std::size_t offset = static_cast<std::size_t>(input[0]) | (static_cast<std::size_t>(input[1]) << 8);
+            input += 2;
+
+            std::size_t matchLength = token & 15;
+            if ((matchLength == 15) && !readLength(input, end, matchLength))
+                return false;
+            matchLength += minMatch;
+
+            if ((offset == 0) || (offset > static_cast<std::size_t>(current - output)) || (matchLength > static_cast<std::size_t>(outputEnd - current)))
+                return false;
+
+            // The match may overlap the bytes being written, which repeats them
+            const unsigned char* match = current - offset;
+            if (offset >= matchLength)
+            {
+                std::memcpy(current, match, matchLength);
+                current += matchLength;
+            }
+            else
+            {
+                for (std::size_t i = 0; i < matchLength; ++i)
+                    *current++ = *match++;
+            }
+        }
+
+        return current == outputEnd;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+CompressedPacket::CompressedPacket() :
+m_threshold(DefaultThreshold),
+m_sentSize (0)
+{
+    resetStatistics();
+}
+
+
+////////////////////////////////////////////////////////////
+CompressedPacket::CompressedPacket(PacketPool& pool) :
+Packet     (pool),
+m_threshold(DefaultThreshold),
+m_sentSize (0)
+{
+    resetStatistics();
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressedPacket::setThreshold(std::size_t threshold)
+{
+    m_threshold = threshold;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t CompressedPacket::getThreshold() const
+{
+    return m_threshold;
+}
+
+
+////////////////////////////////////////////////////////////
+const CompressedPacket::Statistics& CompressedPacket::getStatistics() const
+{
+    return m_statistics;
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressedPacket::resetStatistics()
+{
+    m_statistics.compressedCount   = 0;
+    m_statistics.storedCount       = 0;
+    m_statistics.originalSize      = 0;
+    m_statistics.compressedSize    = 0;
+    m_statistics.compressionTime   = Time::Zero;
+    m_statistics.decompressionTime = Time::Zero;
+}
+
+
+////////////////////////////////////////////////////////////
+const void* CompressedPacket::onSend(std::size_t& size)
+{
+    // A partial send is resumed with the data already transformed, which is counted once
+    if (m_sendPos > 0)
+    {
+        size = m_sentSize;
+        return m_buffer.empty() ? NULL : &m_buffer[0];
+    }
+
+    const unsigned char* data = static_cast<const unsigned char*>(getData());
+    std::size_t dataSize = getDataSize();
+
+    // The buffer only grows, so that a reused packet doesn't allocate memory
+    if (m_buffer.size() < headerSize + dataSize)
+        m_buffer.resize(headerSize + dataSize);
+    unsigned char* buffer = reinterpret_cast<unsigned char*>(&m_buffer[0]);
+
+    // Compress the data if it is large enough; the compressed
+    // data must be smaller than the data stored as it is
+    if ((dataSize >= m_threshold) && (dataSize > headerSize))
+    {
+        Clock clock;
+
+        Context* context = contextPool.acquire();
+        std::size_t compressedSize = compress(data, dataSize, buffer + headerSize, dataSize - headerSize, *context);
+        contextPool.release(context);
+
+        m_statistics.compressionTime += clock.getElapsedTime();
+
+        if (compressedSize > 0)
+        {
+            buffer[0] = Lz4;
+            buffer[1] = static_cast<unsigned char>(dataSize >> 24);
+            buffer[2] = static_cast<unsigned char>(dataSize >> 16);
+            buffer[3] = static_cast<unsigned char>(dataSize >> 8);
+            buffer[4] = static_cast<unsigned char>(dataSize);
+
+            ++m_statistics.compressedCount;
+            m_statistics.originalSize += dataSize;
+            m_statistics.compressedSize += headerSize + compressedSize;
+
+            size = headerSize + compressedSize;
+            m_sentSize = size;
+            return buffer;
+        }
+    }
+
+    // Send the data as it is
+    buffer[0] = Stored;
+    if (dataSize > 0)
+        std::memcpy(buffer + 1, data, dataSize);
+
+    ++m_statistics.storedCount;
+
+    size = 1 + dataSize;
+    m_sentSize = size;
+    return buffer;
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressedPacket::onReceive(const void* data, std::size_t size)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+
+    if ((size >= 1) && (bytes[0] == Stored))
+    {
+        append(bytes + 1, size - 1);
+        return;
+    }
+
+    if ((size > headerSize) && (bytes[0] == Lz4))
+    {
+        std::size_t originalSize = (static_cast<std::size_t>(bytes[1]) << 24) |
+                                   (static_cast<std::size_t>(bytes[2]) << 16) |
+                                   (static_cast<std::size_t>(bytes[3]) << 8) |
+                                   (static_cast<std::size_t>(bytes[4]));
+
+        // LZ4 can't compress more than 255 times: a larger size
+        // can only come from corrupted data, don't allocate memory for it
+        std::size_t compressedSize = size - headerSize;
+        if (originalSize / 255 <= compressedSize)
+        {
+            Clock clock;
+
+            // Decompress directly into the storage of the packet
+            reserve(m_size + originalSize);
+            bool decompressed = decompress(bytes + headerSize, compressedSize, reinterpret_cast<unsigned char*>(m_data + m_size), originalSize);
+
+            m_statistics.decompressionTime += clock.getElapsedTime();
+
+            if (decompressed)
+            {
+                m_size += originalSize;
+                return;
+            }
+        }
+    }
+
+    // Unknown method or corrupted data
+    m_isValid = false;
+}
+
+} // namespace sf
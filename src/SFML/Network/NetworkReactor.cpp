@@ -0,0 +1,674 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2023 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/NetworkReactor.hpp>
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <SFML/Network/SocketPoller.hpp>
+#include <SFML/Network/TcpListener.hpp>
+#include <SFML/Network/TcpSocket.hpp>
+#include <SFML/Network/UdpSocket.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Thread.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Maximum number of packets or connections handled for a socket before the other ones
+    const unsigned int maxOperationsPerEvent = 256;
+
+    // Remove a connection from a list of commands
+    template <typename T>
+    void erase(std::vector<T*>& list, T* item)
+    {
+        list.erase(std::remove(list.begin(), list.end(), item), list.end());
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+struct NetworkReactor::Connection
+{
+    enum Type
+    {
+        Listener,
+        Tcp,
+        Udp
+    };
+
+    Connection(Type connectionType, Socket* connectionSocket, TcpListener* acceptingListener) :
+    type    (connectionType),
+    socket  (connectionSocket),
+    listener(acceptingListener),
+    worker  (NULL),
+    queued  (false),
+    writing (false),
+    removed (false),
+    closed  (false)
+    {
+    }
+
+    Type                type;     //!< Type of the socket
+    Socket*             socket;   //!< Socket of the connection
+    TcpListener*        listener; //!< Listener which accepted the socket, if it is owned by the reactor
+    Worker*             worker;   //!< Thread which handles the socket
+    std::vector<Packet> pending;  //!< Packets queued by send (protected by the mutex of the worker)
+    std::vector<Packet> sending;  //!< Packets being sent by the worker
+    bool                queued;   //!< Is the connection in the flushes of its worker? (protected by the mutex of the worker)
+    bool                writing;  //!< Is the socket watched for writing?
+    bool                removed;  //!< Has the connection been removed? (protected by the mutex of the reactor)
+    bool                closed;   //!< Has the connection left the reactor?
+};
+
+
+////////////////////////////////////////////////////////////
+struct NetworkReactor::Worker
+{
+    explicit Worker(NetworkReactor& owner) :
+    reactor (owner),
+    stopping(false),
+    awake   (false)
+    {
+        // Commands are notified by sending a datagram to the worker itself
+        if (waker.bind(Socket::AnyPort, IpAddress::LocalHost) != Socket::Done)
+            err() << "Failed to create the wake-up socket of a network reactor thread" << std::endl;
+
+        waker.setBlocking(false);
+        poller.add(waker);
+    }
+
+    void run()
+    {
+        reactor.process(*this);
+    }
+
+    // Must be called with the mutex locked; returns true if the thread must be woken up
+    bool post()
+    {
+        bool wake = !awake;
+        awake = true;
+        return wake;
+    }
+
+    void wake()
+    {
+        char data = 0;
+        waker.send(&data, sizeof(data), IpAddress::LocalHost, waker.getLocalPort());
+    }
+
+    NetworkReactor&          reactor;    //!< Reactor which owns the thread
+    SocketPoller             poller;     //!< Poller of the sockets handled by the thread
+    UdpSocket                waker;      //!< Socket which wakes the thread up when commands are posted
+    Packet                   packet;     //!< Packet reused for all the receptions
+    Mutex                    mutex;      //!< Mutex protecting the commands
+    std::vector<Connection*> additions;  //!< Connections to add
+    std::vector<Connection*> flushes;    //!< Connections with packets to send
+    std::vector<Connection*> removals;   //!< Connections to remove
+    bool                     stopping;   //!< Must the thread stop?
+    bool                     awake;      //!< Has the thread been woken up since its last wait?
+    std::vector<Connection*> processing; //!< Commands being handled, owned by the thread
+    std::vector<Connection*> closed;     //!< Connections to destroy at the end of the iteration, owned by the thread
+};
+
+
+////////////////////////////////////////////////////////////
+NetworkReactor::NetworkReactor(unsigned int threadCount) :
+m_nextWorker(0)
+{
+    for (unsigned int i = 0; i < std::max(threadCount, 1u); ++i)
+        m_workers.push_back(new Worker(*this));
+}
+
+
+////////////////////////////////////////////////////////////
+NetworkReactor::~NetworkReactor()
+{
+    for (std::map<Socket*, Connection*>::iterator it = m_connections.begin(); it != m_connections.end(); ++it)
+    {
+        if (it->second->listener)
+            delete it->second->socket;
+
+        delete it->second;
+    }
+
+    for (std::vector<Worker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+        delete *it;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int NetworkReactor::getThreadCount() const
+{
+    return static_cast<unsigned int>(m_workers.size());
+}
+
+
+////////////////////////////////////////////////////////////
+bool NetworkReactor::add(TcpListener& listener)
+{
+    if (listener.getLocalPort() == 0)
+        return false;
+
+    listener.setBlocking(false);
+
+    Connection* connection = new Connection(Connection::Listener, &listener, NULL);
+    if (!addConnection(connection))
+    {
+        delete connection;
+        return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool NetworkReactor::add(TcpSocket& socket)
+{
+    if (socket.getRemotePort() == 0)
+        return false;
+
+    socket.setBlocking(false);
+
+    Connection* connection = new Connection(Connection::Tcp, &socket, NULL);
+    if (!addConnection(connection))
+    {
+        delete connection;
+        return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool NetworkReactor::add(UdpSocket& socket)
+{
+    if (socket.getLocalPort() == 0)
+        return false;
+
+    socket.setBlocking(false);
+
+    Connection* connection = new Connection(Connection::Udp, &socket, NULL);
+    if (!addConnection(connection))
+    {
+        delete connection;
+        return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::remove(Socket& socket)
+{
+    Worker* worker = NULL;
+    bool wake = false;
+    {
+        Lock lock(m_mutex);
+
+        std::map<Socket*, Connection*>::iterator it = m_connections.find(&socket);
+        if ((it == m_connections.end()) || it->second->removed)
+            return;
+
+        Connection* connection = it->second;
+        connection->removed = true;
+        worker = connection->worker;
+
+        Lock workerLock(worker->mutex);
+        worker->removals.push_back(connection);
+        wake = worker->post();
+    }
+
+    if (wake)
+        worker->wake();
+}
+
+
+////////////////////////////////////////////////////////////
+bool NetworkReactor::send(TcpSocket& socket, Packet& packet)
+{
+    // Let the packet transform its data before any lock is taken
+    std::size_t size = 0;
+    const void* data = packet.onSend(size);
+
+    Worker* worker = NULL;
+    bool wake = false;
+    {
+        Lock lock(m_mutex);
+
+        std::map<Socket*, Connection*>::iterator it = m_connections.find(&socket);
+        if ((it == m_connections.end()) || (it->second->type != Connection::Tcp))
+            return false;
+
+        Connection* connection = it->second;
+        worker = connection->worker;
+
+        // Copy the data to send into storage of the pool, so that queuing it doesn't allocate memory
+        Lock workerLock(worker->mutex);
+        connection->pending.push_back(Packet(m_pool));
+        connection->pending.back().append(data, size);
+        if (!connection->queued)
+        {
+            connection->queued = true;
+            worker->flushes.push_back(connection);
+            wake = worker->post();
+        }
+    }
+
+    if (wake)
+        worker->wake();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::run()
+{
+    // The calling thread runs the first worker, the other ones get their own thread
+    std::vector<Thread*> threads;
+    for (std::size_t i = 1; i < m_workers.size(); ++i)
+    {
+        threads.push_back(new Thread(&Worker::run, m_workers[i]));
+        threads.back()->launch();
+    }
+
+    process(*m_workers[0]);
+
+    for (std::vector<Thread*>::iterator it = threads.begin(); it != threads.end(); ++it)
+    {
+        (*it)->wait();
+        delete *it;
+    }
+
+    // Get ready for the next run
+    for (std::vector<Worker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+    {
+        Lock lock((*it)->mutex);
+        (*it)->stopping = false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::stop()
+{
+    for (std::vector<Worker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+    {
+        bool wake = false;
+        {
+            Lock lock((*it)->mutex);
+            (*it)->stopping = true;
+            wake = (*it)->post();
+        }
+
+        if (wake)
+            (*it)->wake();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::onAccept(TcpListener&, TcpSocket&)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::onReceive(TcpSocket&, Packet&)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::onReceiveFrom(UdpSocket&, Packet&, const IpAddress&, unsigned short)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::onSent(TcpSocket&)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::onDisconnect(TcpSocket&)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool NetworkReactor::addConnection(Connection* connection)
+{
+    Worker* worker = NULL;
+    bool wake = false;
+    {
+        Lock lock(m_mutex);
+
+        if (m_connections.find(connection->socket) != m_connections.end())
+            return false;
+
+        // Distribute the connections among the threads
+        worker = m_workers[m_nextWorker];
+        m_nextWorker = (m_nextWorker + 1) % static_cast<unsigned int>(m_workers.size());
+
+        connection->worker = worker;
+        m_connections[connection->socket] = connection;
+
+        // The addition is posted with the reactor locked, so that the commands
+        // posted for the connection by other threads can't be handled before it
+        Lock workerLock(worker->mutex);
+        worker->additions.push_back(connection);
+        wake = worker->post();
+    }
+
+    if (wake)
+        worker->wake();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::process(Worker& worker)
+{
+    while (processCommands(worker))
+    {
+        std::size_t count = worker.poller.wait();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const SocketPoller::ReadySocket& ready = worker.poller.getReadySocket(i);
+
+            // Skip the sockets removed by the previous handlers
+            if (!ready.socket)
+                continue;
+
+            // Consume the wake-up datagrams, the commands are handled before the next wait
+            if (ready.socket == &worker.waker)
+            {
+                char data[64];
+                std::size_t received = 0;
+                IpAddress sender;
+                unsigned short port = 0;
+                while (worker.waker.receive(data, sizeof(data), received, sender, port) == Socket::Done)
+                    ;
+
+                continue;
+            }
+
+            Connection& connection = *static_cast<Connection*>(ready.userData);
+
+            if (ready.events & SocketPoller::Read)
+            {
+                if (connection.type == Connection::Listener)
+                    accept(connection);
+                else
+                    receive(connection);
+            }
+
+            if (!connection.closed && (ready.events & SocketPoller::Write))
+                flush(connection);
+        }
+
+        // Destroy the connections which left the reactor during this iteration
+        for (std::vector<Connection*>::iterator it = worker.closed.begin(); it != worker.closed.end(); ++it)
+        {
+            if ((*it)->listener)
+                delete (*it)->socket;
+
+            delete *it;
+        }
+
+        worker.closed.clear();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool NetworkReactor::processCommands(Worker& worker)
+{
+    std::vector<Connection*>& processing = worker.processing;
+
+    // Additions
+    {
+        Lock lock(worker.mutex);
+        if (worker.stopping)
+            return false;
+
+        // Commands posted from now on will wake the next wait up
+        worker.awake = false;
+        processing.swap(worker.additions);
+    }
+
+    for (std::vector<Connection*>::iterator it = processing.begin(); it != processing.end(); ++it)
+    {
+        Connection& connection = **it;
+        if (connection.closed)
+            continue;
+
+        if (!worker.poller.add(*connection.socket, SocketPoller::Read, &connection))
+        {
+            close(connection);
+            continue;
+        }
+
+        if (connection.listener)
+            onAccept(*connection.listener, static_cast<TcpSocket&>(*connection.socket));
+    }
+
+    processing.clear();
+
+    // Flushes
+    {
+        Lock lock(worker.mutex);
+        processing.swap(worker.flushes);
+        for (std::vector<Connection*>::iterator it = processing.begin(); it != processing.end(); ++it)
+            (*it)->queued = false;
+    }
+
+    for (std::vector<Connection*>::iterator it = processing.begin(); it != processing.end(); ++it)
+    {
+        if (!(*it)->closed)
+            flush(**it);
+    }
+
+    processing.clear();
+
+    // Removals
+    {
+        Lock lock(worker.mutex);
+        processing.swap(worker.removals);
+    }
+
+    for (std::vector<Connection*>::iterator it = processing.begin(); it != processing.end(); ++it)
+    {
+        if (!(*it)->closed)
+            close(**it);
+    }
+
+    processing.clear();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::accept(Connection& connection)
+{
+    TcpListener& listener = static_cast<TcpListener&>(*connection.socket);
+
+    for (unsigned int i = 0; i < maxOperationsPerEvent; ++i)
+    {
+        TcpSocket* socket = new TcpSocket;
+        if (listener.accept(*socket) != Socket::Done)
+        {
+            delete socket;
+            break;
+        }
+
+        socket->setBlocking(false);
+
+        // The new connection is handed to its thread, which notifies it with onAccept
+        Connection* accepted = new Connection(Connection::Tcp, socket, &listener);
+        addConnection(accepted);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::receive(Connection& connection)
+{
+    Packet& packet = connection.worker->packet;
+
+    if (connection.type == Connection::Tcp)
+    {
+        TcpSocket& socket = static_cast<TcpSocket&>(*connection.socket);
+
+        for (unsigned int i = 0; (i < maxOperationsPerEvent) && !connection.closed; ++i)
+        {
+            Socket::Status status = socket.receive(packet);
+            if (status == Socket::Done)
+            {
+                onReceive(socket, packet);
+            }
+            else
+            {
+                if ((status == Socket::Disconnected) || (status == Socket::Error))
+                    close(connection);
+
+                break;
+            }
+        }
+    }
+    else
+    {
+        UdpSocket& socket = static_cast<UdpSocket&>(*connection.socket);
+        IpAddress sender;
+        unsigned short port = 0;
+
+        for (unsigned int i = 0; (i < maxOperationsPerEvent) && !connection.closed; ++i)
+        {
+            if (socket.receive(packet, sender, port) != Socket::Done)
+                break;
+
+            onReceiveFrom(socket, packet, sender, port);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::flush(Connection& connection)
+{
+    TcpSocket& socket = static_cast<TcpSocket&>(*connection.socket);
+    Worker& worker = *connection.worker;
+
+    // Take all the queued packets, unless the previous ones are not sent yet
+    if (connection.sending.empty())
+    {
+        Lock lock(worker.mutex);
+        connection.sending.swap(connection.pending);
+    }
+
+    if (connection.sending.empty())
+        return;
+
+    Socket::Status status = socket.send(&connection.sending[0], connection.sending.size());
+    if ((status == Socket::Partial) || (status == Socket::NotReady))
+    {
+        // Resume when the socket can send again
+        if (!connection.writing)
+            connection.writing = worker.poller.modify(socket, SocketPoller::Read | SocketPoller::Write, &connection);
+
+        return;
+    }
+
+    if (status != Socket::Done)
+    {
+        close(connection);
+        return;
+    }
+
+    connection.sending.clear();
+
+    if (connection.writing)
+    {
+        worker.poller.modify(socket, SocketPoller::Read, &connection);
+        connection.writing = false;
+    }
+
+    // The packets queued meanwhile will be sent by the next flush
+    bool drained = false;
+    {
+        Lock lock(worker.mutex);
+        drained = connection.pending.empty();
+    }
+
+    if (drained)
+        onSent(socket);
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkReactor::close(Connection& connection)
+{
+    if (connection.closed)
+        return;
+
+    connection.closed = true;
+
+    Worker& worker = *connection.worker;
+    worker.poller.remove(*connection.socket);
+
+    // Stop the other threads from posting commands for the connection
+    {
+        Lock lock(m_mutex);
+
+        std::map<Socket*, Connection*>::iterator it = m_connections.find(connection.socket);
+        if ((it != m_connections.end()) && (it->second == &connection))
+            m_connections.erase(it);
+
+        Lock workerLock(worker.mutex);
+        erase(worker.additions, &connection);
+        erase(worker.flushes, &connection);
+        erase(worker.removals, &connection);
+    }
+
+    if (connection.type == Connection::Tcp)
+        onDisconnect(static_cast<TcpSocket&>(*connection.socket));
+
+    worker.closed.push_back(&connection);
+}
+
+} // namespace sf
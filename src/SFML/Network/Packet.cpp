@@ -26,8 +26,10 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Packet.hpp>
+#include <SFML/Network/PacketPool.hpp>
 #include <SFML/Network/SocketImpl.hpp>
 #include <SFML/System/String.hpp>
+#include <algorithm>
 #include <cstring>
 #include <cwchar>
 
@@ -36,18 +38,67 @@ namespace sf
 {
 ////////////////////////////////////////////////////////////
 Packet::Packet() :
-m_readPos(0),
-m_sendPos(0),
-m_isValid(true)
+m_data    (m_inline),
+m_size    (0),
+m_capacity(InlineCapacity),
+m_pool    (NULL),
+m_readPos (0),
+m_sendPos (0),
+m_isValid (true)
 {
 
 }
 
 
+////////////////////////////////////////////////////////////
+Packet::Packet(PacketPool& pool) :
+m_data    (m_inline),
+m_size    (0),
+m_capacity(InlineCapacity),
+m_pool    (&pool),
+m_readPos (0),
+m_sendPos (0),
+m_isValid (true)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+Packet::Packet(const Packet& copy) :
+m_data    (m_inline),
+m_size    (0),
+m_capacity(InlineCapacity),
+m_pool    (copy.m_pool),
+m_readPos (copy.m_readPos),
+m_sendPos (copy.m_sendPos),
+m_isValid (copy.m_isValid)
+{
+    append(copy.m_data, copy.m_size);
+}
+
+
 ////////////////////////////////////////////////////////////
 Packet::~Packet()
 {
+    release();
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::operator =(const Packet& right)
+{
+    if (this != &right)
+    {
+        m_size = 0;
+        append(right.m_data, right.m_size);
 
+        m_readPos = right.m_readPos;
+        m_sendPos = right.m_sendPos;
+        m_isValid = right.m_isValid;
+    }
+
+    return *this;
 }
 
 
@@ -56,9 +107,11 @@ void Packet::append(const void* data, std::size_t sizeInBytes)
 {
     if (data && (sizeInBytes > 0))
     {
-        std::size_t start = m_data.size();
-        m_data.resize(start + sizeInBytes);
-        std::memcpy(&m_data[start], data, sizeInBytes);
+        if (m_size + sizeInBytes > m_capacity)
+            grow(m_size + sizeInBytes);
+
+        std::memcpy(m_data + m_size, data, sizeInBytes);
+        m_size += sizeInBytes;
     }
 }
 
@@ -73,30 +126,53 @@ std::size_t Packet::getReadPosition() const
 ////////////////////////////////////////////////////////////
 void Packet::clear()
 {
-    m_data.clear();
+    m_size = 0;
     m_readPos = 0;
     m_isValid = true;
 }
 
 
+////////////////////////////////////////////////////////////
+void Packet::reset()
+{
+    clear();
+    m_sendPos = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void Packet::reserve(std::size_t size)
+{
+    if (size > m_capacity)
+        grow(size);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Packet::getCapacity() const
+{
+    return m_capacity;
+}
+
+
 ////////////////////////////////////////////////////////////
 const void* Packet::getData() const
 {
-    return !m_data.empty() ? &m_data[0] : NULL;
+    return (m_size > 0) ? m_data : NULL;
 }
 
 
 ////////////////////////////////////////////////////////////
 std::size_t Packet::getDataSize() const
 {
-    return m_data.size();
+    return m_size;
 }
 
 
 ////////////////////////////////////////////////////////////
 bool Packet::endOfPacket() const
 {
-    return m_readPos >= m_data.size();
+    return m_readPos >= m_size;
 }
 
 
@@ -123,7 +199,7 @@ Packet& Packet::operator >>(Int8& data)
 {
     if (checkSize(sizeof(data)))
     {
-        std::memcpy(&data, &m_data[m_readPos], sizeof(data));
+        std::memcpy(&data, m_data + m_readPos, sizeof(data));
         m_readPos += sizeof(data);
     }
 
@@ -136,7 +212,7 @@ Packet& Packet::operator >>(Uint8& data)
 {
     if (checkSize(sizeof(data)))
     {
-        std::memcpy(&data, &m_data[m_readPos], sizeof(data));
+        std::memcpy(&data, m_data + m_readPos, sizeof(data));
         m_readPos += sizeof(data);
     }
 
@@ -149,7 +225,7 @@ Packet& Packet::operator >>(Int16& data)
 {
     if (checkSize(sizeof(data)))
     {
-        std::memcpy(&data, &m_data[m_readPos], sizeof(data));
+        std::memcpy(&data, m_data + m_readPos, sizeof(data));
         data = static_cast<Int16>(ntohs(static_cast<Uint16>(data)));
         m_readPos += sizeof(data);
     }
@@ -163,7 +239,7 @@ Packet& Packet::operator >>(Uint16& data)
 {
     if (checkSize(sizeof(data)))
     {
-        std::memcpy(&data, &m_data[m_readPos], sizeof(data));
+        std::memcpy(&data, m_data + m_readPos, sizeof(data));
         data = ntohs(data);
         m_readPos += sizeof(data);
     }
@@ -177,7 +253,7 @@ Packet& Packet::operator >>(Int32& data)
 {
     if (checkSize(sizeof(data)))
     {
-        std::memcpy(&data, &m_data[m_readPos], sizeof(data));
+        std::memcpy(&data, m_data + m_readPos, sizeof(data));
         data = static_cast<Int32>(ntohl(static_cast<Uint32>(data)));
         m_readPos += sizeof(data);
     }
@@ -191,7 +267,7 @@ Packet& Packet::operator >>(Uint32& data)
 {
     if (checkSize(sizeof(data)))
     {
-        std::memcpy(&data, &m_data[m_readPos], sizeof(data));
+        std::memcpy(&data, m_data + m_readPos, sizeof(data));
         data = ntohl(data);
         m_readPos += sizeof(data);
     }
@@ -208,7 +284,7 @@ Packet& Packet::operator >>(Int64& data)
         // Since ntohll is not available everywhere, we have to convert
         // to network byte order (big endian) manually
         Uint8 bytes[sizeof(data)];
-        std::memcpy(bytes, &m_data[m_readPos], sizeof(data));
+        std::memcpy(bytes, m_data + m_readPos, sizeof(data));
         data = (static_cast<Int64>(bytes[0]) << 56) |
                (static_cast<Int64>(bytes[1]) << 48) |
                (static_cast<Int64>(bytes[2]) << 40) |
@@ -232,7 +308,7 @@ Packet& Packet::operator >>(Uint64& data)
         // Since ntohll is not available everywhere, we have to convert
         // to network byte order (big endian) manually
         Uint8 bytes[sizeof(data)];
-        std::memcpy(bytes, &m_data[m_readPos], sizeof(data));
+        std::memcpy(bytes, m_data + m_readPos, sizeof(data));
         data = (static_cast<Uint64>(bytes[0]) << 56) |
                (static_cast<Uint64>(bytes[1]) << 48) |
                (static_cast<Uint64>(bytes[2]) << 40) |
@@ -253,7 +329,7 @@ Packet& Packet::operator >>(float& data)
 {
     if (checkSize(sizeof(data)))
     {
-        std::memcpy(&data, &m_data[m_readPos], sizeof(data));
+        std::memcpy(&data, m_data + m_readPos, sizeof(data));
         m_readPos += sizeof(data);
     }
 
@@ -266,7 +342,7 @@ Packet& Packet::operator >>(double& data)
 {
     if (checkSize(sizeof(data)))
     {
-        std::memcpy(&data, &m_data[m_readPos], sizeof(data));
+        std::memcpy(&data, m_data + m_readPos, sizeof(data));
         m_readPos += sizeof(data);
     }
 
@@ -284,7 +360,7 @@ Packet& Packet::operator >>(char* data)
     if ((length > 0) && checkSize(length))
     {
         // Then extract characters
-        std::memcpy(data, &m_data[m_readPos], length);
+        std::memcpy(data, m_data + m_readPos, length);
         data[length] = '\0';
 
         // Update reading position
@@ -306,7 +382,7 @@ Packet& Packet::operator >>(std::string& data)
     if ((length > 0) && checkSize(length))
     {
         // Then extract characters
-        data.assign(&m_data[m_readPos], length);
+        data.assign(m_data + m_readPos, length);
 
         // Update reading position
         m_readPos += length;
@@ -586,12 +662,48 @@ Packet& Packet::operator <<(const String& data)
 ////////////////////////////////////////////////////////////
 bool Packet::checkSize(std::size_t size)
 {
-    m_isValid = m_isValid && (m_readPos + size <= m_data.size());
+    m_isValid = m_isValid && (m_readPos + size <= m_size);
 
     return m_isValid;
 }
 
 
+////////////////////////////////////////////////////////////
+void Packet::grow(std::size_t capacity)
+{
+    // Grow geometrically, so that appending data has a constant amortized cost
+    capacity = std::max(capacity, m_capacity * 2);
+
+    // Get the new storage from the pool if possible, from the heap otherwise
+    void* data = m_pool ? m_pool->allocate(capacity) : NULL;
+    if (!data)
+        data = new char[capacity];
+
+    std::memcpy(data, m_data, m_size);
+
+    release();
+    m_data = static_cast<char*>(data);
+    m_capacity = capacity;
+}
+
+
+////////////////////////////////////////////////////////////
+void Packet::release()
+{
+    if (m_data != m_inline)
+    {
+        // Blocks up to the largest size of the pool come from the pool
+        if (m_pool && (m_capacity <= PacketPool::MaxBlockSize))
+            m_pool->deallocate(m_data, m_capacity);
+        else
+            delete[] m_data;
+    }
+
+    m_data = m_inline;
+    m_capacity = InlineCapacity;
+}
+
+
 ////////////////////////////////////////////////////////////
 const void* Packet::onSend(std::size_t& size)
 {
@@ -0,0 +1,155 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2023 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/PacketPool.hpp>
+#include <SFML/System/Lock.hpp>
+#include <cassert>
+
+
+namespace
+{
+    // Get the index of the size class of a block
+    std::size_t getSizeClass(std::size_t size)
+    {
+        std::size_t index = 0;
+        std::size_t blockSize = sf::PacketPool::MinBlockSize;
+        while (blockSize < size)
+        {
+            blockSize *= 2;
+            ++index;
+        }
+
+        return index;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+PacketPool::PacketPool()
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+PacketPool::~PacketPool()
+{
+    clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void* PacketPool::allocate(std::size_t& size)
+{
+    if (size > MaxBlockSize)
+        return NULL;
+
+    std::size_t index = getSizeClass(size);
+    size = static_cast<std::size_t>(MinBlockSize) << index;
+
+    // Reuse a cached block if possible
+    {
+        SizeClass& sizeClass = m_classes[index];
+        Lock lock(sizeClass.mutex);
+
+        if (sizeClass.blocks)
+        {
+            void* block = sizeClass.blocks;
+            sizeClass.blocks = *static_cast<void**>(block);
+            --sizeClass.count;
+            return block;
+        }
+    }
+
+    return new char[size];
+}
+
+
+////////////////////////////////////////////////////////////
+void PacketPool::deallocate(void* block, std::size_t size)
+{
+    if (!block)
+        return;
+
+    std::size_t index = getSizeClass(size);
+    assert(size == (static_cast<std::size_t>(MinBlockSize) << index));
+
+    // The free list is stored in the cached blocks themselves
+    SizeClass& sizeClass = m_classes[index];
+    Lock lock(sizeClass.mutex);
+
+    *static_cast<void**>(block) = sizeClass.blocks;
+    sizeClass.blocks = block;
+    ++sizeClass.count;
+}
+
+
+////////////////////////////////////////////////////////////
+void PacketPool::clear()
+{
+    for (std::size_t i = 0; i < SizeClassCount; ++i)
+    {
+        SizeClass& sizeClass = m_classes[i];
+        Lock lock(sizeClass.mutex);
+
+        while (sizeClass.blocks)
+        {
+            void* block = sizeClass.blocks;
+            sizeClass.blocks = *static_cast<void**>(block);
+            delete[] static_cast<char*>(block);
+        }
+
+        sizeClass.count = 0;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t PacketPool::getCachedSize() const
+{
+    std::size_t size = 0;
+    for (std::size_t i = 0; i < SizeClassCount; ++i)
+    {
+        Lock lock(m_classes[i].mutex);
+        size += m_classes[i].count * (static_cast<std::size_t>(MinBlockSize) << i);
+    }
+
+    return size;
+}
+
+
+////////////////////////////////////////////////////////////
+PacketPool::SizeClass::SizeClass() :
+blocks(NULL),
+count (0)
+{
+
+}
+
+} // namespace sf
@@ -148,4 +148,11 @@ void Socket::close()
     }
 }
 
+
+////////////////////////////////////////////////////////////
+bool Socket::hasBufferedData() const
+{
+    return false;
+}
+
 } // namespace sf
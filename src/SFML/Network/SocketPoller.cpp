@@ -0,0 +1,459 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2023 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/SocketPoller.hpp>
+#include <SFML/Network/Socket.hpp>
+#include <SFML/Network/SocketImpl.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <climits>
+#include <map>
+#include <vector>
+
+#if defined(SFML_SYSTEM_LINUX) || defined(SFML_SYSTEM_ANDROID)
+    #define SFML_SOCKETPOLLER_EPOLL
+    #include <sys/epoll.h>
+    #include <cerrno>
+    #include <cstring>
+#endif
+
+
+namespace
+{
+    // Maximum number of events retrieved by a single call to epoll_wait
+    const std::size_t maxEventsPerWait = 1024;
+
+    // Convert a timeout to milliseconds, rounded up so that wait never returns too early
+    int toMilliseconds(sf::Time timeout)
+    {
+        if (timeout == sf::Time::Zero)
+            return -1;
+
+        sf::Int64 milliseconds = (timeout.asMicroseconds() + 999) / 1000;
+        if (milliseconds < 0)
+            return 0;
+
+        return milliseconds < INT_MAX ? static_cast<int>(milliseconds) : INT_MAX;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+struct SocketPoller::SocketPollerImpl
+{
+    struct Registration
+    {
+        Socket*      socket;   //!< Registered socket
+        SocketHandle handle;   //!< Handle of the socket when it was registered
+        unsigned int events;   //!< Watched events
+        void*        userData; //!< User data to give back with the events
+        std::size_t  index;    //!< Index of the descriptor, with poll
+        Uint64       reported; //!< Last wait which reported the socket
+        std::size_t  position; //!< Position of the socket in the ready sockets of that wait
+    };
+
+    typedef std::map<SocketHandle, Registration> RegistrationMap;
+
+    RegistrationMap            registrations; //!< Registered sockets, by handle
+    std::vector<ReadySocket>   ready;         //!< Sockets reported by the last wait
+    std::vector<Registration*> watched;       //!< Sockets which may hold buffered data
+    std::vector<Registration*> reported;      //!< Sockets reported by the current wait
+    Uint64                     waitCount;     //!< Number of calls to wait
+
+#if defined(SFML_SOCKETPOLLER_EPOLL)
+
+    int                      epoll;         //!< Epoll instance
+    std::vector<epoll_event> events;        //!< Events retrieved by epoll_wait
+
+#else
+
+    std::vector<priv::SocketImpl::PollDescriptor> descriptors; //!< Descriptors given to poll
+    std::vector<Registration*>                    owners;      //!< Registration of each descriptor
+
+#endif
+
+    ////////////////////////////////////////////////////////////
+    unsigned int toEvents(unsigned int native, const Registration& registration) const
+    {
+        unsigned int result = 0;
+
+#if defined(SFML_SOCKETPOLLER_EPOLL)
+
+        if (native & EPOLLIN)
+            result |= Read;
+        if (native & EPOLLOUT)
+            result |= Write;
+        if (native & (EPOLLERR | EPOLLHUP))
+            result |= Error;
+
+#else
+
+        if (native & priv::SocketImpl::PollRead)
+            result |= Read;
+        if (native & priv::SocketImpl::PollWrite)
+            result |= Write;
+        if (native & priv::SocketImpl::PollError)
+            result |= Error;
+
+#endif
+
+        // Errors are reported with the watched events, so that the next
+        // send or receive of the socket returns the actual status
+        if (result & Error)
+            result |= registration.events & (Read | Write);
+
+        return result;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void report(Registration& registration, unsigned int flags)
+    {
+        // Merge the events of a socket reported twice
+        if (registration.reported == waitCount)
+        {
+            ready[registration.position].events |= flags;
+            return;
+        }
+
+        registration.reported = waitCount;
+        registration.position = ready.size();
+
+        ReadySocket socket;
+        socket.socket   = registration.socket;
+        socket.events   = flags;
+        socket.userData = registration.userData;
+        ready.push_back(socket);
+        reported.push_back(&registration);
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool hasBufferedData() const
+    {
+        for (std::vector<Registration*>::const_iterator it = watched.begin(); it != watched.end(); ++it)
+        {
+            if (((*it)->events & Read) && (*it)->socket->hasBufferedData())
+                return true;
+        }
+
+        return false;
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool watch(Registration& registration, Trigger trigger, bool added)
+    {
+        // Data may have been buffered by the socket before it was watched
+        if (std::find(watched.begin(), watched.end(), &registration) == watched.end())
+            watched.push_back(&registration);
+
+#if defined(SFML_SOCKETPOLLER_EPOLL)
+
+        epoll_event event;
+        std::memset(&event, 0, sizeof(event));
+        event.events   = ((registration.events & Read) ? EPOLLIN : 0u) |
+                         ((registration.events & Write) ? EPOLLOUT : 0u) |
+                         ((trigger == EdgeTriggered) ? static_cast<unsigned int>(EPOLLET) : 0u);
+        event.data.ptr = &registration;
+
+        int result = epoll_ctl(epoll, added ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, registration.handle, &event);
+
+        // The handle may still be registered if it was reused after its socket was closed
+        if ((result < 0) && added && (errno == EEXIST))
+            result = epoll_ctl(epoll, EPOLL_CTL_MOD, registration.handle, &event);
+
+        if (result < 0)
+        {
+            err() << "Failed to watch a socket with the poller: " << std::strerror(errno) << std::endl;
+            return false;
+        }
+
+#else
+
+        // Edge-triggered events can't be emulated with poll
+        (void)trigger;
+
+        if (added)
+        {
+            registration.index = descriptors.size();
+            descriptors.push_back(priv::SocketImpl::PollDescriptor());
+            owners.push_back(&registration);
+        }
+
+        priv::SocketImpl::PollDescriptor& descriptor = descriptors[registration.index];
+        descriptor.fd      = registration.handle;
+        descriptor.events  = static_cast<short>(((registration.events & Read) ? priv::SocketImpl::PollRead : 0) |
+                                                ((registration.events & Write) ? priv::SocketImpl::PollWrite : 0));
+        descriptor.revents = 0;
+
+#endif
+
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void unwatch(RegistrationMap::iterator it)
+    {
+#if defined(SFML_SOCKETPOLLER_EPOLL)
+
+        // Fails harmlessly if the socket was already closed
+        epoll_event event;
+        std::memset(&event, 0, sizeof(event));
+        epoll_ctl(epoll, EPOLL_CTL_DEL, it->second.handle, &event);
+
+#else
+
+        // Move the last descriptor in place of the removed one
+        std::size_t index = it->second.index;
+        descriptors[index] = descriptors.back();
+        owners[index] = owners.back();
+        owners[index]->index = index;
+        descriptors.pop_back();
+        owners.pop_back();
+
+#endif
+
+        watched.erase(std::remove(watched.begin(), watched.end(), &it->second), watched.end());
+        reported.erase(std::remove(reported.begin(), reported.end(), &it->second), reported.end());
+        registrations.erase(it);
+    }
+
+    ////////////////////////////////////////////////////////////
+    RegistrationMap::iterator find(Socket& socket)
+    {
+        RegistrationMap::iterator it = registrations.find(socket.getHandle());
+        if ((it != registrations.end()) && (it->second.socket == &socket))
+            return it;
+
+        // The socket may have been closed, or recreated, since it was added
+        for (it = registrations.begin(); it != registrations.end(); ++it)
+        {
+            if (it->second.socket == &socket)
+                return it;
+        }
+
+        return registrations.end();
+    }
+};
+
+
+////////////////////////////////////////////////////////////
+SocketPoller::SocketPoller() :
+m_impl(new SocketPollerImpl)
+{
+    m_impl->waitCount = 0;
+
+#if defined(SFML_SOCKETPOLLER_EPOLL)
+
+    m_impl->epoll = epoll_create1(EPOLL_CLOEXEC);
+    if (m_impl->epoll < 0)
+        err() << "Failed to create the socket poller: " << std::strerror(errno) << std::endl;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+SocketPoller::~SocketPoller()
+{
+#if defined(SFML_SOCKETPOLLER_EPOLL)
+
+    if (m_impl->epoll >= 0)
+        ::close(m_impl->epoll);
+
+#endif
+
+    delete m_impl;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SocketPoller::add(Socket& socket, unsigned int events, void* userData, Trigger trigger)
+{
+    SocketHandle handle = socket.getHandle();
+    if (handle == priv::SocketImpl::invalidSocket())
+        return false;
+
+    SocketPollerImpl::RegistrationMap::iterator it = m_impl->registrations.find(handle);
+    if (it != m_impl->registrations.end())
+    {
+        if (it->second.socket == &socket)
+            return false;
+
+        // The handle belonged to a socket which was closed without being removed
+        m_impl->unwatch(it);
+    }
+
+    SocketPollerImpl::Registration& registration = m_impl->registrations[handle];
+    registration.socket   = &socket;
+    registration.handle   = handle;
+    registration.events   = events;
+    registration.userData = userData;
+    registration.index    = 0;
+    registration.reported = 0;
+    registration.position = 0;
+
+    if (!m_impl->watch(registration, trigger, true))
+    {
+        m_impl->registrations.erase(handle);
+        return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SocketPoller::modify(Socket& socket, unsigned int events, void* userData, Trigger trigger)
+{
+    SocketPollerImpl::RegistrationMap::iterator it = m_impl->find(socket);
+    if (it == m_impl->registrations.end())
+        return false;
+
+    it->second.events   = events;
+    it->second.userData = userData;
+
+    return m_impl->watch(it->second, trigger, false);
+}
+
+
+////////////////////////////////////////////////////////////
+void SocketPoller::remove(Socket& socket)
+{
+    SocketPollerImpl::RegistrationMap::iterator it = m_impl->find(socket);
+    if (it != m_impl->registrations.end())
+        m_impl->unwatch(it);
+
+    // Don't report the removed socket anymore
+    for (std::vector<ReadySocket>::iterator ready = m_impl->ready.begin(); ready != m_impl->ready.end(); ++ready)
+    {
+        if (ready->socket == &socket)
+        {
+            ready->socket = NULL;
+            ready->events = 0;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SocketPoller::clear()
+{
+    while (!m_impl->registrations.empty())
+        m_impl->unwatch(m_impl->registrations.begin());
+
+    m_impl->ready.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SocketPoller::getSocketCount() const
+{
+    return m_impl->registrations.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SocketPoller::wait(Time timeout)
+{
+    m_impl->ready.clear();
+    m_impl->reported.clear();
+    ++m_impl->waitCount;
+
+    // Sockets which hold buffered data are ready without waiting
+    int milliseconds = m_impl->hasBufferedData() ? 0 : toMilliseconds(timeout);
+
+#if defined(SFML_SOCKETPOLLER_EPOLL)
+
+    std::size_t maxEvents = m_impl->registrations.size();
+    maxEvents = (maxEvents < 1) ? 1 : ((maxEvents > maxEventsPerWait) ? maxEventsPerWait : maxEvents);
+    m_impl->events.resize(maxEvents);
+
+    // Wait until one of the sockets is ready, or timeout is reached
+    int count = epoll_wait(m_impl->epoll, &m_impl->events[0], static_cast<int>(maxEvents), milliseconds);
+    if ((count < 0) && (errno != EINTR))
+        err() << "Failed to wait for the sockets of the poller: " << std::strerror(errno) << std::endl;
+
+    for (int i = 0; i < count; ++i)
+    {
+        const epoll_event& event = m_impl->events[static_cast<std::size_t>(i)];
+        SocketPollerImpl::Registration& registration = *static_cast<SocketPollerImpl::Registration*>(event.data.ptr);
+        m_impl->report(registration, m_impl->toEvents(event.events, registration));
+    }
+
+#else
+
+    // Wait until one of the sockets is ready, or timeout is reached
+    std::vector<priv::SocketImpl::PollDescriptor>& descriptors = m_impl->descriptors;
+    int count = priv::SocketImpl::poll(descriptors.empty() ? NULL : &descriptors[0], descriptors.size(), milliseconds);
+    if (count < 0)
+        err() << "Failed to wait for the sockets of the poller" << std::endl;
+
+    for (std::size_t i = 0; (i < descriptors.size()) && (m_impl->ready.size() < static_cast<std::size_t>(count)); ++i)
+    {
+        if (descriptors[i].revents != 0)
+        {
+            SocketPollerImpl::Registration& registration = *m_impl->owners[i];
+            m_impl->report(registration, m_impl->toEvents(static_cast<unsigned int>(descriptors[i].revents), registration));
+        }
+    }
+
+#endif
+
+    // Report the sockets which hold buffered data, even if the system has nothing more for them
+    for (std::vector<SocketPollerImpl::Registration*>::iterator it = m_impl->watched.begin(); it != m_impl->watched.end(); ++it)
+    {
+        if (((*it)->events & Read) && (*it)->socket->hasBufferedData())
+            m_impl->report(**it, Read);
+    }
+
+    // Data can only be buffered by the sockets which are received from, so these are the ones to check next time
+    m_impl->watched.swap(m_impl->reported);
+    m_impl->reported.clear();
+
+    return m_impl->ready.size();
+}
+
+
+////////////////////////////////////////////////////////////
+const SocketPoller::ReadySocket& SocketPoller::getReadySocket(std::size_t index) const
+{
+    return m_impl->ready[index];
+}
+
+
+////////////////////////////////////////////////////////////
+bool SocketPoller::isEdgeTriggeredSupported()
+{
+#if defined(SFML_SOCKETPOLLER_EPOLL)
+    return true;
+#else
+    return false;
+#endif
+}
+
+} // namespace sf
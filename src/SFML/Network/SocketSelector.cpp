@@ -31,6 +31,7 @@
 #include <SFML/System/Err.hpp>
 #include <algorithm>
 #include <utility>
+#include <vector>
 
 #ifdef _MSC_VER
     #pragma warning(disable: 4127) // "conditional expression is constant" generated by the FD_SET macro
@@ -46,6 +47,8 @@ struct SocketSelector::SocketSelectorImpl
     fd_set socketsReady; //!< Set containing handles of the sockets that are ready
     int    maxSocket;    //!< Maximum socket handle
     int    socketCount;  //!< Number of socket handles
+
+    std::vector<Socket*> sockets; //!< Sockets of the selector, which may hold buffered data
 };
 
 
@@ -110,6 +113,9 @@ void SocketSelector::add(Socket& socket)
 #endif
 
         FD_SET(handle, &m_impl->allSockets);
+
+        if (std::find(m_impl->sockets.begin(), m_impl->sockets.end(), &socket) == m_impl->sockets.end())
+            m_impl->sockets.push_back(&socket);
     }
 }
 
@@ -117,6 +123,8 @@ void SocketSelector::add(Socket& socket)
 ////////////////////////////////////////////////////////////
 void SocketSelector::remove(Socket& socket)
 {
+    m_impl->sockets.erase(std::remove(m_impl->sockets.begin(), m_impl->sockets.end(), &socket), m_impl->sockets.end());
+
     SocketHandle handle = socket.getHandle();
     if (handle != priv::SocketImpl::invalidSocket())
     {
@@ -149,6 +157,7 @@ void SocketSelector::clear()
 
     m_impl->maxSocket = 0;
     m_impl->socketCount = 0;
+    m_impl->sockets.clear();
 }
 
 
@@ -160,12 +169,37 @@ bool SocketSelector::wait(Time timeout)
     time.tv_sec  = static_cast<long>(timeout.asMicroseconds() / 1000000);
     time.tv_usec = static_cast<int>(timeout.asMicroseconds() % 1000000);
 
+    // Sockets which hold buffered data are ready without waiting
+    bool buffered = false;
+    for (std::vector<Socket*>::const_iterator it = m_impl->sockets.begin(); it != m_impl->sockets.end(); ++it)
+        buffered = buffered || (*it)->hasBufferedData();
+
+    if (buffered)
+    {
+        time.tv_sec  = 0;
+        time.tv_usec = 0;
+    }
+
     // Initialize the set that will contain the sockets that are ready
     m_impl->socketsReady = m_impl->allSockets;
 
     // Wait until one of the sockets is ready for reading, or timeout is reached
     // The first parameter is ignored on Windows
-    int count = select(m_impl->maxSocket + 1, &m_impl->socketsReady, NULL, NULL, timeout != Time::Zero ? &time : NULL);
+    int count = select(m_impl->maxSocket + 1, &m_impl->socketsReady, NULL, NULL, (timeout != Time::Zero) || buffered ? &time : NULL);
+
+    if (buffered)
+    {
+        if (count < 0)
+            FD_ZERO(&m_impl->socketsReady);
+
+        for (std::vector<Socket*>::const_iterator it = m_impl->sockets.begin(); it != m_impl->sockets.end(); ++it)
+        {
+            if ((*it)->hasBufferedData())
+                FD_SET((*it)->getHandle(), &m_impl->socketsReady);
+        }
+
+        return true;
+    }
 
     return count > 0;
 }
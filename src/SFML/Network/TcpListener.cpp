@@ -121,8 +121,8 @@ Socket::Status TcpListener::accept(TcpSocket& socket)
     if (remote == priv::SocketImpl::invalidSocket())
         return priv::SocketImpl::getErrorStatus();
 
-    // Initialize the new connected socket
-    socket.close();
+    // Initialize the new connected socket, dropping the data of its previous connection
+    socket.disconnect();
     socket.create(remote);
 
     return Done;
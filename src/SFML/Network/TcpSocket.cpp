@@ -46,13 +46,21 @@ namespace
     #else
         const int flags = 0;
     #endif
+
+    // Maximum number of packets gathered in a single system call
+    const std::size_t maxPacketsPerCall = 64;
+
+    // Size of the receive buffer of the sockets
+    const std::size_t receiveBufferSize = 65536;
 }
 
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 TcpSocket::TcpSocket() :
-Socket(Tcp)
+Socket       (Tcp),
+m_bufferBegin(0),
+m_bufferEnd  (0)
 {
 
 }
@@ -216,6 +224,8 @@ void TcpSocket::disconnect()
 
     // Reset the pending packet data
     m_pendingPacket = PendingPacket();
+    m_bufferBegin = 0;
+    m_bufferEnd   = 0;
 }
 
 
@@ -280,6 +290,24 @@ Socket::Status TcpSocket::receive(void* data, std::size_t size, std::size_t& rec
         return Error;
     }
 
+    // Give the data buffered by a previous packet reception first
+    if (m_bufferBegin < m_bufferEnd)
+    {
+        received = std::min(size, m_bufferEnd - m_bufferBegin);
+        std::memcpy(data, &m_buffer[m_bufferBegin], received);
+        m_bufferBegin += received;
+        return Done;
+    }
+
+    return receiveBytes(data, size, received);
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TcpSocket::receiveBytes(void* data, std::size_t size, std::size_t& received)
+{
+    received = 0;
+
     #pragma GCC diagnostic push
     #pragma GCC diagnostic ignored "-Wuseless-cast"
     // Receive a chunk of bytes
@@ -305,58 +333,118 @@ Socket::Status TcpSocket::receive(void* data, std::size_t size, std::size_t& rec
 
 ////////////////////////////////////////////////////////////
 Socket::Status TcpSocket::send(Packet& packet)
+{
+    return send(&packet, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TcpSocket::send(Packet* packets, std::size_t count)
 {
     // TCP is a stream protocol, it doesn't preserve messages boundaries.
-    // This means that we have to send the packet size first, so that the
-    // receiver knows the actual end of the packet in the data stream.
+    // This means that we have to send the size of each packet first, so
+    // that the receiver knows the actual end of the packet in the data stream.
 
-    // We allocate an extra memory block so that the size can be sent
-    // together with the data in a single call. This may seem inefficient,
-    // but it is actually required to avoid partial send, which could cause
-    // data corruption on the receiving end.
+    // The size and the data of the packets are gathered from where they
+    // are, and sent together in a single call. Sending them in one call is
+    // required to avoid partial sends, which could cause data corruption on
+    // the receiving end. Each packet records how much of it was sent.
 
-    // Get the data to send from the packet
-    std::size_t size = 0;
-    const void* data = packet.onSend(size);
+    // Check the parameters
+    if (!packets || (count == 0))
+    {
+        err() << "Cannot send data over the network (no data to send)" << std::endl;
+        return Error;
+    }
 
-    // First convert the packet size to network byte order
-    Uint32 packetSize = htonl(static_cast<Uint32>(size));
+    Uint32                   sizes[maxPacketsPerCall];          // Packet sizes, in network byte order
+    Packet*                  owners[2 * maxPacketsPerCall];     // Packet of each block
+    const char*              blocks[2 * maxPacketsPerCall];     // Blocks of data to send
+    std::size_t              blockSizes[2 * maxPacketsPerCall]; // Sizes of the blocks
+    priv::SocketImpl::Buffer buffers[2 * maxPacketsPerCall];    // Blocks for the system call
 
-    // Allocate memory for the data block to send
-    std::vector<char> blockToSend(sizeof(packetSize) + size);
+    bool sentAny = false;
+    std::size_t next = 0;
+    while (next < count)
+    {
+        // Gather the blocks of the next packets which are not sent yet
+        std::size_t blockCount  = 0;
+        std::size_t packetCount = 0;
+        for (; (next < count) && (packetCount < maxPacketsPerCall); ++next)
+        {
+            Packet& packet = packets[next];
 
-    // Copy the packet size and data into the block to send
-    #pragma GCC diagnostic push
-    #pragma GCC diagnostic ignored "-Wnull-dereference" // False positive.
-    std::memcpy(&blockToSend[0], &packetSize, sizeof(packetSize));
-    #pragma GCC diagnostic pop
-    if (size > 0)
-        std::memcpy(&blockToSend[0] + sizeof(packetSize), data, size);
+            std::size_t size = 0;
+            const char* data = static_cast<const char*>(packet.onSend(size));
 
-    // These warnings are ignored here for portability, as even on Windows the
-    // signature of `send` might change depending on whether Win32 or MinGW is
-    // being used.
-    #pragma GCC diagnostic push
-    #pragma GCC diagnostic ignored "-Wuseless-cast"
-    #pragma GCC diagnostic push
-    #pragma GCC diagnostic ignored "-Wsign-conversion"
-    // Send the data block
-    std::size_t sent;
-    Status status = send(&blockToSend[0] + packet.m_sendPos, static_cast<priv::SocketImpl::Size>(blockToSend.size() - packet.m_sendPos), sent);
-    #pragma GCC diagnostic pop
-    #pragma GCC diagnostic pop
+            // Skip the packets completed by a previous partial send
+            if (packet.m_sendPos >= sizeof(Uint32) + size)
+                continue;
 
-    // In the case of a partial send, record the location to resume from
-    if (status == Partial)
-    {
-        packet.m_sendPos += sent;
-    }
-    else if (status == Done)
-    {
-        packet.m_sendPos = 0;
+            sizes[packetCount] = htonl(static_cast<Uint32>(size));
+            const char* header = reinterpret_cast<const char*>(&sizes[packetCount]);
+            ++packetCount;
+
+            if (packet.m_sendPos < sizeof(Uint32))
+            {
+                owners[blockCount]     = &packet;
+                blocks[blockCount]     = header + packet.m_sendPos;
+                blockSizes[blockCount] = sizeof(Uint32) - packet.m_sendPos;
+                ++blockCount;
+            }
+
+            std::size_t dataSent = (packet.m_sendPos > sizeof(Uint32)) ? packet.m_sendPos - sizeof(Uint32) : 0;
+            if (dataSent < size)
+            {
+                owners[blockCount]     = &packet;
+                blocks[blockCount]     = data + dataSent;
+                blockSizes[blockCount] = size - dataSent;
+                ++blockCount;
+            }
+        }
+
+        // Send the blocks, until they are all sent
+        std::size_t first = 0;
+        while (first < blockCount)
+        {
+            for (std::size_t i = first; i < blockCount; ++i)
+                priv::SocketImpl::setBuffer(buffers[i], blocks[i], blockSizes[i]);
+
+            long result = priv::SocketImpl::sendBuffers(getHandle(), &buffers[first], blockCount - first, flags);
+
+            // Check for errors
+            if (result < 0)
+            {
+                Status status = priv::SocketImpl::getErrorStatus();
+
+                if ((status == NotReady) && sentAny)
+                    return Partial;
+
+                return status;
+            }
+
+            // Record the progress of each packet
+            std::size_t sent = static_cast<std::size_t>(result);
+            sentAny = sentAny || (sent > 0);
+            while ((first < blockCount) && (sent > 0))
+            {
+                std::size_t size = std::min(sent, blockSizes[first]);
+                owners[first]->m_sendPos += size;
+                blocks[first]            += size;
+                blockSizes[first]        -= size;
+                sent                     -= size;
+
+                if (blockSizes[first] == 0)
+                    ++first;
+            }
+        }
     }
 
-    return status;
+    // Every packet has been sent: they can be sent again
+    for (std::size_t i = 0; i < count; ++i)
+        packets[i].m_sendPos = 0;
+
+    return Done;
 }
 
 
@@ -366,67 +454,116 @@ Socket::Status TcpSocket::receive(Packet& packet)
     // First clear the variables to fill
     packet.clear();
 
-    // We start by getting the size of the incoming packet
-    Uint32 packetSize = 0;
-    std::size_t received = 0;
-    if (m_pendingPacket.SizeReceived < sizeof(m_pendingPacket.Size))
+    // The receive buffer is allocated once, on first use
+    if (m_buffer.empty())
+        m_buffer.resize(receiveBufferSize);
+
+    for (;;)
     {
-        // Loop until we've received the entire size of the packet
-        // (even a 4 byte variable may be received in more than one call)
-        while (m_pendingPacket.SizeReceived < sizeof(m_pendingPacket.Size))
+        // A packet larger than the buffer is received directly in the pending packet
+        if (m_pendingPacket.Large)
         {
-            char* data = reinterpret_cast<char*>(&m_pendingPacket.Size) + m_pendingPacket.SizeReceived;
-            Status status = receive(data, sizeof(m_pendingPacket.Size) - m_pendingPacket.SizeReceived, received);
-            m_pendingPacket.SizeReceived += received;
+            std::vector<char>& data = m_pendingPacket.Data;
+            while (m_pendingPacket.Received < m_pendingPacket.Size)
+            {
+                // Grow the data as it arrives rather than trusting the size sent by the peer,
+                // so that no more than twice the received data is ever allocated
+                if (m_pendingPacket.Received == data.size())
+                {
+                    std::size_t remaining = m_pendingPacket.Size - m_pendingPacket.Received;
+                    data.resize(data.size() + std::min(remaining, std::max(data.size(), receiveBufferSize)));
+                }
 
-            if (status != Done)
-                return status;
+                std::size_t received = 0;
+                Status status = receiveBytes(&data[m_pendingPacket.Received], data.size() - m_pendingPacket.Received, received);
+                if (status != Done)
+                    return status;
+
+                m_pendingPacket.Received += received;
+            }
+
+            // We have received all the packet data: we can copy it to the user packet
+            packet.onReceive(&data[0], m_pendingPacket.Size);
+
+            // Clear the pending packet data, but keep its memory for the next large packets
+            m_pendingPacket.Size     = 0;
+            m_pendingPacket.Received = 0;
+            m_pendingPacket.Large    = false;
+            data.clear();
+
+            return Done;
         }
 
-        // The packet size has been fully received
-        packetSize = ntohl(m_pendingPacket.Size);
-    }
-    else
-    {
-        // The packet size has already been received in a previous call
-        packetSize = ntohl(m_pendingPacket.Size);
-    }
+        // Parse the next packet from the buffered data, if it is complete
+        std::size_t available = m_bufferEnd - m_bufferBegin;
+        if (available >= sizeof(Uint32))
+        {
+            Uint32 size = 0;
+            std::memcpy(&size, &m_buffer[m_bufferBegin], sizeof(size));
+            std::size_t packetSize = ntohl(size);
 
-    // Loop until we receive all the packet data
-    char buffer[1024];
-    while (m_pendingPacket.Data.size() < packetSize)
-    {
-        // Receive a chunk of data
-        std::size_t sizeToGet = std::min(packetSize - m_pendingPacket.Data.size(), sizeof(buffer));
-        Status status = receive(buffer, sizeToGet, received);
-        if (status != Done)
-            return status;
+            if (available >= sizeof(Uint32) + packetSize)
+            {
+                if (packetSize > 0)
+                    packet.onReceive(&m_buffer[m_bufferBegin + sizeof(Uint32)], packetSize);
+
+                m_bufferBegin += sizeof(Uint32) + packetSize;
+                return Done;
+            }
 
-        // Append it into the packet
-        if (received > 0)
+            if (sizeof(Uint32) + packetSize > m_buffer.size())
+            {
+                // The packet doesn't fit in the buffer: move the data received so far to the pending packet
+                std::size_t buffered = available - sizeof(Uint32);
+                m_pendingPacket.Data.assign(&m_buffer[m_bufferBegin + sizeof(Uint32)], &m_buffer[0] + m_bufferEnd);
+                m_pendingPacket.Size     = static_cast<Uint32>(packetSize);
+                m_pendingPacket.Received = buffered;
+                m_pendingPacket.Large    = true;
+                m_bufferBegin = 0;
+                m_bufferEnd   = 0;
+                continue;
+            }
+        }
+
+        // Move the incomplete packet to the front of the buffer, and receive as much as possible after it
+        if (m_bufferBegin > 0)
         {
-            m_pendingPacket.Data.resize(m_pendingPacket.Data.size() + received);
-            char* begin = &m_pendingPacket.Data[0] + m_pendingPacket.Data.size() - received;
-            std::memcpy(begin, buffer, received);
+            std::memmove(&m_buffer[0], &m_buffer[m_bufferBegin], available);
+            m_bufferBegin = 0;
+            m_bufferEnd   = available;
         }
+
+        std::size_t received = 0;
+        Status status = receiveBytes(&m_buffer[m_bufferEnd], m_buffer.size() - m_bufferEnd, received);
+        m_bufferEnd += received;
+
+        if (status != Done)
+            return status;
     }
+}
 
-    // We have received all the packet data: we can copy it to the user packet
-    if (!m_pendingPacket.Data.empty())
-        packet.onReceive(&m_pendingPacket.Data[0], m_pendingPacket.Data.size());
 
-    // Clear the pending packet data
-    m_pendingPacket = PendingPacket();
+////////////////////////////////////////////////////////////
+bool TcpSocket::hasBufferedData() const
+{
+    // An incomplete packet is not ready: receiving it would have to wait for the rest of its data
+    std::size_t available = m_bufferEnd - m_bufferBegin;
+    if (available < sizeof(Uint32))
+        return false;
 
-    return Done;
+    Uint32 size = 0;
+    std::memcpy(&size, &m_buffer[m_bufferBegin], sizeof(size));
+
+    return available - sizeof(Uint32) >= ntohl(size);
 }
 
 
 ////////////////////////////////////////////////////////////
 TcpSocket::PendingPacket::PendingPacket() :
-Size        (0),
-SizeReceived(0),
-Data        ()
+Size    (0),
+Received(0),
+Large   (false),
+Data    ()
 {
 
 }
@@ -32,6 +32,48 @@
 #include <SFML/System/Err.hpp>
 #include <algorithm>
 
+#if defined(SFML_SYSTEM_LINUX) || (defined(SFML_SYSTEM_ANDROID) && (__ANDROID_API__ >= 21))
+    #define SFML_UDPSOCKET_MMSG
+    #include <cstring>
+#endif
+
+
+namespace
+{
+#ifdef SFML_UDPSOCKET_MMSG
+
+    // Maximum number of datagrams moved by a single call to sendmmsg or recvmmsg
+    const std::size_t maxDatagramsPerCall = 64;
+
+    // Make a message header point to the buffer and the address of a datagram
+    void setMessage(mmsghdr& message, iovec& buffer, sockaddr_in& address, void* data, std::size_t size)
+    {
+        buffer.iov_base = data;
+        buffer.iov_len  = size;
+
+        std::memset(&message, 0, sizeof(message));
+        message.msg_hdr.msg_name    = &address;
+        message.msg_hdr.msg_namelen = sizeof(address);
+        message.msg_hdr.msg_iov     = &buffer;
+        message.msg_hdr.msg_iovlen  = 1;
+    }
+
+#else
+
+    // Check whether a datagram is waiting in a socket, without blocking
+    bool hasPendingDatagram(sf::SocketHandle handle)
+    {
+        sf::priv::SocketImpl::PollDescriptor descriptor;
+        descriptor.fd      = handle;
+        descriptor.events  = sf::priv::SocketImpl::PollRead;
+        descriptor.revents = 0;
+
+        return sf::priv::SocketImpl::poll(&descriptor, 1, 0) > 0;
+    }
+
+#endif
+}
+
 
 namespace sf
 {
@@ -203,4 +245,151 @@ Socket::Status UdpSocket::receive(Packet& packet, IpAddress& remoteAddress, unsi
 }
 
 
+////////////////////////////////////////////////////////////
+Socket::Status UdpSocket::send(const Datagram* datagrams, std::size_t count, std::size_t& sent)
+{
+    sent = 0;
+
+    // Create the internal socket if it doesn't exist
+    create();
+
+    // Make sure that all the data will fit in datagrams, before sending anything
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (datagrams[i].size > MaxDatagramSize)
+        {
+            err() << "Cannot send data over the network "
+                  << "(the number of bytes to send is greater than sf::UdpSocket::MaxDatagramSize)" << std::endl;
+            return Error;
+        }
+    }
+
+#ifdef SFML_UDPSOCKET_MMSG
+
+    mmsghdr     messages[maxDatagramsPerCall];
+    iovec       buffers[maxDatagramsPerCall];
+    sockaddr_in addresses[maxDatagramsPerCall];
+
+    while (sent < count)
+    {
+        std::size_t batch = std::min(count - sent, maxDatagramsPerCall);
+        for (std::size_t i = 0; i < batch; ++i)
+        {
+            const Datagram& datagram = datagrams[sent + i];
+            addresses[i] = priv::SocketImpl::createAddress(datagram.remoteAddress.toInteger(), datagram.remotePort);
+            setMessage(messages[i], buffers[i], addresses[i], datagram.data, datagram.size);
+        }
+
+        // Send as many datagrams as possible in a single call
+        int result = sendmmsg(getHandle(), messages, static_cast<unsigned int>(batch), 0);
+        if (result < 0)
+        {
+            Status status = priv::SocketImpl::getErrorStatus();
+            return ((sent > 0) && (status == NotReady)) ? Partial : status;
+        }
+
+        sent += static_cast<std::size_t>(result);
+    }
+
+#else
+
+    // Send the datagrams one by one
+    while (sent < count)
+    {
+        const Datagram& datagram = datagrams[sent];
+        Status status = send(datagram.data, datagram.size, datagram.remoteAddress, datagram.remotePort);
+        if (status != Done)
+            return ((sent > 0) && (status == NotReady)) ? Partial : status;
+
+        ++sent;
+    }
+
+#endif
+
+    return Done;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status UdpSocket::receive(Datagram* datagrams, std::size_t count, std::size_t& received)
+{
+    // First clear the variables to fill, and check the destination buffers
+    received = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        datagrams[i].received      = 0;
+        datagrams[i].remoteAddress = IpAddress();
+        datagrams[i].remotePort    = 0;
+
+        if (!datagrams[i].data)
+        {
+            err() << "Cannot receive data from the network (the destination buffer is invalid)" << std::endl;
+            return Error;
+        }
+    }
+
+#ifdef SFML_UDPSOCKET_MMSG
+
+    mmsghdr     messages[maxDatagramsPerCall];
+    iovec       buffers[maxDatagramsPerCall];
+    sockaddr_in addresses[maxDatagramsPerCall];
+
+    // Wait for the first datagram only
+    int flags = MSG_WAITFORONE;
+
+    while (received < count)
+    {
+        std::size_t batch = std::min(count - received, maxDatagramsPerCall);
+        for (std::size_t i = 0; i < batch; ++i)
+        {
+            Datagram& datagram = datagrams[received + i];
+            addresses[i] = priv::SocketImpl::createAddress(INADDR_ANY, 0);
+            setMessage(messages[i], buffers[i], addresses[i], datagram.data, datagram.size);
+        }
+
+        // Receive as many datagrams as possible in a single call
+        int result = recvmmsg(getHandle(), messages, static_cast<unsigned int>(batch), flags, NULL);
+        if (result < 0)
+            return (received > 0) ? Done : priv::SocketImpl::getErrorStatus();
+
+        // Fill the sizes and the sender informations
+        for (std::size_t i = 0; i < static_cast<std::size_t>(result); ++i)
+        {
+            Datagram& datagram = datagrams[received + i];
+            datagram.received      = messages[i].msg_len;
+            datagram.remoteAddress = IpAddress(ntohl(addresses[i].sin_addr.s_addr));
+            datagram.remotePort    = ntohs(addresses[i].sin_port);
+        }
+
+        received += static_cast<std::size_t>(result);
+        if (static_cast<std::size_t>(result) < batch)
+            break;
+
+        // Take the next datagrams only if they are already there
+        flags = MSG_DONTWAIT;
+    }
+
+#else
+
+    // Receive the datagrams one by one
+    while (received < count)
+    {
+        // Take the next datagrams only if they are already there
+        if ((received > 0) && !hasPendingDatagram(getHandle()))
+            break;
+
+        Datagram& datagram = datagrams[received];
+        Status status = receive(datagram.data, datagram.size, datagram.received, datagram.remoteAddress, datagram.remotePort);
+        if (status != Done)
+            return (received > 0) ? Done : status;
+
+        ++received;
+    }
+
+#endif
+
+    return Done;
+}
+
+
 } // namespace sf
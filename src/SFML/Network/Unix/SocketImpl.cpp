@@ -107,6 +107,35 @@ Socket::Status SocketImpl::getErrorStatus()
     }
 }
 
+
+////////////////////////////////////////////////////////////
+void SocketImpl::setBuffer(Buffer& buffer, const void* data, std::size_t size)
+{
+    // iovec is also used for receiving, hence the non-const pointer
+    buffer.iov_base = const_cast<void*>(data);
+    buffer.iov_len  = size;
+}
+
+
+////////////////////////////////////////////////////////////
+long SocketImpl::sendBuffers(SocketHandle sock, Buffer* buffers, std::size_t count, int flags)
+{
+    // sendmsg rather than writev, to pass the flags (MSG_NOSIGNAL)
+    msghdr message;
+    std::memset(&message, 0, sizeof(message));
+    message.msg_iov    = buffers;
+    message.msg_iovlen = count;
+
+    return static_cast<long>(sendmsg(sock, &message, flags));
+}
+
+
+////////////////////////////////////////////////////////////
+int SocketImpl::poll(PollDescriptor* descriptors, std::size_t count, int timeout)
+{
+    return ::poll(descriptors, static_cast<nfds_t>(count), timeout);
+}
+
 } // namespace priv
 
 } // namespace sf
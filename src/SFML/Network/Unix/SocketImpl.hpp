@@ -31,6 +31,8 @@
 #include <SFML/Network/Socket.hpp>
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
+#include <poll.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
 #include <arpa/inet.h>
@@ -56,6 +58,18 @@ public:
     ////////////////////////////////////////////////////////////
     typedef socklen_t AddrLength;
     typedef size_t Size;
+    typedef iovec Buffer;
+    typedef pollfd PollDescriptor;
+
+    ////////////////////////////////////////////////////////////
+    // Events of a poll descriptor
+    ////////////////////////////////////////////////////////////
+    enum
+    {
+        PollRead  = POLLIN,
+        PollWrite = POLLOUT,
+        PollError = POLLERR | POLLHUP | POLLNVAL
+    };
 
     ////////////////////////////////////////////////////////////
     /// \brief Create an internal sockaddr_in address
@@ -100,6 +114,41 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     static Socket::Status getErrorStatus();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make a scatter-gather buffer point to a block of memory
+    ///
+    /// \param buffer Buffer to fill
+    /// \param data   Address of the block
+    /// \param size   Size of the block, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setBuffer(Buffer& buffer, const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send several blocks of memory in a single call
+    ///
+    /// \param sock    Handle of the socket
+    /// \param buffers Blocks to send, in order
+    /// \param count   Number of blocks
+    /// \param flags   Flags of the low-level send function
+    ///
+    /// \return Number of bytes sent, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    static long sendBuffers(SocketHandle sock, Buffer* buffers, std::size_t count, int flags);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait for events on several sockets
+    ///
+    /// \param descriptors Sockets to watch, with their requested events
+    /// \param count       Number of sockets
+    /// \param timeout     Maximum time to wait, in milliseconds (-1 for infinity)
+    ///
+    /// \return Number of sockets with events, 0 on timeout, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    static int poll(PollDescriptor* descriptors, std::size_t count, int timeout);
 };
 
 } // namespace priv
@@ -86,6 +86,43 @@ Socket::Status SocketImpl::getErrorStatus()
 }
 
 
+////////////////////////////////////////////////////////////
+void SocketImpl::setBuffer(Buffer& buffer, const void* data, std::size_t size)
+{
+    // WSABUF is also used for receiving, hence the non-const pointer
+    buffer.buf = const_cast<CHAR*>(static_cast<const CHAR*>(data));
+    buffer.len = static_cast<ULONG>(size);
+}
+
+
+////////////////////////////////////////////////////////////
+long SocketImpl::sendBuffers(SocketHandle sock, Buffer* buffers, std::size_t count, int flags)
+{
+    DWORD sent = 0;
+    if (WSASend(sock, buffers, static_cast<DWORD>(count), &sent, static_cast<DWORD>(flags), NULL, NULL) == SOCKET_ERROR)
+        return -1;
+
+    return static_cast<long>(sent);
+}
+
+
+////////////////////////////////////////////////////////////
+int SocketImpl::poll(PollDescriptor* descriptors, std::size_t count, int timeout)
+{
+    // WSAPoll is only available since Windows Vista, so it is loaded dynamically
+    typedef int (WSAAPI* WSAPollFunc)(PollDescriptor*, ULONG, INT);
+    static WSAPollFunc wsaPoll = reinterpret_cast<WSAPollFunc>(GetProcAddress(GetModuleHandleA("ws2_32.dll"), "WSAPoll"));
+
+    if (!wsaPoll)
+    {
+        WSASetLastError(WSAEOPNOTSUPP);
+        return -1;
+    }
+
+    return wsaPoll(descriptors, static_cast<ULONG>(count), timeout);
+}
+
+
 ////////////////////////////////////////////////////////////
 // Windows needs some initialization and cleanup to get
 // sockets working properly... so let's create a class that will
@@ -59,6 +59,31 @@ public:
     ////////////////////////////////////////////////////////////
     typedef int AddrLength;
     typedef int Size;
+    typedef WSABUF Buffer;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Descriptor of a socket watched by poll
+    ///
+    /// Same layout as WSAPOLLFD, which is not declared when
+    /// targeting Windows XP.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct PollDescriptor
+    {
+        SOCKET fd;      //!< Socket to watch
+        SHORT  events;  //!< Requested events
+        SHORT  revents; //!< Returned events
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Events of a poll descriptor (POLLRDNORM, POLLWRNORM, POLLERR | POLLHUP | POLLNVAL)
+    ////////////////////////////////////////////////////////////
+    enum
+    {
+        PollRead  = 0x0100,
+        PollWrite = 0x0010,
+        PollError = 0x0001 | 0x0002 | 0x0004
+    };
 
     ////////////////////////////////////////////////////////////
     /// \brief Create an internal sockaddr_in address
@@ -103,6 +128,41 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     static Socket::Status getErrorStatus();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make a scatter-gather buffer point to a block of memory
+    ///
+    /// \param buffer Buffer to fill
+    /// \param data   Address of the block
+    /// \param size   Size of the block, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setBuffer(Buffer& buffer, const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send several blocks of memory in a single call
+    ///
+    /// \param sock    Handle of the socket
+    /// \param buffers Blocks to send, in order
+    /// \param count   Number of blocks
+    /// \param flags   Flags of the low-level send function
+    ///
+    /// \return Number of bytes sent, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    static long sendBuffers(SocketHandle sock, Buffer* buffers, std::size_t count, int flags);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait for events on several sockets
+    ///
+    /// \param descriptors Sockets to watch, with their requested events
+    /// \param count       Number of sockets
+    /// \param timeout     Maximum time to wait, in milliseconds (-1 for infinity)
+    ///
+    /// \return Number of sockets with events, 0 on timeout, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    static int poll(PollDescriptor* descriptors, std::size_t count, int timeout);
 };
 
 } // namespace priv
@@ -0,0 +1,254 @@
+#include <SFML/Network.hpp>
+
+#include <catch.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Gives access to the transformations of the packet
+    class TestPacket : public sf::CompressedPacket
+    {
+    public:
+
+        using sf::CompressedPacket::onSend;
+        using sf::CompressedPacket::onReceive;
+    };
+
+    // Send the data of a packet into another one, and check that it arrives unchanged
+    void checkRoundTrip(const std::vector<char>& data)
+    {
+        TestPacket sent;
+        if (!data.empty())
+            sent.append(&data[0], data.size());
+
+        std::size_t size = 0;
+        const void* transformed = sent.onSend(size);
+        CHECK(size <= data.size() + 1);
+
+        TestPacket received;
+        received.onReceive(transformed, size);
+        REQUIRE(received);
+        REQUIRE(received.getDataSize() == data.size());
+        if (!data.empty())
+            CHECK(std::memcmp(received.getData(), &data[0], data.size()) == 0);
+    }
+}
+
+TEST_CASE("sf::CompressedPacket class", "[network]")
+{
+    SECTION("Small packets")
+    {
+        TestPacket packet;
+        packet << "small";
+
+        std::size_t size = 0;
+        packet.onSend(size);
+        CHECK(size == packet.getDataSize() + 1);
+        CHECK(packet.getStatistics().storedCount == 1);
+        CHECK(packet.getStatistics().compressedCount == 0);
+
+        checkRoundTrip(std::vector<char>());
+        checkRoundTrip(std::vector<char>(1, 'x'));
+    }
+
+    SECTION("Repetitive data")
+    {
+        std::string text;
+        for (int i = 0; i < 200; ++i)
+            text += "position 12.5 8.25, velocity 0 -1, state idle; ";
+
+        TestPacket packet;
+        packet.append(text.data(), text.size());
+
+        std::size_t size = 0;
+        const void* data = packet.onSend(size);
+        CHECK(size < text.size() / 20);
+
+        const sf::CompressedPacket::Statistics& statistics = packet.getStatistics();
+        CHECK(statistics.compressedCount == 1);
+        CHECK(statistics.storedCount == 0);
+        CHECK(statistics.originalSize == text.size());
+        CHECK(statistics.compressedSize == size);
+
+        TestPacket received;
+        received.onReceive(data, size);
+        REQUIRE(received.getDataSize() == text.size());
+        CHECK(std::string(static_cast<const char*>(received.getData()), received.getDataSize()) == text);
+    }
+
+    SECTION("Incompressible data")
+    {
+        std::srand(42);
+        std::vector<char> noise(4000);
+        for (std::size_t i = 0; i < noise.size(); ++i)
+            noise[i] = static_cast<char>(std::rand());
+
+        TestPacket packet;
+        packet.append(&noise[0], noise.size());
+
+        std::size_t size = 0;
+        packet.onSend(size);
+        CHECK(size == noise.size() + 1);
+        CHECK(packet.getStatistics().storedCount == 1);
+
+        checkRoundTrip(noise);
+    }
+
+    SECTION("Threshold")
+    {
+        TestPacket packet;
+        packet.append(std::string(100, 'a').data(), 100);
+
+        std::size_t size = 0;
+        packet.onSend(size);
+        CHECK(size == 101);
+
+        packet.setThreshold(50);
+        CHECK(packet.getThreshold() == 50);
+        packet.onSend(size);
+        CHECK(size < 20);
+
+        CHECK(packet.getStatistics().storedCount == 1);
+        CHECK(packet.getStatistics().compressedCount == 1);
+        packet.resetStatistics();
+        CHECK(packet.getStatistics().storedCount == 0);
+        CHECK(packet.getStatistics().compressedCount == 0);
+    }
+
+    SECTION("Various sizes and patterns")
+    {
+        // Runs, repeated words, long matches and literals, far and overlapping matches
+        std::srand(7);
+        for (std::size_t size = 0; size < 3000; size += 1 + size / 8)
+        {
+            for (int pattern = 0; pattern < 4; ++pattern)
+            {
+                std::vector<char> data(size);
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    switch (pattern)
+                    {
+                        case 0:  data[i] = static_cast<char>(i / 300); break;
+                        case 1:  data[i] = "abcdefg"[(i * i) % 7]; break;
+                        case 2:  data[i] = (std::rand() % 8 == 0) ? static_cast<char>(std::rand()) : 'z'; break;
+                        default: data[i] = static_cast<char>((i % 1000 < 500) ? std::rand() : data[i - 500]); break;
+                    }
+                }
+                checkRoundTrip(data);
+            }
+        }
+
+        // Matches farther than 64 KB can't be used
+        std::vector<char> block(70000);
+        for (std::size_t i = 0; i < block.size(); ++i)
+            block[i] = static_cast<char>((i < 1000) || (i > 69000) ? i % 251 : static_cast<std::size_t>(std::rand()));
+        checkRoundTrip(block);
+    }
+
+    SECTION("Corrupted data")
+    {
+        TestPacket packet;
+        packet.onReceive("\x07" "abc", 4);
+        CHECK_FALSE(packet);
+        CHECK(packet.getDataSize() == 0);
+
+        // Original size much larger than possible
+        TestPacket huge;
+        huge.onReceive("\x01\x7F\xFF\xFF\xFF\x00", 6);
+        CHECK_FALSE(huge);
+        CHECK(huge.getDataSize() == 0);
+
+        // Truncated compressed data
+        std::string text(1000, 'q');
+        TestPacket sent;
+        sent.append(text.data(), text.size());
+        std::size_t size = 0;
+        const void* data = sent.onSend(size);
+
+        TestPacket truncated;
+        truncated.onReceive(data, size - 1);
+        CHECK_FALSE(truncated);
+    }
+
+    SECTION("Over TCP")
+    {
+        sf::TcpListener listener;
+        REQUIRE(listener.listen(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Done);
+
+        sf::TcpSocket client;
+        REQUIRE(client.connect(sf::IpAddress::LocalHost, listener.getLocalPort()) == sf::Socket::Done);
+        sf::TcpSocket server;
+        REQUIRE(listener.accept(server) == sf::Socket::Done);
+
+        sf::CompressedPacket sent;
+        for (sf::Uint32 i = 0; i < 1000; ++i)
+            sent << i % 10 << std::string("state");
+        REQUIRE(client.send(sent) == sf::Socket::Done);
+        CHECK(sent.getStatistics().compressedSize < sent.getStatistics().originalSize / 4);
+
+        sf::CompressedPacket received;
+        REQUIRE(server.receive(received) == sf::Socket::Done);
+        REQUIRE(received.getDataSize() == sent.getDataSize());
+
+        bool same = true;
+        for (sf::Uint32 i = 0; i < 1000; ++i)
+        {
+            sf::Uint32 value = 0;
+            std::string state;
+            received >> value >> state;
+            same = same && (value == i % 10) && (state == "state");
+        }
+        CHECK(same);
+        CHECK(received.endOfPacket());
+    }
+
+    SECTION("Partial sends")
+    {
+        sf::TcpListener listener;
+        REQUIRE(listener.listen(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Done);
+
+        sf::TcpSocket client;
+        REQUIRE(client.connect(sf::IpAddress::LocalHost, listener.getLocalPort()) == sf::Socket::Done);
+        sf::TcpSocket server;
+        REQUIRE(listener.accept(server) == sf::Socket::Done);
+        client.setBlocking(false);
+        server.setBlocking(false);
+
+        // Large enough to fill the socket buffers, and compressible
+        std::srand(3);
+        std::vector<char> data(8000000);
+        for (std::size_t i = 0; i < data.size(); ++i)
+            data[i] = "ab"[std::rand() % 2];
+
+        sf::CompressedPacket sent;
+        sent.append(&data[0], data.size());
+
+        // A packet which is resumed is compressed and counted once
+        bool done = false;
+        bool partial = false;
+        sf::CompressedPacket received;
+        sf::Socket::Status status = sf::Socket::NotReady;
+        while (status != sf::Socket::Done)
+        {
+            if (!done)
+            {
+                sf::Socket::Status sendStatus = client.send(sent);
+                REQUIRE(((sendStatus == sf::Socket::Done) || (sendStatus == sf::Socket::Partial) || (sendStatus == sf::Socket::NotReady)));
+                partial = partial || (sendStatus == sf::Socket::Partial);
+                done = (sendStatus == sf::Socket::Done);
+            }
+
+            status = server.receive(received);
+            REQUIRE(((status == sf::Socket::Done) || (status == sf::Socket::NotReady) || (status == sf::Socket::Partial)));
+        }
+
+        CHECK(partial);
+        CHECK(sent.getStatistics().compressedCount == 1);
+        CHECK(sent.getStatistics().originalSize == data.size());
+        REQUIRE(received.getDataSize() == data.size());
+        CHECK(std::memcmp(received.getData(), &data[0], data.size()) == 0);
+    }
+}
@@ -0,0 +1,221 @@
+#include <SFML/Network.hpp>
+
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Sleep.hpp>
+#include <SFML/System/Thread.hpp>
+#include <catch.hpp>
+#include <ctime>
+
+namespace
+{
+    class EchoReactor : public sf::NetworkReactor
+    {
+    public:
+
+        EchoReactor() :
+        sf::NetworkReactor(2),
+        accepted    (0),
+        disconnected(0),
+        sent        (0),
+        datagrams   (0)
+        {
+        }
+
+        unsigned int get(const unsigned int& counter)
+        {
+            sf::Lock lock(mutex);
+            return counter;
+        }
+
+        unsigned int accepted;
+        unsigned int disconnected;
+        unsigned int sent;
+        unsigned int datagrams;
+
+    private:
+
+        virtual void onAccept(sf::TcpListener&, sf::TcpSocket&)
+        {
+            sf::Lock lock(mutex);
+            ++accepted;
+        }
+
+        virtual void onReceive(sf::TcpSocket& socket, sf::Packet& packet)
+        {
+            send(socket, packet);
+        }
+
+        virtual void onReceiveFrom(sf::UdpSocket& socket, sf::Packet& packet, const sf::IpAddress& sender, unsigned short port)
+        {
+            {
+                sf::Lock lock(mutex);
+                ++datagrams;
+            }
+
+            socket.send(packet, sender, port);
+        }
+
+        virtual void onSent(sf::TcpSocket&)
+        {
+            sf::Lock lock(mutex);
+            ++sent;
+        }
+
+        virtual void onDisconnect(sf::TcpSocket&)
+        {
+            sf::Lock lock(mutex);
+            ++disconnected;
+        }
+
+        sf::Mutex mutex;
+    };
+
+    bool waitFor(EchoReactor& reactor, const unsigned int& counter, unsigned int value)
+    {
+        for (int i = 0; (i < 500) && (reactor.get(counter) < value); ++i)
+            sf::sleep(sf::milliseconds(10));
+
+        return reactor.get(counter) >= value;
+    }
+}
+
+TEST_CASE("sf::NetworkReactor class", "[network]")
+{
+    EchoReactor reactor;
+    CHECK(reactor.getThreadCount() == 2);
+
+    sf::TcpListener listener;
+    REQUIRE(listener.listen(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Done);
+    REQUIRE(reactor.add(listener));
+    CHECK(!reactor.add(listener));
+
+    sf::TcpSocket unconnected;
+    sf::Packet empty;
+    CHECK(!reactor.add(unconnected));
+    CHECK(!reactor.send(unconnected, empty));
+
+    // Sockets added to the reactor must outlive its run
+    sf::UdpSocket server;
+    REQUIRE(server.bind(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Done);
+
+    sf::Thread thread(&sf::NetworkReactor::run, static_cast<sf::NetworkReactor*>(&reactor));
+    thread.launch();
+
+    SECTION("TCP echo")
+    {
+        const unsigned int clientCount = 4;
+        const unsigned int packetCount = 100;
+
+        sf::TcpSocket clients[clientCount];
+        for (unsigned int i = 0; i < clientCount; ++i)
+            REQUIRE(clients[i].connect(sf::IpAddress::LocalHost, listener.getLocalPort()) == sf::Socket::Done);
+
+        CHECK(waitFor(reactor, reactor.accepted, clientCount));
+
+        for (unsigned int i = 0; i < clientCount; ++i)
+        {
+            for (sf::Uint32 j = 0; j < packetCount; ++j)
+            {
+                sf::Packet packet;
+                packet << i << j;
+                REQUIRE(clients[i].send(packet) == sf::Socket::Done);
+            }
+        }
+
+        bool ordered = true;
+        for (unsigned int i = 0; i < clientCount; ++i)
+        {
+            for (sf::Uint32 j = 0; j < packetCount; ++j)
+            {
+                sf::Packet packet;
+                REQUIRE(clients[i].receive(packet) == sf::Socket::Done);
+
+                sf::Uint32 client = 0;
+                sf::Uint32 index = 0;
+                packet >> client >> index;
+                ordered = ordered && (client == i) && (index == j);
+            }
+        }
+
+        CHECK(ordered);
+        CHECK(reactor.get(reactor.sent) >= 1);
+
+        for (unsigned int i = 0; i < clientCount; ++i)
+            clients[i].disconnect();
+
+        CHECK(waitFor(reactor, reactor.disconnected, clientCount));
+    }
+
+    SECTION("Packet split across two writes")
+    {
+        sf::TcpSocket client;
+        REQUIRE(client.connect(sf::IpAddress::LocalHost, listener.getLocalPort()) == sf::Socket::Done);
+        CHECK(waitFor(reactor, reactor.accepted, 1));
+
+        // Header of a packet holding a 32-bits integer, followed by its data
+        const char data[] = {0, 0, 0, 4, 0, 0, 0, 42};
+        REQUIRE(client.send(data, 2) == sf::Socket::Done);
+        sf::sleep(sf::milliseconds(50));
+
+        // The incomplete packet buffered by the reactor must not keep its workers busy
+        std::clock_t start = std::clock();
+        sf::sleep(sf::milliseconds(200));
+        CHECK(std::clock() - start < CLOCKS_PER_SEC / 20);
+
+        REQUIRE(client.send(data + 2, sizeof(data) - 2) == sf::Socket::Done);
+
+        sf::Packet packet;
+        REQUIRE(client.receive(packet) == sf::Socket::Done);
+        sf::Uint32 value = 0;
+        packet >> value;
+        CHECK(value == 42);
+
+        client.disconnect();
+        CHECK(waitFor(reactor, reactor.disconnected, 1));
+    }
+
+    SECTION("Removed socket")
+    {
+        // Use a listener outside of the reactor, which would accept the connection itself
+        sf::TcpListener other;
+        REQUIRE(other.listen(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Done);
+
+        sf::TcpSocket client;
+        REQUIRE(client.connect(sf::IpAddress::LocalHost, other.getLocalPort()) == sf::Socket::Done);
+
+        sf::TcpSocket accepted;
+        REQUIRE(other.accept(accepted) == sf::Socket::Done);
+        REQUIRE(reactor.add(accepted));
+
+        reactor.remove(accepted);
+        CHECK(waitFor(reactor, reactor.disconnected, 1));
+        CHECK(reactor.get(reactor.accepted) == 0);
+        CHECK(!reactor.send(accepted, empty));
+    }
+
+    SECTION("UDP echo")
+    {
+        REQUIRE(reactor.add(server));
+
+        sf::UdpSocket client;
+        REQUIRE(client.bind(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Done);
+
+        sf::Packet packet;
+        packet << sf::Uint32(42);
+        REQUIRE(client.send(packet, sf::IpAddress::LocalHost, server.getLocalPort()) == sf::Socket::Done);
+
+        sf::Packet received;
+        sf::IpAddress sender;
+        unsigned short port = 0;
+        REQUIRE(client.receive(received, sender, port) == sf::Socket::Done);
+
+        sf::Uint32 value = 0;
+        received >> value;
+        CHECK(value == 42);
+        CHECK(port == server.getLocalPort());
+        CHECK(reactor.get(reactor.datagrams) == 1);
+    }
+
+    reactor.stop();
+    thread.wait();
+}
@@ -0,0 +1,175 @@
+#include <SFML/Network.hpp>
+
+#include <catch.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+
+// Count the allocations of the whole program, to check that packets don't allocate
+// (all the forms of operator new and delete that the compiler may call must be replaced together)
+#if __cplusplus >= 201103L
+    #define NEW_THROW_SPEC
+    #define DELETE_THROW_SPEC noexcept
+#else
+    #define NEW_THROW_SPEC throw(std::bad_alloc)
+    #define DELETE_THROW_SPEC throw()
+#endif
+
+// Only enabled while no other thread runs
+static bool countAllocations = false;
+static std::size_t allocationCount = 0;
+
+void* operator new(std::size_t size) NEW_THROW_SPEC
+{
+    if (countAllocations)
+        ++allocationCount;
+
+    void* memory = std::malloc(size ? size : 1);
+    if (!memory)
+        throw std::bad_alloc();
+    return memory;
+}
+
+void operator delete(void* memory) DELETE_THROW_SPEC
+{
+    std::free(memory);
+}
+
+#if __cplusplus >= 201402L
+void operator delete(void* memory, std::size_t) DELETE_THROW_SPEC
+{
+    std::free(memory);
+}
+#endif
+
+TEST_CASE("sf::PacketPool class", "[network]")
+{
+    std::vector<char> payload(3000, 'x');
+
+    SECTION("Block sizes")
+    {
+        sf::PacketPool pool;
+
+        std::size_t size = 1;
+        void* block = pool.allocate(size);
+        CHECK(block != NULL);
+        CHECK(size == 512);
+        pool.deallocate(block, size);
+
+        size = 513;
+        block = pool.allocate(size);
+        CHECK(size == 1024);
+        pool.deallocate(block, size);
+
+        size = 65536;
+        block = pool.allocate(size);
+        CHECK(size == 65536);
+        pool.deallocate(block, size);
+
+        size = 65537;
+        CHECK(pool.allocate(size) == NULL);
+        CHECK(size == 65537);
+
+        CHECK(pool.getCachedSize() == 512 + 1024 + 65536);
+        pool.clear();
+        CHECK(pool.getCachedSize() == 0);
+    }
+
+    SECTION("Packet storage")
+    {
+        sf::Packet packet;
+        CHECK(packet.getCapacity() == 256);
+
+        packet.reserve(1000);
+        CHECK(packet.getCapacity() >= 1000);
+
+        packet.append(&payload[0], payload.size());
+        packet.reset();
+        CHECK(packet.getDataSize() == 0);
+        CHECK(packet.getCapacity() >= payload.size());
+
+        sf::PacketPool pool;
+        sf::Packet pooled(pool);
+        pooled.append(&payload[0], payload.size());
+        CHECK(pooled.getCapacity() == 4096);
+
+        sf::Packet copy(pooled);
+        CHECK(copy.getDataSize() == payload.size());
+        CHECK(std::memcmp(copy.getData(), &payload[0], payload.size()) == 0);
+
+        packet = pooled;
+        CHECK(packet.getDataSize() == payload.size());
+    }
+
+    SECTION("No allocation per message")
+    {
+        sf::PacketPool pool;
+        sf::Packet reused;
+
+        // Warm up the pool and the reused packet
+        {
+            sf::Packet pooled(pool);
+            pooled.append(&payload[0], payload.size());
+            reused.append(&payload[0], payload.size());
+        }
+
+        countAllocations = true;
+        std::size_t allocations = allocationCount;
+        for (int i = 0; i < 100; ++i)
+        {
+            // Small packets are stored inline
+            sf::Packet small;
+            small << sf::Uint32(i) << "small message";
+
+            // Larger ones reuse the storage of a pool
+            sf::Packet pooled(pool);
+            pooled.append(&payload[0], payload.size());
+
+            // Or of a packet kept from a message to the next
+            reused.reset();
+            reused.append(&payload[0], payload.size());
+        }
+
+        countAllocations = false;
+        CHECK(allocationCount == allocations);
+    }
+
+    SECTION("No allocation per TCP message")
+    {
+        sf::TcpListener listener;
+        REQUIRE(listener.listen(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Done);
+
+        sf::TcpSocket client;
+        sf::TcpSocket server;
+        REQUIRE(client.connect(sf::IpAddress::LocalHost, listener.getLocalPort()) == sf::Socket::Done);
+        REQUIRE(listener.accept(server) == sf::Socket::Done);
+
+        sf::Packet sent;
+        sf::Packet received;
+        sf::Socket::Status status = sf::Socket::Done;
+        std::size_t allocations = 0;
+        for (int i = 0; (i < 110) && (status == sf::Socket::Done); ++i)
+        {
+            // Start counting once the socket buffers and the packets are allocated
+            if (i == 10)
+            {
+                countAllocations = true;
+                allocations = allocationCount;
+            }
+
+            sent.reset();
+            sent << sf::Uint32(i);
+            sent.append(&payload[0], payload.size());
+
+            status = client.send(sent);
+            if (status == sf::Socket::Done)
+                status = server.receive(received);
+        }
+
+        countAllocations = false;
+        CHECK(allocationCount == allocations);
+        REQUIRE(status == sf::Socket::Done);
+        CHECK(received.getDataSize() == sizeof(sf::Uint32) + payload.size());
+    }
+}
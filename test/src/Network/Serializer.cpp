@@ -0,0 +1,228 @@
+#include <SFML/Network.hpp>
+
+#include <catch.hpp>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct Point
+    {
+        sf::Uint32 x;
+        sf::Int16  y;
+    };
+
+    struct Player
+    {
+        bool                    alive;
+        sf::Uint32              id;
+        sf::Int32               delta;
+        sf::Int64               balance;
+        double                  ratio;
+        std::string             tag;
+        sf::String              name;
+        float                   position[3];
+        std::vector<sf::Uint16> items;
+        std::vector<Point>      path;
+    };
+
+    struct Counter
+    {
+        sf::Uint32 unsignedValue;
+        sf::Int32  signedValue;
+        sf::Int32  zigzagValue;
+    };
+
+    struct Text
+    {
+        sf::String utf8;
+        sf::String utf32;
+    };
+}
+
+SFML_SERIALIZER_BEGIN(Point)
+    SFML_SERIALIZER_FIELD(x)
+    SFML_SERIALIZER_FIELD(y)
+SFML_SERIALIZER_END()
+
+SFML_SERIALIZER_BEGIN(Player)
+    SFML_SERIALIZER_FIELD(alive)
+    SFML_SERIALIZER_FIELD_AS(id, sf::Encoding::Varint)
+    SFML_SERIALIZER_FIELD_AS(delta, sf::Encoding::Zigzag)
+    SFML_SERIALIZER_FIELD(balance)
+    SFML_SERIALIZER_FIELD(ratio)
+    SFML_SERIALIZER_FIELD(tag)
+    SFML_SERIALIZER_FIELD(name)
+    SFML_SERIALIZER_FIELD(position)
+    SFML_SERIALIZER_FIELD_AS(items, sf::Encoding::Varint)
+    SFML_SERIALIZER_FIELD(path)
+SFML_SERIALIZER_END()
+
+SFML_SERIALIZER_BEGIN(Counter)
+    SFML_SERIALIZER_FIELD_AS(unsignedValue, sf::Encoding::Varint)
+    SFML_SERIALIZER_FIELD_AS(signedValue, sf::Encoding::Varint)
+    SFML_SERIALIZER_FIELD_AS(zigzagValue, sf::Encoding::Zigzag)
+SFML_SERIALIZER_END()
+
+SFML_SERIALIZER_BEGIN(Text)
+    SFML_SERIALIZER_FIELD_AS(utf8, sf::Encoding::Utf8)
+    SFML_SERIALIZER_FIELD_AS(utf32, sf::Encoding::Fixed)
+SFML_SERIALIZER_END()
+
+TEST_CASE("sf::Serializer class template", "[network]")
+{
+    SECTION("Fixed encoding")
+    {
+        // Numbers are written like with the operators of sf::Packet
+        Point point = {0x01020304, -2};
+
+        sf::Packet serialized;
+        sf::Serializer<Point>::write(serialized, point);
+
+        sf::Packet streamed;
+        streamed << point.x << point.y;
+
+        CHECK(sf::Serializer<Point>::getSize(point) == 6);
+        REQUIRE(serialized.getDataSize() == streamed.getDataSize());
+        CHECK(std::memcmp(serialized.getData(), streamed.getData(), streamed.getDataSize()) == 0);
+
+        Point result = {0, 0};
+        CHECK(sf::Serializer<Point>::read(serialized, result));
+        CHECK(result.x == point.x);
+        CHECK(result.y == point.y);
+        CHECK(serialized.endOfPacket());
+    }
+
+    SECTION("Varint and zigzag encodings")
+    {
+        Counter small = {1, 1, 1};
+        CHECK(sf::Serializer<Counter>::getSize(small) == 3);
+
+        Counter medium = {300, 300, -300};
+        CHECK(sf::Serializer<Counter>::getSize(medium) == 6);
+
+        // Negative values need a zigzag encoding to stay short
+        Counter negative = {0xFFFFFFFF, -1, -1};
+        CHECK(sf::Serializer<Counter>::getSize(negative) == 5 + 10 + 1);
+
+        sf::Packet packet;
+        sf::Serializer<Counter>::write(packet, medium);
+        sf::Serializer<Counter>::write(packet, negative);
+        CHECK(packet.getDataSize() == 6 + 16);
+
+        const unsigned char* data = static_cast<const unsigned char*>(packet.getData());
+        CHECK(data[0] == 0xAC);
+        CHECK(data[1] == 0x02);
+        CHECK(data[4] == 0xD7);
+        CHECK(data[5] == 0x04);
+
+        Counter first = {0, 0, 0};
+        Counter second = {0, 0, 0};
+        CHECK(sf::Serializer<Counter>::read(packet, first));
+        CHECK(sf::Serializer<Counter>::read(packet, second));
+        CHECK(first.unsignedValue == 300);
+        CHECK(first.signedValue == 300);
+        CHECK(first.zigzagValue == -300);
+        CHECK(second.unsignedValue == 0xFFFFFFFF);
+        CHECK(second.signedValue == -1);
+        CHECK(second.zigzagValue == -1);
+        CHECK(packet.endOfPacket());
+    }
+
+    SECTION("String encodings")
+    {
+        Text text;
+        text.utf8 = sf::String::fromUtf8("a\xC3\xA9\xE2\x82\xAC", "a\xC3\xA9\xE2\x82\xAC" + 6);
+        text.utf32 = text.utf8;
+        REQUIRE(text.utf8.getSize() == 3);
+
+        // UTF-8: length and 6 bytes, UTF-32: length and 12 bytes
+        CHECK(sf::Serializer<Text>::getSize(text) == 1 + 6 + 1 + 12);
+
+        sf::Packet packet;
+        sf::Serializer<Text>::write(packet, text);
+        CHECK(std::memcmp(packet.getData(), "\x06" "a\xC3\xA9\xE2\x82\xAC", 7) == 0);
+
+        Text result;
+        CHECK(sf::Serializer<Text>::read(packet, result));
+        CHECK(result.utf8 == text.utf8);
+        CHECK(result.utf32 == text.utf32);
+    }
+
+    SECTION("Nested objects and arrays")
+    {
+        Player player;
+        player.alive = true;
+        player.id = 42;
+        player.delta = -7;
+        player.balance = -1234567890123LL;
+        player.ratio = 0.25;
+        player.tag = "tag";
+        player.name = "Player";
+        player.position[0] = 1.5f;
+        player.position[1] = -2.f;
+        player.position[2] = 1000.f;
+        for (sf::Uint16 i = 0; i < 100; ++i)
+            player.items.push_back(static_cast<sf::Uint16>(i * 3));
+        for (sf::Uint32 i = 0; i < 10; ++i)
+        {
+            Point point = {i, static_cast<sf::Int16>(-static_cast<int>(i))};
+            player.path.push_back(point);
+        }
+
+        sf::Packet packet;
+        packet << sf::Uint8(7);
+        sf::Serializer<Player>::write(packet, player);
+        CHECK(packet.getDataSize() == 1 + sf::Serializer<Player>::getSize(player));
+
+        sf::Uint8 header = 0;
+        Player result;
+        packet >> header;
+        CHECK(header == 7);
+        REQUIRE(sf::Serializer<Player>::read(packet, result));
+        CHECK(packet.endOfPacket());
+
+        CHECK(result.alive);
+        CHECK(result.id == player.id);
+        CHECK(result.delta == player.delta);
+        CHECK(result.balance == player.balance);
+        CHECK(result.ratio == player.ratio);
+        CHECK(result.tag == player.tag);
+        CHECK(result.name == player.name);
+        CHECK(result.position[0] == player.position[0]);
+        CHECK(result.position[1] == player.position[1]);
+        CHECK(result.position[2] == player.position[2]);
+        CHECK(result.items == player.items);
+        REQUIRE(result.path.size() == player.path.size());
+        for (std::size_t i = 0; i < player.path.size(); ++i)
+        {
+            CHECK(result.path[i].x == player.path[i].x);
+            CHECK(result.path[i].y == player.path[i].y);
+        }
+    }
+
+    SECTION("Truncated data")
+    {
+        Text text;
+        text.utf8 = "text";
+        text.utf32 = "text";
+
+        sf::Packet packet;
+        sf::Serializer<Text>::write(packet, text);
+
+        sf::Packet truncated;
+        truncated.append(packet.getData(), packet.getDataSize() - 1);
+
+        Text result;
+        CHECK_FALSE(sf::Serializer<Text>::read(truncated, result));
+        CHECK_FALSE(truncated);
+
+        // A huge count must not be trusted
+        sf::Packet corrupted;
+        corrupted.append("\xFF\xFF\xFF\xFF\x0F", 5);
+
+        Player player;
+        CHECK_FALSE(sf::Serializer<Player>::read(corrupted, player));
+    }
+}
@@ -0,0 +1,139 @@
+#include <SFML/Network.hpp>
+
+#include <catch.hpp>
+
+TEST_CASE("sf::SocketPoller class", "[network]")
+{
+    sf::TcpListener listener;
+    REQUIRE(listener.listen(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Done);
+
+    sf::SocketPoller poller;
+    int listenerData = 0;
+    REQUIRE(poller.add(listener, sf::SocketPoller::Read, &listenerData));
+    CHECK(poller.getSocketCount() == 1);
+
+    SECTION("Registration")
+    {
+        CHECK(!poller.add(listener));
+
+        sf::TcpSocket invalid;
+        CHECK(!poller.add(invalid));
+        CHECK(!poller.modify(invalid, sf::SocketPoller::Read));
+
+        poller.remove(listener);
+        CHECK(poller.getSocketCount() == 0);
+
+        poller.add(listener);
+        poller.clear();
+        CHECK(poller.getSocketCount() == 0);
+    }
+
+    SECTION("Timeout")
+    {
+        CHECK(poller.wait(sf::milliseconds(10)) == 0);
+    }
+
+    SECTION("Buffered packets")
+    {
+        sf::TcpSocket client;
+        REQUIRE(client.connect(sf::IpAddress::LocalHost, listener.getLocalPort()) == sf::Socket::Done);
+
+        sf::TcpSocket server;
+        REQUIRE(listener.accept(server) == sf::Socket::Done);
+        poller.remove(listener);
+        REQUIRE(poller.add(server));
+
+        sf::Packet packets[2];
+        packets[0] << sf::Uint32(1);
+        packets[1] << sf::Uint32(2);
+        REQUIRE(client.send(packets, 2) == sf::Socket::Done);
+
+        // Both packets are received at once, the second one stays buffered in the socket
+        for (sf::Uint32 i = 1; i <= 2; ++i)
+        {
+            REQUIRE(poller.wait(sf::seconds(5)) == 1);
+            CHECK(poller.getReadySocket(0).socket == &server);
+
+            sf::Packet packet;
+            REQUIRE(server.receive(packet) == sf::Socket::Done);
+
+            sf::Uint32 value = 0;
+            packet >> value;
+            CHECK(value == i);
+        }
+
+        CHECK(poller.wait(sf::milliseconds(10)) == 0);
+    }
+
+    SECTION("Ready sockets")
+    {
+        sf::TcpSocket client;
+        REQUIRE(client.connect(sf::IpAddress::LocalHost, listener.getLocalPort()) == sf::Socket::Done);
+
+        // Only the listener is ready, with its user data
+        REQUIRE(poller.wait(sf::seconds(5)) == 1);
+        CHECK(poller.getReadySocket(0).socket == &listener);
+        CHECK(poller.getReadySocket(0).events == sf::SocketPoller::Read);
+        CHECK(poller.getReadySocket(0).userData == &listenerData);
+
+        sf::TcpSocket server;
+        REQUIRE(listener.accept(server) == sf::Socket::Done);
+
+        int serverData = 0;
+        int clientData = 0;
+        REQUIRE(poller.add(server, sf::SocketPoller::Read, &serverData));
+        REQUIRE(poller.add(client, sf::SocketPoller::Write, &clientData));
+
+        // The client can send, nothing else is ready
+        REQUIRE(poller.wait(sf::seconds(5)) == 1);
+        CHECK(poller.getReadySocket(0).socket == &client);
+        CHECK(poller.getReadySocket(0).events == sf::SocketPoller::Write);
+        CHECK(poller.getReadySocket(0).userData == &clientData);
+
+        // Once it has sent data, the server can receive
+        REQUIRE(poller.modify(client, sf::SocketPoller::Read, &clientData));
+        const char data[] = "data";
+        REQUIRE(client.send(data, sizeof(data)) == sf::Socket::Done);
+
+        REQUIRE(poller.wait(sf::seconds(5)) == 1);
+        CHECK(poller.getReadySocket(0).socket == &server);
+        CHECK(poller.getReadySocket(0).events == sf::SocketPoller::Read);
+        CHECK(poller.getReadySocket(0).userData == &serverData);
+
+        // Removing a reported socket clears its entry
+        poller.remove(server);
+        CHECK(poller.getReadySocket(0).socket == NULL);
+        CHECK(poller.getReadySocket(0).events == 0);
+        CHECK(poller.wait(sf::milliseconds(10)) == 0);
+
+        SECTION("Disconnection")
+        {
+            REQUIRE(poller.add(server, sf::SocketPoller::Read, &serverData));
+            poller.remove(client);
+            client.disconnect();
+
+            // The data is still to be received, then the disconnection is reported
+            REQUIRE(poller.wait(sf::seconds(5)) >= 1);
+            CHECK(poller.getReadySocket(0).socket == &server);
+            CHECK((poller.getReadySocket(0).events & sf::SocketPoller::Read) != 0);
+        }
+
+        SECTION("Edge-triggered")
+        {
+            if (sf::SocketPoller::isEdgeTriggeredSupported())
+            {
+                server.setBlocking(false);
+                REQUIRE(poller.add(server, sf::SocketPoller::Read, &serverData, sf::SocketPoller::EdgeTriggered));
+
+                // The pending data is reported once, until new data arrives
+                REQUIRE(poller.wait(sf::seconds(5)) == 1);
+                CHECK(poller.getReadySocket(0).socket == &server);
+                CHECK(poller.wait(sf::milliseconds(10)) == 0);
+
+                REQUIRE(client.send(data, sizeof(data)) == sf::Socket::Done);
+                REQUIRE(poller.wait(sf::seconds(5)) == 1);
+                CHECK(poller.getReadySocket(0).socket == &server);
+            }
+        }
+    }
+}
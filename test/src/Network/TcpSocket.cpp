@@ -0,0 +1,227 @@
+#include <SFML/Network.hpp>
+
+#include <catch.hpp>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static sf::Packet makePacket(sf::Uint32 id, std::size_t size)
+{
+    sf::Packet packet;
+    packet << id;
+    for (std::size_t i = 0; i < size; ++i)
+        packet << static_cast<sf::Uint8>(id + i);
+    return packet;
+}
+
+static void checkPacket(sf::Packet& packet, sf::Uint32 id, std::size_t size)
+{
+    REQUIRE(packet.getDataSize() == sizeof(sf::Uint32) + size);
+
+    sf::Uint32 receivedId = 0;
+    packet >> receivedId;
+    CHECK(receivedId == id);
+
+    bool same = true;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        sf::Uint8 value = 0;
+        packet >> value;
+        same = same && (value == static_cast<sf::Uint8>(id + i));
+    }
+    CHECK(same);
+    CHECK(packet.endOfPacket());
+}
+
+TEST_CASE("sf::TcpSocket class", "[network]")
+{
+    sf::TcpListener listener;
+    REQUIRE(listener.listen(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Done);
+
+    sf::TcpSocket client;
+    sf::TcpSocket server;
+    REQUIRE(client.connect(sf::IpAddress::LocalHost, listener.getLocalPort()) == sf::Socket::Done);
+    REQUIRE(listener.accept(server) == sf::Socket::Done);
+
+    SECTION("Framed packets")
+    {
+        SECTION("Single packet")
+        {
+            sf::Packet packet = makePacket(1, 100);
+            REQUIRE(client.send(packet) == sf::Socket::Done);
+
+            sf::Packet received;
+            REQUIRE(server.receive(received) == sf::Socket::Done);
+            checkPacket(received, 1, 100);
+        }
+
+        SECTION("Empty packet")
+        {
+            sf::Packet packet;
+            REQUIRE(client.send(packet) == sf::Socket::Done);
+
+            sf::Packet received;
+            REQUIRE(server.receive(received) == sf::Socket::Done);
+            CHECK(received.getDataSize() == 0);
+        }
+
+        SECTION("Batch of packets")
+        {
+            std::vector<sf::Packet> packets;
+            for (sf::Uint32 i = 0; i < 200; ++i)
+                packets.push_back(makePacket(i, i * 3));
+
+            REQUIRE(client.send(&packets[0], packets.size()) == sf::Socket::Done);
+
+            for (sf::Uint32 i = 0; i < 200; ++i)
+            {
+                sf::Packet received;
+                REQUIRE(server.receive(received) == sf::Socket::Done);
+                checkPacket(received, i, i * 3);
+            }
+        }
+
+        SECTION("Partial sends")
+        {
+            client.setBlocking(false);
+            server.setBlocking(false);
+
+            std::vector<sf::Packet> packets;
+            for (sf::Uint32 i = 0; i < 8; ++i)
+                packets.push_back(makePacket(i, 1000000 + i));
+
+            // Send and receive alternately, so that the send buffer fills up
+            bool sent = false;
+            bool partial = false;
+            sf::Uint32 receivedCount = 0;
+            while (receivedCount < packets.size())
+            {
+                if (!sent)
+                {
+                    sf::Socket::Status status = client.send(&packets[0], packets.size());
+                    REQUIRE(((status == sf::Socket::Done) || (status == sf::Socket::Partial) || (status == sf::Socket::NotReady)));
+                    partial = partial || (status == sf::Socket::Partial);
+                    sent = (status == sf::Socket::Done);
+                }
+
+                sf::Packet received;
+                sf::Socket::Status status = server.receive(received);
+                if (status == sf::Socket::Done)
+                {
+                    checkPacket(received, receivedCount, 1000000 + receivedCount);
+                    ++receivedCount;
+                }
+                else
+                {
+                    REQUIRE(((status == sf::Socket::NotReady) || (status == sf::Socket::Partial)));
+                }
+            }
+
+            CHECK(sent);
+            CHECK(partial);
+        }
+
+        SECTION("Buffered packets with a selector")
+        {
+            sf::Packet packets[2];
+            packets[0] = makePacket(1, 10);
+            packets[1] = makePacket(2, 10);
+            REQUIRE(client.send(packets, 2) == sf::Socket::Done);
+
+            sf::SocketSelector selector;
+            selector.add(server);
+
+            // The second packet is buffered by the socket, the selector must still report it
+            for (sf::Uint32 i = 1; i <= 2; ++i)
+            {
+                REQUIRE(selector.wait(sf::seconds(5)));
+                REQUIRE(selector.isReady(server));
+
+                sf::Packet received;
+                REQUIRE(server.receive(received) == sf::Socket::Done);
+                checkPacket(received, i, 10);
+            }
+
+            CHECK(!selector.wait(sf::milliseconds(10)));
+        }
+
+        SECTION("Split packet with a selector")
+        {
+            server.setBlocking(false);
+
+            // A complete packet followed by the beginning of the header of the next one
+            sf::Packet first = makePacket(1, 10);
+            sf::Packet second = makePacket(2, 10);
+            std::vector<char> data(4 + second.getDataSize());
+            data[3] = static_cast<char>(second.getDataSize());
+            std::memcpy(&data[4], second.getData(), second.getDataSize());
+
+            REQUIRE(client.send(first) == sf::Socket::Done);
+            REQUIRE(client.send(&data[0], 2) == sf::Socket::Done);
+
+            // Let both sends arrive, so that they are received and buffered together
+            sf::sleep(sf::milliseconds(50));
+
+            sf::SocketSelector selector;
+            selector.add(server);
+
+            sf::Packet received;
+            REQUIRE(selector.wait(sf::seconds(5)));
+            REQUIRE(server.receive(received) == sf::Socket::Done);
+            checkPacket(received, 1, 10);
+
+            // The incomplete packet must not make the selector return before the timeout
+            sf::Clock clock;
+            CHECK(!selector.wait(sf::milliseconds(100)));
+            CHECK(clock.getElapsedTime() >= sf::milliseconds(50));
+            CHECK(server.receive(received) == sf::Socket::NotReady);
+
+            REQUIRE(client.send(&data[2], data.size() - 2) == sf::Socket::Done);
+            REQUIRE(selector.wait(sf::seconds(5)));
+            REQUIRE(selector.isReady(server));
+            REQUIRE(server.receive(received) == sf::Socket::Done);
+            checkPacket(received, 2, 10);
+        }
+
+        SECTION("Bogus packet size")
+        {
+            server.setBlocking(false);
+
+            // The memory of a packet is allocated as its data arrives, not from the size announced by the peer
+            const char data[] = "\xFF\xFF\xFF\xFF" "data";
+            REQUIRE(client.send(data, sizeof(data) - 1) == sf::Socket::Done);
+            sf::sleep(sf::milliseconds(50));
+
+            sf::Packet received;
+            CHECK(server.receive(received) == sf::Socket::NotReady);
+            CHECK(server.receive(received) == sf::Socket::NotReady);
+        }
+
+        SECTION("Packets followed by raw data")
+        {
+            sf::Packet first = makePacket(1, 10);
+            sf::Packet second = makePacket(2, 70000);
+            REQUIRE(client.send(first) == sf::Socket::Done);
+            REQUIRE(client.send(second) == sf::Socket::Done);
+
+            const char raw[] = "raw";
+            REQUIRE(client.send(raw, sizeof(raw)) == sf::Socket::Done);
+
+            sf::Packet received;
+            REQUIRE(server.receive(received) == sf::Socket::Done);
+            checkPacket(received, 1, 10);
+            REQUIRE(server.receive(received) == sf::Socket::Done);
+            checkPacket(received, 2, 70000);
+
+            char buffer[sizeof(raw)] = {0};
+            std::size_t size = 0;
+            while (size < sizeof(raw))
+            {
+                std::size_t count = 0;
+                REQUIRE(server.receive(buffer + size, sizeof(raw) - size, count) == sf::Socket::Done);
+                size += count;
+            }
+            CHECK(std::string(buffer) == raw);
+        }
+    }
+}
@@ -0,0 +1,114 @@
+#include <SFML/Network.hpp>
+
+#include <catch.hpp>
+#include <vector>
+
+TEST_CASE("sf::UdpSocket class", "[network]")
+{
+    sf::UdpSocket receiver;
+    REQUIRE(receiver.bind(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Done);
+
+    sf::UdpSocket sender;
+    REQUIRE(sender.bind(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Done);
+
+    // Datagrams of various sizes, each filled with its index
+    const std::size_t count = 100;
+    std::vector<std::vector<char> > payloads(count);
+    std::vector<sf::UdpSocket::Datagram> outgoing(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        payloads[i].assign(1 + i * 7, static_cast<char>(i));
+        outgoing[i].data          = &payloads[i][0];
+        outgoing[i].size          = payloads[i].size();
+        outgoing[i].remoteAddress = sf::IpAddress::LocalHost;
+        outgoing[i].remotePort    = receiver.getLocalPort();
+    }
+
+    std::vector<std::vector<char> > buffers(count + 10, std::vector<char>(1024));
+    std::vector<sf::UdpSocket::Datagram> incoming(buffers.size());
+    for (std::size_t i = 0; i < incoming.size(); ++i)
+    {
+        incoming[i].data = &buffers[i][0];
+        incoming[i].size = buffers[i].size();
+    }
+
+    SECTION("Batches")
+    {
+        std::size_t sent = 0;
+        REQUIRE(sender.send(&outgoing[0], count, sent) == sf::Socket::Done);
+        CHECK(sent == count);
+
+        // Datagrams are not lost over the loopback interface, but may be delivered in several batches
+        std::size_t received = 0;
+        while (received < count)
+        {
+            std::size_t batch = 0;
+            REQUIRE(receiver.receive(&incoming[received], incoming.size() - received, batch) == sf::Socket::Done);
+            REQUIRE(batch > 0);
+            received += batch;
+        }
+        CHECK(received == count);
+
+        bool same = true;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            same = same && (incoming[i].received == payloads[i].size());
+            same = same && (buffers[i][0] == static_cast<char>(i)) && (buffers[i][incoming[i].received - 1] == static_cast<char>(i));
+            same = same && (incoming[i].remoteAddress == sf::IpAddress::LocalHost);
+            same = same && (incoming[i].remotePort == sender.getLocalPort());
+        }
+        CHECK(same);
+    }
+
+    SECTION("Mixed with single datagrams")
+    {
+        char single = 'x';
+        REQUIRE(sender.send(&single, 1, sf::IpAddress::LocalHost, receiver.getLocalPort()) == sf::Socket::Done);
+
+        std::size_t sent = 0;
+        REQUIRE(sender.send(&outgoing[0], 2, sent) == sf::Socket::Done);
+
+        char buffer[16];
+        std::size_t size = 0;
+        sf::IpAddress address;
+        unsigned short port = 0;
+        REQUIRE(receiver.receive(buffer, sizeof(buffer), size, address, port) == sf::Socket::Done);
+        CHECK(size == 1);
+        CHECK(buffer[0] == 'x');
+
+        receiver.setBlocking(false);
+        std::size_t received = 0;
+        for (int attempt = 0; (attempt < 100) && (received < 2); ++attempt)
+        {
+            std::size_t batch = 0;
+            if (receiver.receive(&incoming[received], 2 - received, batch) == sf::Socket::NotReady)
+                sf::sleep(sf::milliseconds(10));
+            received += batch;
+        }
+        CHECK(received == 2);
+        CHECK(incoming[0].received == 1);
+        CHECK(incoming[1].received == 8);
+
+        // Nothing left to receive
+        std::size_t batch = 1;
+        CHECK(receiver.receive(&incoming[0], incoming.size(), batch) == sf::Socket::NotReady);
+        CHECK(batch == 0);
+    }
+
+    SECTION("Oversized datagram")
+    {
+        std::vector<char> big(sf::UdpSocket::MaxDatagramSize + 1);
+        outgoing[1].data = &big[0];
+        outgoing[1].size = big.size();
+
+        std::size_t sent = 1;
+        CHECK(sender.send(&outgoing[0], 2, sent) == sf::Socket::Error);
+        CHECK(sent == 0);
+
+        // Nothing was sent
+        receiver.setBlocking(false);
+        std::size_t received = 1;
+        CHECK(receiver.receive(&incoming[0], incoming.size(), received) == sf::Socket::NotReady);
+        CHECK(received == 0);
+    }
+}